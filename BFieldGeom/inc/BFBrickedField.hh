@@ -0,0 +1,73 @@
+#ifndef BFieldGeom_BFBrickedField_hh
+#define BFieldGeom_BFBrickedField_hh
+//
+// Single precision, cache-blocked copy of the field values of a BFGridMap.
+//
+// The grid is tiled in bricks of kCells x kCells x kCells cells.  Each brick
+// stores all of the nodes that bound its cells, so the 8 corners of any cell
+// are found in one brick; nodes on the faces of a brick are duplicated in its
+// neighbours.  Within a brick Bx, By and Bz are stored as separate float arrays
+// and the 8 corners of a cell span at most two cache lines per component.
+//
+// The interpolation kernel uses AVX2 gathers when the compiler targets AVX2
+// and falls back to an equivalent scalar kernel otherwise.
+//
+
+#include <cstddef>
+#include <vector>
+
+#include "CLHEP/Vector/ThreeVector.h"
+
+namespace mu2e {
+
+  class BFBrickedField {
+  public:
+
+    // Cells and nodes along one edge of a brick.
+    static constexpr unsigned kCells = 4;
+    static constexpr unsigned kNodes = kCells + 1;
+
+    // Nodes per brick, and the same rounded up to a multiple of 16 floats (one cache line).
+    static constexpr unsigned kBrickNodes = kNodes * kNodes * kNodes;
+    static constexpr unsigned kPaddedNodes = (kBrickNodes + 15) / 16 * 16;
+
+    BFBrickedField() = default;
+
+    // Copy the field values out of the double precision grid, which is laid out
+    // as in Container3D.
+    BFBrickedField(CLHEP::Hep3Vector const* field, unsigned nx, unsigned ny, unsigned nz);
+
+    bool empty() const { return _bricks.empty(); }
+
+    // Trilinear interpolation inside the cell whose lowest corner is node (i,j,k);
+    // tx, ty, tz are the fractional distances from that node, in [0,1].
+    // The caller must ensure that i<nx-1, j<ny-1 and k<nz-1.
+    void interpolate(unsigned i, unsigned j, unsigned k,
+                     double tx, double ty, double tz, double b[3]) const;
+
+    // Size of the stored field, in bytes.
+    std::size_t memoryUsed() const { return _bricks.size() * sizeof(Brick); }
+
+  private:
+
+    struct alignas(64) Brick {
+      float bx[kPaddedNodes];
+      float by[kPaddedNodes];
+      float bz[kPaddedNodes];
+    };
+
+    // Number of bricks along each axis.
+    unsigned _nbx = 0, _nby = 0, _nbz = 0;
+
+    std::vector<Brick> _bricks;
+
+    // Index of a node within a brick, given its local coordinates.
+    static unsigned nodeIndex(unsigned li, unsigned lj, unsigned lk) {
+      return (li * kNodes + lj) * kNodes + lk;
+    }
+
+  };
+
+} // end namespace mu2e
+
+#endif /* BFieldGeom_BFBrickedField_hh */
@@ -3,13 +3,19 @@
 // Andrei Gaponenko, 2012
 //
 // Modifed by Brian Pollack to use shared_ptrs to BFMaps for consistent use across classes.
+//
+// The lookup structures are immutable once setMaps has been called and are shared
+// by all copies of a BFCacheManager.  The memory of the last map used is kept in a
+// separate BFCacheManager::Cache object that belongs to the caller; callers that do
+// not supply one get a cache that is private to their thread.  So one BFCacheManager
+// can be used concurrently from many threads, for example by the Geant4 workers.
 
 #ifndef BFCacheManager_hh
 #define BFCacheManager_hh
 
-#include <cassert>
-#include <map>
+#include <array>
 #include <memory>
+#include <ostream>
 #include <vector>
 
 #include "CLHEP/Vector/ThreeVector.h"
@@ -31,93 +37,122 @@ namespace mu2e {
 
         typedef std::vector<std::shared_ptr<const BFMap>> MapContainerType;
 
-        struct MapList : public MapContainerType {
-            // return the first matching map or 0
-            std::shared_ptr<const BFMap> findMap(const CLHEP::Hep3Vector& x) const {
-                for (MapContainerType::const_iterator i = begin(); i != end(); ++i) {
-                    if ((*i)->isValid(x)) {
-                        return *i;
-                    }
-                }
-                return 0;
-            }
+        struct CacheElement;
+
+        struct MapList : public std::vector<const CacheElement*> {
+            // return the first element whose map contains the point, or 0
+            const CacheElement* findMap(const CLHEP::Hep3Vector& x) const;
         };
 
         // An instance per (any) map, allows to optimize the lookup order of "inner" maps
         struct CacheElement {
-            std::shared_ptr<const BFMap> myMap;  // the map this instance is attached to
+            const BFMap* myMap = nullptr;  // the map this instance is attached to
             // A list of "inner" maps optimized for the "my" map
             // If "my" map is an inner map, it is not in the list.
             MapList inner;
-
-            CacheElement(std::shared_ptr<const BFMap> const&  my, const MapList& in)
-                : myMap(my), inner(in) {}
         };
 
-        // Inner map lists optimized for the last used map
-        mutable const CacheElement* innerForLastInner;
-        mutable const CacheElement* innerForLastOuter;  // never null
+        // Optional uniform grid over the bounding box of all maps.  Each cell lists, in
+        // lookup order, the inner and then the outer maps whose bounding box touches it.
+        struct SpatialIndex {
+            struct Cell {
+                unsigned begin = 0;   // first candidate in the candidates vector
+                unsigned nInner = 0;  // number of inner map candidates
+                unsigned nOuter = 0;  // number of outer map candidates that follow them
+            };
+            std::array<double, 3> lo{}, hi{}, invWidth{};
+            std::array<unsigned, 3> n{};
+            std::vector<Cell> cells;
+            std::vector<const CacheElement*> candidates;
+
+            bool empty() const { return cells.empty(); }
+            // The cell that contains the point, or 0 if it is outside of all maps.
+            const Cell* cell(const CLHEP::Hep3Vector& x) const;
+        };
 
-        // Outer maps in the user-specified order
-        MapList outer;
+        // Everything that is fixed by setMaps.
+        struct Lookup {
+            unsigned long serial = 0;   // unique to this instance, used to validate caches
+            MapContainerType maps;      // keeps the maps alive
+            std::vector<CacheElement> innerElements;
+            std::vector<CacheElement> outerElements;  // outerElements[0] is for "no outer map"
+            MapList outer;              // outer maps in the user-specified order
+            SpatialIndex index;
+        };
 
-        typedef std::map<std::shared_ptr<const BFMap>, CacheElement> CacheType;
-        CacheType innerCache;  // keys are all inner maps
-        CacheType outerCache;  // keys are outer maps and 0
-        int counter;
+        std::shared_ptr<const Lookup> lookup_;
 
        public:
-        BFCacheManager();
-
-        void setMaps(const MapContainerType& innerMaps, const MapContainerType& outerMaps);
-
-        // Returns pointers to an appropriate field map, or 0.
-        std::shared_ptr<const BFMap> findMap(const CLHEP::Hep3Vector& x) const {
-            // First try to find if the point belong to any of the inner maps
-
-            if (innerForLastInner) {  // we were in an inner map last time
-
-                if (innerForLastInner->myMap->isValid(x)) {
-                    // Cache update not needed, we are still in the same inner map
-                    return innerForLastInner->myMap;
-                }
-
-                // The lookup order here is optimized
-                std::shared_ptr<const BFMap> newinner = innerForLastInner->inner.findMap(x);
-                if (newinner) {  // Update cache
-                    CacheType::const_iterator p = innerCache.find(newinner);
-                    assert(p != innerCache.end());
-                    innerForLastInner = &p->second;
-                    return newinner;
-                }
-            } else {  // We were not in an inner map last time
-
-                // innerForLastOuter is never null
-                std::shared_ptr<const BFMap> newinner = innerForLastOuter->inner.findMap(x);
-                if (newinner) {  // Update cache
-                    CacheType::const_iterator p = innerCache.find(newinner);
-                    assert(p != innerCache.end());
-                    innerForLastInner = &p->second;
-                    return newinner;
-                }
-            }
+        // Counters of the lookups done with one Cache.
+        struct Stats {
+            unsigned long hits = 0;              // point is in the same inner map as the previous one
+            unsigned long misses = 0;            // the map had to be searched for
+            unsigned long outerFallthrough = 0;  // misses that were not in any inner map
+            unsigned long notFound = 0;          // points that are not in any map
+
+            unsigned long lookups() const { return hits + misses; }
+            Stats& operator+=(const Stats& rhs);
+            void print(std::ostream& os) const;
+        };
 
-            // The current point is not in any of the inner maps
-            innerForLastInner = 0;
+        // Memory of the map used for the last lookup, to be owned by the caller.
+        // A Cache must not be shared between threads.
+        class Cache {
+           public:
+            const Stats& stats() const { return stats_; }
+            void resetStats() { stats_ = Stats(); }
+
+           private:
+            friend class BFCacheManager;
+            unsigned long serial_ = 0;  // serial of the Lookup the pointers below refer to
+            const CacheElement* innerForLastInner_ = nullptr;
+            const CacheElement* innerForLastOuter_ = nullptr;
+            Stats stats_;
+        };
 
-            // The lookup order of the outer maps is always the same
-            std::shared_ptr<const BFMap> newouter = outer.findMap(x);
+        BFCacheManager();
 
-            // Keep the inner map lookup optimized
-            if (innerForLastOuter->myMap != newouter) {
-                CacheType::const_iterator p = outerCache.find(newouter);
-                assert(p != outerCache.end());
-                innerForLastOuter = &p->second;
+        // If useIndex is true, misses are resolved with a spatial index instead of
+        // a linear scan of the map lists.
+        void setMaps(const MapContainerType& innerMaps, const MapContainerType& outerMaps,
+                     bool useIndex = false);
+
+        bool hasSpatialIndex() const { return !lookup_->index.empty(); }
+
+        // Returns a non-owning pointer to an appropriate field map, or 0.
+        // The first form uses a cache that is private to the calling thread.
+        const BFMap* findMap(const CLHEP::Hep3Vector& x) const;
+        const BFMap* findMap(const CLHEP::Hep3Vector& x, Cache& cache) const {
+            const Lookup& lk = *lookup_;
+            if (cache.serial_ != lk.serial) {
+                cache.serial_ = lk.serial;
+                cache.innerForLastInner_ = nullptr;
+                cache.innerForLastOuter_ = &lk.outerElements.front();
             }
 
-            return newouter;
+            // We were in an inner map last time, and cache update not needed
+            if (cache.innerForLastInner_ && cache.innerForLastInner_->myMap->isValid(x)) {
+                ++cache.stats_.hits;
+                return cache.innerForLastInner_->myMap;
+            }
+            ++cache.stats_.misses;
+            return lk.index.empty() ? findMapScan(x, cache, lk) : findMapIndexed(x, cache, lk);
         }
+
+        // Counters of the cache used by findMap(x) on the calling thread.
+        static const Stats& threadStats();
+
+       private:
+        const BFMap* findMapScan(const CLHEP::Hep3Vector& x, Cache& cache, const Lookup& lk) const;
+        const BFMap* findMapIndexed(const CLHEP::Hep3Vector& x, Cache& cache, const Lookup& lk) const;
+        static Cache& threadCache();
     };
+
+    inline std::ostream& operator<<(std::ostream& os, const BFCacheManager::Stats& stats) {
+        stats.print(os);
+        return os;
+    }
+
 }  // namespace mu2e
 
 #endif /*BFCacheManager_hh*/
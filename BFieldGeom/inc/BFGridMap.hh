@@ -12,11 +12,14 @@
 //
 
 //#include <iosfwd>
+#include <memory>
 #include <ostream>
 #include <string>
+#include "Offline/BFieldGeom/inc/BFBrickedField.hh"
 #include "Offline/BFieldGeom/inc/BFInterpolationStyle.hh"
 #include "Offline/BFieldGeom/inc/BFMap.hh"
 #include "Offline/BFieldGeom/inc/BFMapType.hh"
+#include "Offline/BFieldGeom/inc/BFMappedFile.hh"
 #include "Offline/BFieldGeom/inc/Container3D.hh"
 #include "CLHEP/Vector/ThreeVector.h"
 
@@ -67,12 +70,37 @@ namespace mu2e {
               _allDefined(false),
               _interpStyle(style){};
 
+        // A map whose grid and field values are taken, in place, from a mapped file.
+        BFGridMap(std::string const& key,
+                  std::shared_ptr<const BFMappedFile> const& file,
+                  BFMapType::enum_type atype,
+                  double scale,
+                  BFInterpolationStyle style,
+                  bool warnIfOutside = false);
+
         bool getBFieldWithStatus(const CLHEP::Hep3Vector&, CLHEP::Hep3Vector&) const override;
 
+        std::size_t getBField(std::span<const CLHEP::Hep3Vector> points,
+                              std::span<CLHEP::Hep3Vector> fields) const override;
+
+        // Each interpolation method, independent of the configured style and storage.
+        // Used to validate and benchmark the methods against each other.
+        bool getBFieldTriLinear(const CLHEP::Hep3Vector&, CLHEP::Hep3Vector&) const;
+        bool getBFieldBricked(const CLHEP::Hep3Vector&, CLHEP::Hep3Vector&) const;
+        bool getBFieldQuadratic(const CLHEP::Hep3Vector&, CLHEP::Hep3Vector&) const;
+
+        // True if the single precision, cache-blocked copy of the field has been made;
+        // if so, trilinear interpolation uses it.
+        bool hasBrickedField() const { return !_bricks.empty(); }
+        const BFBrickedField& brickedField() const { return _bricks; }
+
+        // True if the field values are used in place from a mapped file.
+        bool isMapped() const { return _mappedFile != nullptr; }
+
         // Validity checker
         bool isValid(const CLHEP::Hep3Vector& point) const override;
         bool isValid(const GridPoint& ipoint) const {
-            return _field.isValid(ipoint.ix, ipoint.iy, ipoint.iz);
+            return ipoint.ix < _nx && ipoint.iy < _ny && ipoint.iz < _nz;
         }
 
         unsigned int nx() const { return _nx; }
@@ -110,6 +138,9 @@ namespace mu2e {
         mu2e::Container3D<CLHEP::Hep3Vector> _field;
         mu2e::Container3D<bool> _isDefined;
 
+        // If present, the field values are taken from this file and _field is empty.
+        std::shared_ptr<const BFMappedFile> _mappedFile;
+
         // If all grid points are valid then _isDefined is not needed.
         bool _allDefined;
 
@@ -119,8 +150,22 @@ namespace mu2e {
         // method for interpolation between field grid points
         BFInterpolationStyle _interpStyle;
 
+        // Optional single precision, cache-blocked copy of _field.
+        BFBrickedField _bricks;
+
         // Functions used internally and by the code that populates the maps.
 
+        // Field values, from either the mapped file or _field.
+        CLHEP::Hep3Vector const* fieldData() const {
+            return _mappedFile ? _mappedFile->field() : &_field.get(0, 0, 0);
+        }
+        CLHEP::Hep3Vector const& field(unsigned ix, unsigned iy, unsigned iz) const {
+            return fieldData()[(std::size_t(ix) * _ny + iy) * _nz + iz];
+        }
+        bool isDefined(unsigned ix, unsigned iy, unsigned iz) const {
+            return _allDefined || _isDefined(ix, iy, iz);
+        }
+
         // method to store the neighbors
         bool getNeighbors(int ix, int iy, int iz, CLHEP::Hep3Vector neighborsBF[3][3][3]) const;
 
@@ -140,6 +185,12 @@ namespace mu2e {
 
         bool interpolateTriLinear(const CLHEP::Hep3Vector&, CLHEP::Hep3Vector&) const;
 
+        // Trilinear interpolation using _bricks.
+        bool interpolateBricked(const CLHEP::Hep3Vector&, CLHEP::Hep3Vector&) const;
+
+        // Make _bricks from _field; call after the map has been filled (and flipped).
+        void buildBrickedField();
+
     };
 
     inline BFGridMap::GridPoint BFGridMap::point2grid(const CLHEP::Hep3Vector& pos) const {
@@ -11,7 +11,9 @@
 // Rewritten again by Brian Pollack to become pure-virtual base class for all types of BFMaps
 //
 
+#include <cstddef>
 #include <ostream>
+#include <span>
 #include <string>
 #include "Offline/BFieldGeom/inc/BFInterpolationStyle.hh"
 #include "Offline/BFieldGeom/inc/BFMapType.hh"
@@ -53,6 +55,20 @@ namespace mu2e {
         // Accessors
         virtual bool getBFieldWithStatus(const CLHEP::Hep3Vector&, CLHEP::Hep3Vector&) const = 0;
 
+        // Batched accessor: fields[i] is set to the field at points[i], or to zero if that
+        // point is outside of the map.  fields must be at least as long as points.
+        // Returns the number of points that are inside the map.
+        virtual std::size_t getBField(std::span<const CLHEP::Hep3Vector> points,
+                                      std::span<CLHEP::Hep3Vector> fields) const {
+            std::size_t nInside(0);
+            for (std::size_t i = 0; i != points.size(); ++i) {
+                if (getBFieldWithStatus(points[i], fields[i])) {
+                    ++nInside;
+                }
+            }
+            return nInside;
+        }
+
         // Validity checker
         virtual bool isValid(const CLHEP::Hep3Vector& point) const = 0;
 
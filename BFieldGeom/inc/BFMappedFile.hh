@@ -0,0 +1,90 @@
+#ifndef BFieldGeom_BFMappedFile_hh
+#define BFieldGeom_BFMappedFile_hh
+//
+// A grid field map stored in a file that is used in place through mmap.
+// All processes on a node that use the same file share one copy of it in
+// the page cache.
+//
+// File layout:
+//   bytes [0, sizeof(Header))         : Header, see below
+//   bytes [sizeof(Header), dataOffset) : zero padding
+//   bytes [dataOffset, end)           : nx*ny*nz field values, laid out as in
+//                                       Container3D<CLHEP::Hep3Vector>; units are tesla.
+// dataOffset is a multiple of the page size.
+//
+// The header carries an endian marker, a format version and a checksum of
+// itself, so that a file from another platform, an older version of this code
+// or a truncated copy is rejected when it is opened.  The field values have
+// their own checksum, which is only checked on request since doing so reads
+// the whole file.
+//
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#include "CLHEP/Vector/ThreeVector.h"
+
+namespace mu2e {
+
+  class BFMappedFile {
+  public:
+
+    static constexpr std::uint32_t kEndianMarker = 0xDEADBEEF;
+    static constexpr std::uint32_t kVersion = 1;
+    static constexpr std::uint64_t kDataOffset = 4096;
+
+    struct Header {
+      char          magic[8];      // "Mu2eBFld"
+      std::uint32_t endianMarker;  // kEndianMarker, as written by the producer
+      std::uint32_t version;       // kVersion at the time the file was written
+      std::uint64_t dataOffset;    // offset of the field values from the start of the file
+      std::uint64_t dataSize;      // size of the field values, in bytes
+      std::uint32_t nx, ny, nz;    // grid dimensions
+      std::uint32_t flipy;         // non-zero if only y>=0 is stored; see BFGridMap
+      double        xmin, ymin, zmin;  // lower corner of the grid, Mu2e coordinates, mm
+      double        dx, dy, dz;        // grid spacing, mm
+      std::uint64_t dataChecksum;      // checksum of the field values
+      std::uint64_t headerChecksum;    // checksum of all of the above
+    };
+
+    // Map the file and validate its header; throws if the file is not usable.
+    // If verifyData is true, also check the checksum of the field values.
+    explicit BFMappedFile(std::string const& filename, bool verifyData = false);
+    ~BFMappedFile();
+
+    BFMappedFile(BFMappedFile const&) = delete;
+    BFMappedFile& operator=(BFMappedFile const&) = delete;
+
+    Header const& header() const { return _header; }
+    std::string const& filename() const { return _filename; }
+
+    // The field values.
+    CLHEP::Hep3Vector const* field() const { return _field; }
+
+    // Write a map in this format; an existing file is not overwritten.
+    static void write(std::string const& filename,
+                      unsigned nx, unsigned ny, unsigned nz,
+                      double xmin, double ymin, double zmin,
+                      double dx, double dy, double dz,
+                      bool flipy,
+                      CLHEP::Hep3Vector const* field);
+
+    // 64 bit FNV-1a hash; used for both checksums.
+    static std::uint64_t checksum(void const* data, std::size_t nbytes);
+
+  private:
+    std::string _filename;
+    Header _header;
+
+    // The mapping of the whole file.
+    void* _base = nullptr;
+    std::size_t _size = 0;
+
+    CLHEP::Hep3Vector const* _field = nullptr;
+
+  };
+
+} // end namespace mu2e
+
+#endif /* BFieldGeom_BFMappedFile_hh */
@@ -60,13 +60,34 @@ namespace mu2e {
         // to trigger the map-writing hack inside the BFieldManagerMaker code.
         bool writeBinaries() const { return writeBinaries_; }
 
+        // Same for the mapped (.bfmap) format; see BFMappedFile.
+        bool writeMappedMaps() const { return writeMappedMaps_; }
+
+        // Check the checksum of the field values when opening a .bfmap file.
+        bool verifyMappedMaps() const { return verifyMappedMaps_; }
+
         int verbosityLevel() const { return verbosityLevel_; }
 
         bool flipBFieldMaps() const { return flipBFieldMaps_; }
 
+        // Keep a single precision, cache-blocked copy of each grid map and use it
+        // for trilinear interpolation.
+        bool brickedStorage() const { return brickedStorage_; }
+
+        // Find the map that contains a point with a spatial index over the map
+        // bounding boxes, instead of a linear scan of the map lists.
+        bool spatialIndex() const { return spatialIndex_; }
+
        private:
         BFieldConfig()
-            : scaleFactor_(1.), writeBinaries_(false), verbosityLevel_(1), flipBFieldMaps_(false) {}
+            : scaleFactor_(1.),
+              writeBinaries_(false),
+              writeMappedMaps_(false),
+              verifyMappedMaps_(false),
+              verbosityLevel_(1),
+              flipBFieldMaps_(false),
+              brickedStorage_(false),
+              spatialIndex_(false) {}
 
         // G4BL, PARAM or possible future types.
         BFMapType mapType_;
@@ -89,8 +110,12 @@ namespace mu2e {
         CLHEP::Hep3Vector dsGradientValue_;
 
         bool writeBinaries_;
+        bool writeMappedMaps_;
+        bool verifyMappedMaps_;
         int verbosityLevel_;
         bool flipBFieldMaps_;
+        bool brickedStorage_;
+        bool spatialIndex_;
     };
 
 }  // namespace mu2e
@@ -14,6 +14,7 @@
 
 // C++ includes
 #include <set>
+#include <span>
 #include <string>
 
 // Includes from Mu2e
@@ -43,6 +44,10 @@ namespace mu2e {
         bool getBFieldWithStatus(const CLHEP::Hep3Vector&,
                                  BFCacheManager const&,
                                  CLHEP::Hep3Vector&) const;
+        // As above, remembering the last map used in a cache owned by the caller.
+        bool getBFieldWithStatus(const CLHEP::Hep3Vector&,
+                                 BFCacheManager::Cache&,
+                                 CLHEP::Hep3Vector&) const;
 
         // Just return zero for out of range.
         CLHEP::Hep3Vector getBField(const CLHEP::Hep3Vector& pos) const {
@@ -60,6 +65,25 @@ namespace mu2e {
             return result;
         }
 
+        CLHEP::Hep3Vector getBField(const CLHEP::Hep3Vector& pos,
+                                    BFCacheManager::Cache& cache) const {
+            CLHEP::Hep3Vector result;
+            getBFieldWithStatus(pos, cache, result);
+            return result;
+        }
+
+        // Batched lookup: fields[i] is set to the field at points[i], zero for out of range.
+        // Runs of consecutive points that fall in the same map are passed to that map
+        // in one call.  Returns the number of points that are inside some map.
+        std::size_t getBField(std::span<const CLHEP::Hep3Vector> points,
+                              std::span<CLHEP::Hep3Vector> fields) const;
+        std::size_t getBField(std::span<const CLHEP::Hep3Vector> points,
+                              BFCacheManager const& cmgr,
+                              std::span<CLHEP::Hep3Vector> fields) const;
+        std::size_t getBField(std::span<const CLHEP::Hep3Vector> points,
+                              BFCacheManager::Cache& cache,
+                              std::span<CLHEP::Hep3Vector> fields) const;
+
         XYZVectorF getBField(const XYZVectorF& pos) const {
           // Default c'tor sets all components to zero - which is what we need here.
           CLHEP::Hep3Vector b;
@@ -85,12 +109,14 @@ namespace mu2e {
         // Private ctr.  An instance of BFieldManager should be obtained
         // via the BFieldManagerMaker class.
         BFieldManager(MapContainerType const& innerMaps,
-                      MapContainerType const& outerMaps);
+                      MapContainerType const& outerMaps,
+                      bool spatialIndex = false);
 
         MapContainerType innerMaps_;
         MapContainerType outerMaps_;
 
-        // Handles caching and overlap resolution logic
+        // Handles caching and overlap resolution logic.  The calls that do not take a
+        // cache use one that is private to the calling thread.
         BFCacheManager cm_;
 
     };  // end class BFieldManager
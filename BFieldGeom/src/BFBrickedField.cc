@@ -0,0 +1,104 @@
+//
+// Single precision, cache-blocked copy of the field values of a BFGridMap.
+//
+
+#include <algorithm>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+#include "Offline/BFieldGeom/inc/BFBrickedField.hh"
+
+namespace mu2e {
+
+  namespace {
+
+    // Offsets of the 8 corners of a cell, relative to its lowest corner.
+    // Corner n is displaced by one node in x if (n&4), in y if (n&2) and in z if (n&1);
+    // this is the same ordering that is used for the weights below.
+    constexpr unsigned kN  = BFBrickedField::kNodes;
+    constexpr unsigned kCorner[8] = { 0,          1,          kN,          kN + 1,
+                                      kN*kN,      kN*kN + 1,  kN*kN + kN,  kN*kN + kN + 1 };
+
+#if defined(__AVX2__)
+    inline float hsum(__m256 v) {
+      __m128 s = _mm_add_ps(_mm256_castps256_ps128(v), _mm256_extractf128_ps(v, 1));
+      __m128 h = _mm_movehdup_ps(s);
+      s = _mm_add_ps(s, h);
+      h = _mm_movehl_ps(h, s);
+      return _mm_cvtss_f32(_mm_add_ss(s, h));
+    }
+#endif
+
+  } // end anonymous namespace
+
+  BFBrickedField::BFBrickedField(CLHEP::Hep3Vector const* field,
+                                 unsigned nx, unsigned ny, unsigned nz)
+    : _nbx((std::max(nx, 2u) - 2) / kCells + 1),
+      _nby((std::max(ny, 2u) - 2) / kCells + 1),
+      _nbz((std::max(nz, 2u) - 2) / kCells + 1),
+      _bricks(std::size_t(_nbx) * _nby * _nbz) {
+
+    // Nodes beyond the end of the grid, in the last brick along each axis,
+    // are filled with the value at the edge; they are never used with a non-zero weight.
+    for (unsigned bi = 0; bi < _nbx; ++bi) {
+      for (unsigned bj = 0; bj < _nby; ++bj) {
+        for (unsigned bk = 0; bk < _nbz; ++bk) {
+          Brick& brick = _bricks[(std::size_t(bi) * _nby + bj) * _nbz + bk];
+          std::fill(std::begin(brick.bx), std::end(brick.bx), 0.f);
+          std::fill(std::begin(brick.by), std::end(brick.by), 0.f);
+          std::fill(std::begin(brick.bz), std::end(brick.bz), 0.f);
+          for (unsigned li = 0; li < kNodes; ++li) {
+            unsigned ix = std::min(bi * kCells + li, nx - 1);
+            for (unsigned lj = 0; lj < kNodes; ++lj) {
+              unsigned iy = std::min(bj * kCells + lj, ny - 1);
+              for (unsigned lk = 0; lk < kNodes; ++lk) {
+                unsigned iz = std::min(bk * kCells + lk, nz - 1);
+                CLHEP::Hep3Vector const& b = field[(std::size_t(ix) * ny + iy) * nz + iz];
+                unsigned n = nodeIndex(li, lj, lk);
+                brick.bx[n] = b.x();
+                brick.by[n] = b.y();
+                brick.bz[n] = b.z();
+              }
+            }
+          }
+        }
+      }
+    }
+  }
+
+  void BFBrickedField::interpolate(unsigned i, unsigned j, unsigned k,
+                                   double tx, double ty, double tz, double b[3]) const {
+    Brick const& brick =
+      _bricks[(std::size_t(i / kCells) * _nby + j / kCells) * _nbz + k / kCells];
+    unsigned const o = nodeIndex(i % kCells, j % kCells, k % kCells);
+
+    float const fx = tx, fy = ty, fz = tz;
+    float const gx = 1.f - fx, gy = 1.f - fy, gz = 1.f - fz;
+
+#if defined(__AVX2__)
+    __m256i const idx = _mm256_setr_epi32(kCorner[0], kCorner[1], kCorner[2], kCorner[3],
+                                          kCorner[4], kCorner[5], kCorner[6], kCorner[7]);
+    __m256 const w = _mm256_mul_ps(_mm256_setr_ps(gx, gx, gx, gx, fx, fx, fx, fx),
+                     _mm256_mul_ps(_mm256_setr_ps(gy, gy, fy, fy, gy, gy, fy, fy),
+                                   _mm256_setr_ps(gz, fz, gz, fz, gz, fz, gz, fz)));
+    b[0] = hsum(_mm256_mul_ps(w, _mm256_i32gather_ps(brick.bx + o, idx, 4)));
+    b[1] = hsum(_mm256_mul_ps(w, _mm256_i32gather_ps(brick.by + o, idx, 4)));
+    b[2] = hsum(_mm256_mul_ps(w, _mm256_i32gather_ps(brick.bz + o, idx, 4)));
+#else
+    float const w[8] = { gx*gy*gz, gx*gy*fz, gx*fy*gz, gx*fy*fz,
+                         fx*gy*gz, fx*gy*fz, fx*fy*gz, fx*fy*fz };
+    float sx(0.f), sy(0.f), sz(0.f);
+    for (unsigned n = 0; n < 8; ++n) {
+      sx += w[n] * brick.bx[o + kCorner[n]];
+      sy += w[n] * brick.by[o + kCorner[n]];
+      sz += w[n] * brick.bz[o + kCorner[n]];
+    }
+    b[0] = sx;
+    b[1] = sy;
+    b[2] = sz;
+#endif
+  }
+
+} // end namespace mu2e
@@ -1,50 +1,242 @@
 // Andrei Gaponenko, 2012
 
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+
 #include "Offline/BFieldGeom/inc/BFCacheManager.hh"
 
 namespace mu2e {
 
-    BFCacheManager::BFCacheManager():
-    innerForLastInner(0),
-    innerForLastOuter(0),
-    counter(0)
-    {
-        outerCache.insert( std::make_pair<std::shared_ptr<const BFMap>>(0, CacheElement(0, MapList())) );
-        CacheType::const_iterator p = outerCache.find(0);
-        assert(p != outerCache.end());
-        innerForLastOuter = &p->second;
+    namespace {
+
+        // Serial numbers for the lookup structures; never reused, so that a Cache
+        // that refers to a Lookup that has been replaced is always detected.
+        std::atomic<unsigned long> nextSerial(1);
+
+        // Cells of the spatial index along each axis.
+        constexpr unsigned kIndexCells = 32;
+
+        // Bounding box of a map used to build the spatial index.  Maps may be defined
+        // for y>0 only and reflected (see BFGridMap), so the box is extended to -ymax.
+        // The candidates are always checked with isValid, so a box that is too large
+        // costs time but does not change the answer.
+        void boundingBox(const BFMap& map, std::array<double, 3>& lo, std::array<double, 3>& hi) {
+            lo = {map.xmin(), std::min(map.ymin(), -map.ymax()), map.zmin()};
+            hi = {map.xmax(), map.ymax(), map.zmax()};
+        }
+
+    }  // namespace
+
+    const BFCacheManager::CacheElement* BFCacheManager::MapList::findMap(
+        const CLHEP::Hep3Vector& x) const {
+        for (const CacheElement* e : *this) {
+            if (e->myMap->isValid(x)) {
+                return e;
+            }
+        }
+        return 0;
+    }
+
+    const BFCacheManager::SpatialIndex::Cell* BFCacheManager::SpatialIndex::cell(
+        const CLHEP::Hep3Vector& x) const {
+        const double p[3] = {x.x(), x.y(), x.z()};
+        unsigned ic[3];
+        for (unsigned i = 0; i < 3; ++i) {
+            if (!(p[i] >= lo[i] && p[i] <= hi[i])) {
+                return 0;
+            }
+            // points on the upper face belong to the last cell
+            ic[i] = std::min(static_cast<unsigned>((p[i] - lo[i]) * invWidth[i]), n[i] - 1);
+        }
+        return &cells[(ic[0] * n[1] + ic[1]) * n[2] + ic[2]];
+    }
+
+    BFCacheManager::Stats& BFCacheManager::Stats::operator+=(const Stats& rhs) {
+        hits += rhs.hits;
+        misses += rhs.misses;
+        outerFallthrough += rhs.outerFallthrough;
+        notFound += rhs.notFound;
+        return *this;
+    }
+
+    void BFCacheManager::Stats::print(std::ostream& os) const {
+        os << "BField map lookups: " << lookups() << " hits: " << hits << " misses: " << misses
+           << " fall through to outer maps: " << outerFallthrough << " outside all maps: " << notFound;
+    }
+
+    BFCacheManager::BFCacheManager() {
+        auto lk = std::make_shared<Lookup>();
+        lk->serial = nextSerial++;
+        lk->outerElements.resize(1);
+        lookup_ = lk;
     }
 
     void BFCacheManager::setMaps(const MapContainerType& innerMaps,
-                                 const MapContainerType& outerMaps) {
-        typedef MapContainerType::const_iterator Iter;
+                                 const MapContainerType& outerMaps,
+                                 bool useIndex) {
+        auto lk = std::make_shared<Lookup>();
+        lk->serial = nextSerial++;
+        lk->maps = innerMaps;
+        lk->maps.insert(lk->maps.end(), outerMaps.begin(), outerMaps.end());
 
-        // All inner maps in the input order
-        MapList defaultInnerList;
-        for (Iter i = innerMaps.begin(); i != innerMaps.end(); ++i) {
-            defaultInnerList.push_back(*i);
+        // Size the element vectors first; the lists below point into them.
+        lk->innerElements.resize(innerMaps.size());
+        lk->outerElements.resize(outerMaps.size() + 1);
+        for (std::size_t i = 0; i != innerMaps.size(); ++i) {
+            lk->innerElements[i].myMap = innerMaps[i].get();
+        }
+        for (std::size_t i = 0; i != outerMaps.size(); ++i) {
+            lk->outerElements[i + 1].myMap = outerMaps[i].get();
+            // The fixed-order outer map list
+            lk->outer.push_back(&lk->outerElements[i + 1]);
         }
 
-        // The fixed-order outer map list
-        for (Iter i = outerMaps.begin(); i != outerMaps.end(); ++i) {
-            this->outer.push_back(*i);
+        // Now populate the cache lookup structures.  All inner maps in the input order;
+        // or can assign a dedicated innerList for each map, e.g. using hints from FHICL
+        for (CacheElement& e : lk->innerElements) {
+            for (const CacheElement& other : lk->innerElements) {
+                if (&other != &e) {
+                    e.inner.push_back(&other);
+                }
+            }
         }
+        for (CacheElement& e : lk->outerElements) {
+            for (const CacheElement& other : lk->innerElements) {
+                e.inner.push_back(&other);
+            }
+        }
+
+        if (useIndex && !lk->maps.empty()) {
+            SpatialIndex& index = lk->index;
+            std::array<double, 3> lo, hi;
+            boundingBox(*lk->maps.front(), index.lo, index.hi);
+            for (const auto& map : lk->maps) {
+                boundingBox(*map, lo, hi);
+                for (unsigned i = 0; i < 3; ++i) {
+                    index.lo[i] = std::min(index.lo[i], lo[i]);
+                    index.hi[i] = std::max(index.hi[i], hi[i]);
+                }
+            }
+            std::array<double, 3> width;
+            for (unsigned i = 0; i < 3; ++i) {
+                index.n[i] = (index.hi[i] > index.lo[i]) ? kIndexCells : 1;
+                width[i] = (index.hi[i] - index.lo[i]) / index.n[i];
+                index.invWidth[i] = (width[i] > 0.) ? 1. / width[i] : 0.;
+            }
 
-        // Now populate the cache lookup structures
+            // Does the bounding box of a map touch cell (ix,iy,iz)?  Closed intervals,
+            // because isValid accepts points on the faces of a map.
+            auto touches = [&](const BFMap& map, unsigned ix, unsigned iy, unsigned iz) {
+                boundingBox(map, lo, hi);
+                const unsigned ic[3] = {ix, iy, iz};
+                for (unsigned i = 0; i < 3; ++i) {
+                    double clo = index.lo[i] + ic[i] * width[i];
+                    double chi = (ic[i] + 1 == index.n[i]) ? index.hi[i] : clo + width[i];
+                    if (hi[i] < clo || lo[i] > chi) {
+                        return false;
+                    }
+                }
+                return true;
+            };
 
-        for (Iter i = innerMaps.begin(); i != innerMaps.end(); ++i) {
-            // or can assign a dedicated innerList for this map, e.g. using hints from FHICL
-            innerCache.insert(std::make_pair(*i, CacheElement(*i, defaultInnerList)));
+            index.cells.resize(std::size_t(index.n[0]) * index.n[1] * index.n[2]);
+            for (unsigned ix = 0; ix < index.n[0]; ++ix) {
+                for (unsigned iy = 0; iy < index.n[1]; ++iy) {
+                    for (unsigned iz = 0; iz < index.n[2]; ++iz) {
+                        SpatialIndex::Cell& cell = index.cells[(ix * index.n[1] + iy) * index.n[2] + iz];
+                        cell.begin = index.candidates.size();
+                        for (const CacheElement& e : lk->innerElements) {
+                            if (touches(*e.myMap, ix, iy, iz)) {
+                                index.candidates.push_back(&e);
+                                ++cell.nInner;
+                            }
+                        }
+                        for (const CacheElement* e : lk->outer) {
+                            if (touches(*e->myMap, ix, iy, iz)) {
+                                index.candidates.push_back(e);
+                                ++cell.nOuter;
+                            }
+                        }
+                    }
+                }
+            }
         }
 
-        for (Iter i = outerMaps.begin(); i != outerMaps.end(); ++i) {
-            // or can assign a dedicated innerList for this map, e.g. using hints from FHICL
-            outerCache.insert(std::make_pair(*i, CacheElement(*i, defaultInnerList)));
+        lookup_ = lk;
+    }
+
+    const BFMap* BFCacheManager::findMap(const CLHEP::Hep3Vector& x) const {
+        return findMap(x, threadCache());
+    }
+
+    const BFMap* BFCacheManager::findMapScan(const CLHEP::Hep3Vector& x,
+                                             Cache& cache,
+                                             const Lookup& lk) const {
+        // First try to find if the point belong to any of the inner maps.
+        // The lookup order here is optimized for the map used last time.
+        const CacheElement* last =
+            cache.innerForLastInner_ ? cache.innerForLastInner_ : cache.innerForLastOuter_;
+        const CacheElement* newinner = last->inner.findMap(x);
+        if (newinner) {  // Update cache
+            cache.innerForLastInner_ = newinner;
+            return newinner->myMap;
+        }
+
+        // The current point is not in any of the inner maps
+        cache.innerForLastInner_ = 0;
+        ++cache.stats_.outerFallthrough;
+
+        // The lookup order of the outer maps is always the same
+        const CacheElement* newouter = lk.outer.findMap(x);
+        if (!newouter) {
+            newouter = &lk.outerElements.front();
+            ++cache.stats_.notFound;
         }
 
-        CacheType::iterator p = outerCache.find(0);
-        assert(p != outerCache.end());
-        p->second = CacheElement(0, defaultInnerList);
-        innerForLastOuter = &p->second;
+        // Keep the inner map lookup optimized
+        cache.innerForLastOuter_ = newouter;
+        return newouter->myMap;
     }
+
+    const BFMap* BFCacheManager::findMapIndexed(const CLHEP::Hep3Vector& x,
+                                                Cache& cache,
+                                                const Lookup& lk) const {
+        const SpatialIndex::Cell* cell = lk.index.cell(x);
+        if (cell) {
+            const CacheElement* const* candidate = lk.index.candidates.data() + cell->begin;
+            const CacheElement* const* endInner = candidate + cell->nInner;
+            const CacheElement* const* endOuter = endInner + cell->nOuter;
+            for (; candidate != endInner; ++candidate) {
+                if ((*candidate)->myMap->isValid(x)) {
+                    cache.innerForLastInner_ = *candidate;
+                    return (*candidate)->myMap;
+                }
+            }
+            cache.innerForLastInner_ = 0;
+            ++cache.stats_.outerFallthrough;
+            for (; candidate != endOuter; ++candidate) {
+                if ((*candidate)->myMap->isValid(x)) {
+                    cache.innerForLastOuter_ = *candidate;
+                    return (*candidate)->myMap;
+                }
+            }
+        } else {
+            cache.innerForLastInner_ = 0;
+            ++cache.stats_.outerFallthrough;
+        }
+        ++cache.stats_.notFound;
+        cache.innerForLastOuter_ = &lk.outerElements.front();
+        return 0;
+    }
+
+    BFCacheManager::Cache& BFCacheManager::threadCache() {
+        thread_local Cache cache;
+        return cache;
+    }
+
+    const BFCacheManager::Stats& BFCacheManager::threadStats() {
+        return threadCache().stats();
+    }
+
 }  // namespace mu2e
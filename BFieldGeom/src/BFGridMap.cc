@@ -28,6 +28,33 @@ using namespace std;
 
 namespace mu2e {
 
+    BFGridMap::BFGridMap(std::string const& key,
+                         std::shared_ptr<const BFMappedFile> const& file,
+                         BFMapType::enum_type atype,
+                         double scale,
+                         BFInterpolationStyle style,
+                         bool warnIfOutside)
+        : BFMap(key,
+                file->header().xmin,
+                file->header().xmin + (file->header().nx - 1) * file->header().dx,
+                file->header().ymin,
+                file->header().ymin + (file->header().ny - 1) * file->header().dy,
+                file->header().zmin,
+                file->header().zmin + (file->header().nz - 1) * file->header().dz,
+                atype,
+                scale,
+                warnIfOutside),
+          _nx(file->header().nx),
+          _ny(file->header().ny),
+          _nz(file->header().nz),
+          _dx(file->header().dx),
+          _dy(file->header().dy),
+          _dz(file->header().dz),
+          _mappedFile(file),
+          _allDefined(true),
+          _flipy(file->header().flipy != 0),
+          _interpStyle(style) {}
+
     // function to determine if the point is in the map; take into account Y-symmetry
     bool BFGridMap::isValid(CLHEP::Hep3Vector const& point) const {
         if (point.x() < _xmin || point.x() > _xmax) {
@@ -68,9 +95,9 @@ namespace mu2e {
                 unsigned int yindex = iy + j - 1;
                 for (int k = 0; k != 3; ++k) {
                     unsigned int zindex = iz + k - 1;
-                    if (!_isDefined(xindex, yindex, zindex))
+                    if (!isDefined(xindex, yindex, zindex))
                         return false;
-                    neighborsBF[i][j][k] = _field(xindex, yindex, zindex);
+                    neighborsBF[i][j][k] = field(xindex, yindex, zindex);
                     /*
                               cout << "Neighbor(" << xindex << "," << yindex << "," << zindex
                               << ") = (" << neighborsBF(i,j,k).x() << ","
@@ -151,7 +178,8 @@ namespace mu2e {
         bool retval(false);
 
         if (_interpStyle == BFInterpolationStyle::trilinear) {
-            retval = interpolateTriLinear(testpoint, result);
+            retval = hasBrickedField() ? interpolateBricked(testpoint, result)
+                                       : interpolateTriLinear(testpoint, result);
 
         } else {
             throw cet::exception("GEOM")
@@ -162,6 +190,60 @@ namespace mu2e {
         return retval;
     }
 
+    std::size_t BFGridMap::getBField(std::span<const CLHEP::Hep3Vector> points,
+                                     std::span<CLHEP::Hep3Vector> fields) const {
+        if (_interpStyle != BFInterpolationStyle::trilinear || !hasBrickedField()) {
+            return BFMap::getBField(points, fields);
+        }
+
+        std::size_t nInside(0);
+        for (std::size_t i = 0; i != points.size(); ++i) {
+            if (interpolateBricked(points[i], fields[i])) {
+                ++nInside;
+            }
+            fields[i] *= _scaleFactor;
+        }
+        return nInside;
+    }
+
+    bool BFGridMap::getBFieldTriLinear(const CLHEP::Hep3Vector& testpoint,
+                                       CLHEP::Hep3Vector& result) const {
+        bool retval = interpolateTriLinear(testpoint, result);
+        result *= _scaleFactor;
+        return retval;
+    }
+
+    bool BFGridMap::getBFieldBricked(const CLHEP::Hep3Vector& testpoint,
+                                     CLHEP::Hep3Vector& result) const {
+        if (!hasBrickedField()) {
+            throw cet::exception("GEOM")
+                << "BFGridMap::getBFieldBricked: no bricked copy of the field for map: " << _key
+                << "\n";
+        }
+        bool retval = interpolateBricked(testpoint, result);
+        result *= _scaleFactor;
+        return retval;
+    }
+
+    // Quadratic interpolation on the 3x3x3 points around the nearest grid point.
+    bool BFGridMap::getBFieldQuadratic(const CLHEP::Hep3Vector& testpoint,
+                                       CLHEP::Hep3Vector& result) const {
+        CLHEP::Hep3Vector neighborPoints[3];
+        CLHEP::Hep3Vector neighborBF[3][3][3];
+        if (!getNeighborPointBF(testpoint, neighborPoints, neighborBF)) {
+            result = CLHEP::Hep3Vector(0., 0., 0.);
+            return false;
+        }
+
+        // getNeighborPointBF has already restored the sign of By for y<0.
+        double py = _flipy ? std::abs(testpoint.y()) : testpoint.y();
+        CLHEP::Hep3Vector frac((testpoint.x() - neighborPoints[0].x()) / _dx,
+                               (py - neighborPoints[0].y()) / _dy,
+                               (testpoint.z() - neighborPoints[0].z()) / _dz);
+        result = interpolate(neighborBF, frac) * _scaleFactor;
+        return true;
+    }
+
     // The algorithm is:
     // Find the grid cube in which the point lives - this defines eight corner points.
     // Assign a weight to each corner that is the "distance" to each corner - see below for
@@ -199,10 +281,10 @@ namespace mu2e {
         // Field values at the 8 corner points.
         // Guess that a copy is faster than a pointer for reasons of locality
         // of reference in the downstream code?
-        CLHEP::Hep3Vector c[8] = {_field(i, j, k),         _field(i + 1, j, k),
-                                  _field(i, j + 1, k),     _field(i + 1, j + 1, k),
-                                  _field(i, j, k + 1),     _field(i + 1, j, k + 1),
-                                  _field(i, j + 1, k + 1), _field(i + 1, j + 1, k + 1)};
+        CLHEP::Hep3Vector c[8] = {field(i, j, k),         field(i + 1, j, k),
+                                  field(i, j + 1, k),     field(i + 1, j + 1, k),
+                                  field(i, j, k + 1),     field(i + 1, j, k + 1),
+                                  field(i, j + 1, k + 1), field(i + 1, j + 1, k + 1)};
 
         double bx = c[0].x() * fx * fy * fz + c[1].x() * (1.0 - fx) * fy * fz +
                     c[2].x() * fx * (1.0 - fy) * fz + c[3].x() * (1.0 - fx) * (1.0 - fy) * fz +
@@ -232,6 +314,65 @@ namespace mu2e {
     }
 
 
+    // Same algorithm as interpolateTriLinear but using the single precision bricks.
+    bool BFGridMap::interpolateBricked(const CLHEP::Hep3Vector& p,
+                                       CLHEP::Hep3Vector& result) const {
+        double px = p.x();
+        double py = p.y();
+        if (_flipy)
+            py = std::abs(p.y());
+        double pz = p.z();
+
+        // Position in units of the grid spacing.
+        double ux = (px - _xmin) / _dx;
+        double uy = (py - _ymin) / _dy;
+        double uz = (pz - _zmin) / _dz;
+
+        // Indicies into each dimension;
+        int i = floor(ux);
+        int j = floor(uy);
+        int k = floor(uz);
+
+        // Check that we are inside the map.
+        if (i < 0 || i >= int(_nx) || j < 0 || j >= int(_ny) || k < 0 || k >= int(_nz)) {
+            if (_warnIfOutside) {
+                mf::LogWarning("GEOM")
+                    << "Point is outside of the valid region of the map: " << _key << "\n"
+                    << "Point in input coordinates: " << p << "\n";
+            }
+            result = CLHEP::Hep3Vector(0., 0., 0.);
+            return false;
+        }
+
+        // A point on the upper face of the map belongs to the last cell.
+        if (i == int(_nx) - 1)
+            --i;
+        if (j == int(_ny) - 1)
+            --j;
+        if (k == int(_nz) - 1)
+            --k;
+
+        double b[3];
+        _bricks.interpolate(i, j, k, ux - i, uy - j, uz - k, b);
+
+        // Need the signed value of p.y() here - the variable py will not do.
+        if (_flipy && p.y() < 0)
+            b[1] = -b[1];
+
+        result = CLHEP::Hep3Vector(b[0], b[1], b[2]);
+
+        return true;
+    }
+
+    void BFGridMap::buildBrickedField() {
+        if (_nx < 2 || _ny < 2 || _nz < 2) {
+            throw cet::exception("GEOM")
+                << "BFGridMap: cannot make a bricked copy of the field for map: " << _key
+                << "; it needs at least 2 grid points along each axis.\n";
+        }
+        _bricks = BFBrickedField(fieldData(), _nx, _ny, _nz);
+    }
+
     bool BFGridMap::getNeighborPointBF(const CLHEP::Hep3Vector& testpoint,
                                        CLHEP::Hep3Vector neighborPoints[3],
                                        CLHEP::Hep3Vector neighborBF[3][3][3]) const {
@@ -281,7 +422,7 @@ namespace mu2e {
 
         // check if the point had a field defined
 
-        if (!_isDefined(ix, iy, iz)) {
+        if (!isDefined(ix, iy, iz)) {
             if (_warnIfOutside) {
                 mf::LogWarning("GEOM")
                     << "Point's field is not defined in the map: " << _key << "\n"
@@ -299,7 +440,7 @@ namespace mu2e {
                 unsigned int yindex = iy + j - 1;
                 for (int k = 0; k != 3; ++k) {
                     unsigned int zindex = iz + k - 1;
-                    if (!_isDefined(xindex, yindex, zindex)) {
+                    if (!isDefined(xindex, yindex, zindex)) {
                         if (_warnIfOutside) {
                             mf::LogWarning("GEOM")
                                 << "Point's neighboring field is not defined in the map: " << _key
@@ -310,7 +451,7 @@ namespace mu2e {
                         }
                         return false;
                     }
-                    neighborBF[i][j][k] = _field(xindex, yindex, zindex);
+                    neighborBF[i][j][k] = field(xindex, yindex, zindex);
                     // Reassign y sign
                     if (_flipy && sign == -1) {
                         neighborBF[i][j][k].setY(-neighborBF[i][j][k].y());
@@ -340,11 +481,20 @@ namespace mu2e {
              << endl;
         cout << "Distance:       " << _dx << " " << _dy << " " << _dz << endl;
 
-        cout << "Field at the edges: " << _field(0, 0, 0) << ", " << _field(_nx - 1, 0, 0) << ", "
-             << _field(0, _ny - 1, 0) << ", " << _field(0, 0, _nz - 1) << ", "
-             << _field(_nx - 1, _ny - 1, 0) << ", " << _field(_nx - 1, _ny - 1, _nz - 1) << endl;
+        cout << "Field at the edges: " << field(0, 0, 0) << ", " << field(_nx - 1, 0, 0) << ", "
+             << field(0, _ny - 1, 0) << ", " << field(0, 0, _nz - 1) << ", "
+             << field(_nx - 1, _ny - 1, 0) << ", " << field(_nx - 1, _ny - 1, _nz - 1) << endl;
+
+        cout << "Field in the middle: " << field(_nx / 2, _ny / 2, _nz / 2) << endl;
 
-        cout << "Field in the middle: " << _field(_nx / 2, _ny / 2, _nz / 2) << endl;
+        if (isMapped()) {
+            cout << "Field values mapped from: " << _mappedFile->filename() << endl;
+        }
+
+        if (hasBrickedField()) {
+            cout << "Bricked single precision copy of the field: " << _bricks.memoryUsed()
+                 << " bytes" << endl;
+        }
 
         if (_warnIfOutside) {
             cout << "Will warn if outside of the valid region." << endl;
@@ -0,0 +1,217 @@
+//
+// A grid field map stored in a file that is used in place through mmap.
+//
+
+// C++ includes
+#include <cstring>
+#include <iomanip>
+#include <vector>
+
+// Includes from C ( needed for block IO and mmap ).
+#include <errno.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+#include <unistd.h>
+
+// Framework includes
+#include "cetlib_except/exception.h"
+
+// Mu2e includes
+#include "Offline/BFieldGeom/inc/BFMappedFile.hh"
+
+namespace mu2e {
+
+  namespace {
+
+    constexpr char kMagic[8] = {'M', 'u', '2', 'e', 'B', 'F', 'l', 'd'};
+
+    // The field values are used in place as an array of Hep3Vector.
+    static_assert(sizeof(CLHEP::Hep3Vector) == 3 * sizeof(double),
+                  "BFMappedFile requires CLHEP::Hep3Vector to be three packed doubles");
+
+    // The header is written and checksummed as raw bytes so it must not contain padding.
+    static_assert(sizeof(BFMappedFile::Header) == 112, "BFMappedFile::Header has padding");
+    static_assert(sizeof(BFMappedFile::Header) <= BFMappedFile::kDataOffset);
+
+    std::uint64_t headerChecksum(BFMappedFile::Header const& h) {
+      return BFMappedFile::checksum(&h, offsetof(BFMappedFile::Header, headerChecksum));
+    }
+
+    // Write all of the bytes or throw.
+    void writeAll(int fd, void const* buf, std::size_t nbytes, std::string const& filename) {
+      char const* p = static_cast<char const*>(buf);
+      while (nbytes > 0) {
+        ssize_t s = write(fd, p, nbytes);
+        if (s < 0) {
+          int errsave = errno;
+          close(fd);
+          throw cet::exception("GEOM")
+            << "BFMappedFile::write Error writing to " << filename
+            << "  errno: " << errsave << " " << strerror(errsave) << "\n";
+        }
+        p += s;
+        nbytes -= s;
+      }
+    }
+
+  } // end anonymous namespace
+
+  std::uint64_t BFMappedFile::checksum(void const* data, std::size_t nbytes) {
+    unsigned char const* p = static_cast<unsigned char const*>(data);
+    std::uint64_t hash = 0xcbf29ce484222325ULL;
+    for (std::size_t i = 0; i != nbytes; ++i) {
+      hash ^= p[i];
+      hash *= 0x100000001b3ULL;
+    }
+    return hash;
+  }
+
+  BFMappedFile::BFMappedFile(std::string const& filename, bool verifyData)
+    : _filename(filename) {
+
+    int fd = open(filename.c_str(), O_RDONLY);
+    if (fd < 0) {
+      int errsave = errno;
+      throw cet::exception("GEOM")
+        << "BFMappedFile: Error opening " << filename
+        << "  errno: " << errsave << " " << strerror(errsave) << "\n";
+    }
+
+    struct stat info;
+    if (fstat(fd, &info)) {
+      int errsave = errno;
+      close(fd);
+      throw cet::exception("GEOM")
+        << "BFMappedFile: Error doing fstat() on " << filename
+        << "  errno: " << errsave << " " << strerror(errsave) << "\n";
+    }
+    _size = info.st_size;
+
+    // Check the header before mapping anything.
+    if (_size < sizeof(Header) || pread(fd, &_header, sizeof(Header), 0) != ssize_t(sizeof(Header))) {
+      close(fd);
+      throw cet::exception("GEOM")
+        << "BFMappedFile: " << filename << " is too short to hold a header.\n";
+    }
+
+    if (std::memcmp(_header.magic, kMagic, sizeof(kMagic)) != 0) {
+      close(fd);
+      throw cet::exception("GEOM")
+        << "BFMappedFile: " << filename << " is not a Mu2e mapped field map file.\n";
+    }
+
+    if (_header.endianMarker != kEndianMarker) {
+      close(fd);
+      throw cet::exception("GEOM")
+        << "BFMappedFile: endian mismatch in " << filename
+        << "  returned value: " << std::hex << _header.endianMarker
+        << "  expected value: " << kEndianMarker << std::dec << "\n"
+        << "Suggestion: remake the file on this platform from the text format map.\n";
+    }
+
+    if (_header.version != kVersion) {
+      close(fd);
+      throw cet::exception("GEOM")
+        << "BFMappedFile: " << filename << " has format version " << _header.version
+        << " but this code reads version " << kVersion << ". Please remake the file.\n";
+    }
+
+    if (_header.headerChecksum != headerChecksum(_header)) {
+      close(fd);
+      throw cet::exception("GEOM")
+        << "BFMappedFile: header checksum mismatch in " << filename << "\n";
+    }
+
+    std::uint64_t npoints = std::uint64_t(_header.nx) * _header.ny * _header.nz;
+    if (_header.dataSize != npoints * sizeof(CLHEP::Hep3Vector) ||
+        _header.dataOffset % sizeof(double) != 0 ||
+        _size != _header.dataOffset + _header.dataSize) {
+      close(fd);
+      throw cet::exception("GEOM")
+        << "BFMappedFile: the size = " << _size << " of the file " << filename
+        << " does not match its header: data offset " << _header.dataOffset
+        << ", data size " << _header.dataSize
+        << " for a grid of " << _header.nx << " x " << _header.ny << " x " << _header.nz << "\n";
+    }
+
+    // Map the whole file. The mapping remains valid after the descriptor is closed.
+    _base = mmap(nullptr, _size, PROT_READ, MAP_SHARED, fd, 0);
+    int errsave = errno;
+    close(fd);
+    if (_base == MAP_FAILED) {
+      _base = nullptr;
+      throw cet::exception("GEOM")
+        << "BFMappedFile: Error doing mmap() on " << filename
+        << "  errno: " << errsave << " " << strerror(errsave) << "\n";
+    }
+
+    _field = reinterpret_cast<CLHEP::Hep3Vector const*>(static_cast<char const*>(_base) +
+                                                         _header.dataOffset);
+
+    if (verifyData && checksum(_field, _header.dataSize) != _header.dataChecksum) {
+      munmap(_base, _size);
+      throw cet::exception("GEOM")
+        << "BFMappedFile: checksum of the field values does not match the header in "
+        << filename << "\n";
+    }
+  }
+
+  BFMappedFile::~BFMappedFile() {
+    if (_base != nullptr) {
+      munmap(_base, _size);
+    }
+  }
+
+  void BFMappedFile::write(std::string const& filename,
+                           unsigned nx, unsigned ny, unsigned nz,
+                           double xmin, double ymin, double zmin,
+                           double dx, double dy, double dz,
+                           bool flipy,
+                           CLHEP::Hep3Vector const* field) {
+    Header h;
+    std::memset(&h, 0, sizeof(h));
+    std::memcpy(h.magic, kMagic, sizeof(kMagic));
+    h.endianMarker = kEndianMarker;
+    h.version = kVersion;
+    h.dataOffset = kDataOffset;
+    h.dataSize = std::uint64_t(nx) * ny * nz * sizeof(CLHEP::Hep3Vector);
+    h.nx = nx;
+    h.ny = ny;
+    h.nz = nz;
+    h.flipy = flipy ? 1 : 0;
+    h.xmin = xmin;
+    h.ymin = ymin;
+    h.zmin = zmin;
+    h.dx = dx;
+    h.dy = dy;
+    h.dz = dz;
+    h.dataChecksum = checksum(field, h.dataSize);
+    h.headerChecksum = headerChecksum(h);
+
+    // Open the output file.
+    mode_t mode = S_IRUSR | S_IWUSR | S_IRGRP | S_IROTH;
+    int flags = O_CREAT | O_WRONLY | O_TRUNC | O_EXCL;
+    int fd = open(filename.c_str(), flags, mode);
+    if (fd < 0) {
+      int errsave = errno;
+      if (errsave == EEXIST) {
+        throw cet::exception("GEOM") << "BFMappedFile::write Error opening "
+                                     << filename << "  File already exists.\n";
+      }
+      throw cet::exception("GEOM")
+        << "BFMappedFile::write Error opening " << filename
+        << "  errno: " << errsave << " " << strerror(errsave) << "\n";
+    }
+
+    // Header, padding up to the start of the data, then the data.
+    std::vector<char> padding(kDataOffset - sizeof(Header), 0);
+    writeAll(fd, &h, sizeof(h), filename);
+    writeAll(fd, padding.data(), padding.size(), filename);
+    writeAll(fd, field, h.dataSize, filename);
+
+    close(fd);
+  }
+
+} // end namespace mu2e
@@ -72,45 +72,40 @@ namespace mu2e {
         double r, phi;
         // The declarations below are to reduce computation time
         double bessels[2];
-        double tmp_rho;
+        double tmp_rho, iv, ivp;
         double cos_nphi, cos_kmsz;
         double sin_nphi, sin_kmsz;
         double abp, abm;
-        vector<double> out(3, 0);
         phi = atan2(p.y(), p.x() + 3896);
         r = sqrt(pow(p.x() + 3896, 2) + pow(p.y(), 2));
         double abs_r = abs(r);
 
-        for (int n = 0; n < _ns; ++n) {
-            for (int m = 1; m <= _ms; ++m) {
-                tmp_rho = _kms[n][m - 1] * abs_r;
-                bessels[0] = gsl_sf_bessel_In(n, tmp_rho);
-                bessels[1] = gsl_sf_bessel_In(n + 1, tmp_rho);
-                _iv[n][m - 1] = bessels[0];
-                if (tmp_rho == 0) {
-                    _ivp[n][m - 1] = 0.5 * (gsl_sf_bessel_In(n - 1, 0) + bessels[1]);
-                } else {
-                    _ivp[n][m - 1] = (n / tmp_rho) * bessels[0] + bessels[1];
-                }
-            }
-        }
-
         double br(0.0);
         double bphi(0.0);
         double bz(0.0);
-        // Here is the meat of the calculation:
+        // Here is the meat of the calculation.  The Bessel function values are
+        // kept in locals, not in the map, so the map can be used from several threads
         for (int n = 0; n < _ns; ++n) {
             cos_nphi = cos(n * phi + _Ds[n]);
             sin_nphi = -sin(n * phi + _Ds[n]);
             for (int m = 0; m < _ms; ++m) {
+                tmp_rho = _kms[n][m] * abs_r;
+                bessels[0] = gsl_sf_bessel_In(n, tmp_rho);
+                bessels[1] = gsl_sf_bessel_In(n + 1, tmp_rho);
+                iv = bessels[0];
+                if (tmp_rho == 0) {
+                    ivp = 0.5 * (gsl_sf_bessel_In(n - 1, 0) + bessels[1]);
+                } else {
+                    ivp = (n / tmp_rho) * bessels[0] + bessels[1];
+                }
                 cos_kmsz = cos(_kms[n][m] * p.z());
                 sin_kmsz = sin(_kms[n][m] * p.z());
                 abp = _As[n][m] * cos_kmsz + _Bs[n][m] * sin_kmsz;
                 abm = -_As[n][m] * sin_kmsz + _Bs[n][m] * cos_kmsz;
-                br += cos_nphi * _ivp[n][m] * _kms[n][m] * abp;
-                bz += cos_nphi * _iv[n][m] * _kms[n][m] * abm;
+                br += cos_nphi * ivp * _kms[n][m] * abp;
+                bz += cos_nphi * iv * _kms[n][m] * abm;
                 if (abs_r > 1e-10) {
-                    bphi += n * sin_nphi * (1 / abs_r) * _iv[n][m] * abp;
+                    bphi += n * sin_nphi * (1 / abs_r) * iv * abp;
                 }
             }
         }
@@ -146,13 +141,6 @@ namespace mu2e {
                 _kms[n].push_back(m * M_PI / _Reff);
             }
         }
-
-        for (int n = 0; n < _ns; ++n) {
-            vector<double> tmp_v1(_ms, 0.0);
-            vector<double> tmp_v2(_ms, 0.0);
-            _iv.push_back(tmp_v1);
-            _ivp.push_back(tmp_v2);
-        }
     }
 
 }  // end namespace mu2e
@@ -5,6 +5,7 @@
 // Modified by Brian Pollack to allow for polymorphic BField class.
 
 // Includes from C++
+#include <algorithm>
 #include <iostream>
 
 // Framework includes
@@ -17,6 +18,67 @@ using namespace std;
 
 namespace mu2e {
 
+    namespace {
+
+        // Field at one point from the map chosen by findMap.
+        template <class FindMap>
+        bool fieldFromMap(const CLHEP::Hep3Vector& point,
+                          CLHEP::Hep3Vector& result,
+                          FindMap findMap) {
+            const BFMap* m = findMap(point);
+
+            if (m) {
+                m->getBFieldWithStatus(point, result);
+            } else {
+                result = CLHEP::Hep3Vector(0., 0., 0.);
+            }
+
+            return (m != 0);
+        }
+
+        // Batched lookup; runs of consecutive points that use the same map are passed
+        // to that map in one call.
+        template <class FindMap>
+        std::size_t fieldsFromMaps(std::span<const CLHEP::Hep3Vector> points,
+                                   std::span<CLHEP::Hep3Vector> fields,
+                                   FindMap findMap) {
+            if (fields.size() < points.size()) {
+                throw cet::exception("BFIELD")
+                    << "BFieldManager::getBField: room for " << fields.size()
+                    << " field values but " << points.size() << " points were given.\n";
+            }
+
+            std::size_t nInside(0);
+            std::size_t const n = points.size();
+            std::size_t begin(0);
+            const BFMap* m = (n > 0) ? findMap(points[0]) : nullptr;
+            while (begin < n) {
+                // Find the end of the run of points that use the same map.
+                std::size_t end = begin + 1;
+                const BFMap* next = nullptr;
+                while (end < n) {
+                    next = findMap(points[end]);
+                    if (next != m)
+                        break;
+                    ++end;
+                }
+
+                auto runPoints = points.subspan(begin, end - begin);
+                auto runFields = fields.subspan(begin, end - begin);
+                if (m) {
+                    nInside += m->getBField(runPoints, runFields);
+                } else {
+                    std::fill(runFields.begin(), runFields.end(), CLHEP::Hep3Vector(0., 0., 0.));
+                }
+
+                begin = end;
+                m = next;
+            }
+            return nInside;
+        }
+
+    }  // namespace
+
     // Get field at an arbitrary point. This code figures out which map to use
     // and looks up the field in that map.
     bool BFieldManager::getBFieldWithStatus(const CLHEP::Hep3Vector& point,
@@ -30,22 +92,42 @@ namespace mu2e {
     bool BFieldManager::getBFieldWithStatus(const CLHEP::Hep3Vector& point,
                                             BFCacheManager const& cmgr,
                                             CLHEP::Hep3Vector& result) const {
-        auto m = cmgr.findMap(point);
+        return fieldFromMap(point, result,
+                            [&cmgr](const CLHEP::Hep3Vector& x) { return cmgr.findMap(x); });
+    }
 
-        if (m) {
-            m->getBFieldWithStatus(point, result);
-        } else {
-            result = CLHEP::Hep3Vector(0., 0., 0.);
-        }
+    bool BFieldManager::getBFieldWithStatus(const CLHEP::Hep3Vector& point,
+                                            BFCacheManager::Cache& cache,
+                                            CLHEP::Hep3Vector& result) const {
+        return fieldFromMap(point, result,
+                            [this, &cache](const CLHEP::Hep3Vector& x) { return cm_.findMap(x, cache); });
+    }
 
-        return (m != 0);
+
+    std::size_t BFieldManager::getBField(std::span<const CLHEP::Hep3Vector> points,
+                                         std::span<CLHEP::Hep3Vector> fields) const {
+        return getBField(points, cm_, fields);
+    }
+
+    std::size_t BFieldManager::getBField(std::span<const CLHEP::Hep3Vector> points,
+                                         BFCacheManager const& cmgr,
+                                         std::span<CLHEP::Hep3Vector> fields) const {
+        return fieldsFromMaps(points, fields,
+                              [&cmgr](const CLHEP::Hep3Vector& x) { return cmgr.findMap(x); });
     }
 
+    std::size_t BFieldManager::getBField(std::span<const CLHEP::Hep3Vector> points,
+                                         BFCacheManager::Cache& cache,
+                                         std::span<CLHEP::Hep3Vector> fields) const {
+        return fieldsFromMaps(points, fields,
+                              [this, &cache](const CLHEP::Hep3Vector& x) { return cm_.findMap(x, cache); });
+    }
 
   BFieldManager::BFieldManager(MapContainerType const& innerMaps,
-                               MapContainerType const& outerMaps):
+                               MapContainerType const& outerMaps,
+                               bool spatialIndex):
     innerMaps_(innerMaps),outerMaps_(outerMaps) {
-    cm_.setMaps(innerMaps, outerMaps);
+    cm_.setMaps(innerMaps, outerMaps, spatialIndex);
 
   }
     void BFieldManager::print(ostream& out) const {
@@ -0,0 +1,184 @@
+//
+// Compare accuracy and throughput of the interpolation methods of BFGridMap:
+//   - trilinear interpolation on the double precision grid (the default)
+//   - quadratic interpolation on the 3x3x3 neighbours of the nearest grid point
+//   - trilinear interpolation on the single precision, cache-blocked copy of the
+//     grid, one point per call and through the batched getBField interface.
+//
+// The bricked methods are only available if the geometry file sets
+//   bool bfield.brickedStorage = true;
+//
+// The work is done in the beginRun member function.
+// The magnetic field map may depend on run number so it is
+// not available at c'to time or beginJob time.
+//
+
+#include "Offline/BFieldGeom/inc/BFGridMap.hh"
+#include "Offline/BFieldGeom/inc/BFieldManager.hh"
+#include "Offline/GeometryService/inc/GeomHandle.hh"
+#include "Offline/SeedService/inc/SeedService.hh"
+
+#include "art/Framework/Core/EDAnalyzer.h"
+#include "art/Framework/Principal/Event.h"
+#include "art/Framework/Principal/Run.h"
+
+#include "CLHEP/Random/RandFlat.h"
+#include "CLHEP/Vector/ThreeVector.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <span>
+#include <string>
+#include <vector>
+
+namespace {
+
+    // Accumulate the differences between a method and the reference method.
+    struct Residuals {
+        void fill(CLHEP::Hep3Vector const& b, CLHEP::Hep3Vector const& bref) {
+            double d = (b - bref).mag();
+            sum2 += d * d;
+            maxDiff = std::max(maxDiff, d);
+            ++n;
+        }
+        double rms() const { return n > 0 ? std::sqrt(sum2 / n) : 0.; }
+
+        double sum2 = 0.;
+        double maxDiff = 0.;
+        std::size_t n = 0;
+    };
+
+    // Time one call per point to the given member function of the map.
+    template <class F>
+    double timePerPoint(std::vector<CLHEP::Hep3Vector> const& points,
+                        std::vector<CLHEP::Hep3Vector>& fields,
+                        F f) {
+        auto t0 = std::chrono::steady_clock::now();
+        for (std::size_t i = 0; i != points.size(); ++i) {
+            f(points[i], fields[i]);
+        }
+        auto t1 = std::chrono::steady_clock::now();
+        return std::chrono::duration<double, std::nano>(t1 - t0).count() / points.size();
+    }
+
+    void printRow(std::string const& method, double nsPerPoint, Residuals const& r) {
+        std::cout << "  " << std::left << std::setw(12) << method << std::right << std::fixed
+                  << std::setprecision(1) << std::setw(10) << nsPerPoint << " ns/point"
+                  << std::scientific << std::setprecision(3) << "   rms |dB|: " << r.rms()
+                  << " T   max |dB|: " << r.maxDiff << " T" << std::defaultfloat << std::endl;
+    }
+
+}  // end anonymous namespace
+
+namespace mu2e {
+
+    class BFieldInterpolationBenchmark : public art::EDAnalyzer {
+       public:
+        explicit BFieldInterpolationBenchmark(const fhicl::ParameterSet& pset);
+
+        void beginRun(const art::Run& run) override;
+        void analyze(const art::Event&) override {}
+
+       private:
+        // Names of maps to check; if empty check all grid maps.
+        std::vector<std::string> mapNames_;
+
+        // Number of test points to draw.
+        int nPoints_;
+
+        // Uniform flat random distribution.
+        CLHEP::RandFlat flat_;
+
+        void benchmark(BFGridMap const& map);
+    };
+
+}  // namespace mu2e
+
+mu2e::BFieldInterpolationBenchmark::BFieldInterpolationBenchmark(const fhicl::ParameterSet& pset)
+    : art::EDAnalyzer(pset),
+      mapNames_(pset.get<std::vector<std::string>>("mapNames", {})),
+      nPoints_(pset.get<int>("nPoints")),
+      flat_(createEngine(art::ServiceHandle<mu2e::SeedService>()->getSeed())) {}
+
+void mu2e::BFieldInterpolationBenchmark::beginRun(const art::Run& run) {
+    GeomHandle<BFieldManager> bfmgr;
+
+    for (auto const* maps : {&bfmgr->getInnerMaps(), &bfmgr->getOuterMaps()}) {
+        for (auto const& map : *maps) {
+            auto const* grid = dynamic_cast<BFGridMap const*>(map.get());
+            if (grid == nullptr) {
+                continue;
+            }
+            if (!mapNames_.empty() &&
+                std::find(mapNames_.begin(), mapNames_.end(), map->getKey()) == mapNames_.end()) {
+                continue;
+            }
+            benchmark(*grid);
+        }
+    }
+}
+
+void mu2e::BFieldInterpolationBenchmark::benchmark(BFGridMap const& map) {
+    // Random points, uniformly distributed over the volume of the map.
+    std::vector<CLHEP::Hep3Vector> points;
+    points.reserve(nPoints_);
+    for (int i = 0; i < nPoints_; ++i) {
+        points.emplace_back(flat_.fire(map.xmin(), map.xmax()),
+                            flat_.fire(map.ymin(), map.ymax()),
+                            flat_.fire(map.zmin(), map.zmax()));
+    }
+
+    std::vector<CLHEP::Hep3Vector> bref(points.size()), bquad(points.size());
+    std::vector<CLHEP::Hep3Vector> bbrick(points.size()), bbatch(points.size());
+
+    double nsTriLinear = timePerPoint(points, bref, [&](auto const& p, auto& b) {
+        map.getBFieldTriLinear(p, b);
+    });
+
+    // The quadratic method fails near the edges of the map; skip those points.
+    std::vector<char> quadOK(points.size(), 0);
+    std::size_t iq(0);
+    double nsQuadratic = timePerPoint(points, bquad, [&](auto const& p, auto& b) {
+        quadOK[iq++] = map.getBFieldQuadratic(p, b);
+    });
+
+    Residuals rRef, rQuad;
+    for (std::size_t i = 0; i != points.size(); ++i) {
+        if (quadOK[i]) {
+            rQuad.fill(bquad[i], bref[i]);
+        }
+    }
+
+    std::cout << "BFieldInterpolationBenchmark: map " << map.getKey() << ", " << points.size()
+              << " points; differences are with respect to trilinear" << std::endl;
+    printRow("trilinear", nsTriLinear, rRef);
+    printRow("quadratic", nsQuadratic, rQuad);
+
+    if (!map.hasBrickedField()) {
+        std::cout << "  bricked storage not enabled; set bfield.brickedStorage = true" << std::endl;
+        return;
+    }
+
+    double nsBricked = timePerPoint(points, bbrick, [&](auto const& p, auto& b) {
+        map.getBFieldBricked(p, b);
+    });
+
+    auto t0 = std::chrono::steady_clock::now();
+    map.getBField(std::span<const CLHEP::Hep3Vector>(points), std::span<CLHEP::Hep3Vector>(bbatch));
+    auto t1 = std::chrono::steady_clock::now();
+    double nsBatch = std::chrono::duration<double, std::nano>(t1 - t0).count() / points.size();
+
+    Residuals rBrick, rBatch;
+    for (std::size_t i = 0; i != points.size(); ++i) {
+        rBrick.fill(bbrick[i], bref[i]);
+        rBatch.fill(bbatch[i], bref[i]);
+    }
+    printRow("bricked", nsBricked, rBrick);
+    printRow("batched", nsBatch, rBatch);
+    std::cout << "  bricked storage: " << map.brickedField().memoryUsed() << " bytes" << std::endl;
+}
+
+DEFINE_ART_MODULE(mu2e::BFieldInterpolationBenchmark)
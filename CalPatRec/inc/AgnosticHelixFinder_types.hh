@@ -87,6 +87,11 @@ namespace mu2e {
       tripletPoint k;
     };
 
+    struct tripletCandidate { // for trying triplets in order of rank
+      triplet trip;
+      float   score;
+    };
+
     //-----------------------------------------------------------------------------
     // Used in the AgnosticHelixFinderDiag
     //-----------------------------------------------------------------------------
@@ -9,6 +9,11 @@
 #include "fhiclcpp/types/Sequence.h"
 #include "fhiclcpp/ParameterSet.h"
 
+#include "tbb/parallel_for.h"
+#include "tbb/task_arena.h"
+
+#include <memory>
+
 #include "Offline/RecoDataProducts/inc/StrawHit.hh"
 #include "Offline/RecoDataProducts/inc/StrawHitFlag.hh"
 #include "Offline/RecoDataProducts/inc/TimeCluster.hh"
@@ -72,6 +77,7 @@ namespace mu2e {
       fhicl::Atom<bool>            testHitMask       {Name("testHitMask"       ), Comment("if true, test hit mask"      ) };
       fhicl::Sequence<std::string> goodHitMask       {Name("goodHitMask"       ), Comment("good hit mask"               ) };
       fhicl::Sequence<std::string> bkgHitMask        {Name("bkgHitMask"        ), Comment("background hit mask"         ) };
+      fhicl::Atom<int>             nStationThreads   {Name("nStationThreads"   ), Comment("if >0, N threads for per-station steps"), 0};
     };
   public:
 //-----------------------------------------------------------------------------
@@ -120,6 +126,10 @@ namespace mu2e {
     int             _printErrors;
     int             _testOrder;
     int             _doTiming;
+    int             _stationTiming;        // timing level inside the per-station steps, 0 if parallel
+
+    int             _nStationThreads;      // if > 0, per-station steps run in parallel
+    std::unique_ptr<tbb::task_arena> _arena;
 
     bool            _testHitMask;
     StrawHitFlag    _goodHitMask;
@@ -146,6 +156,7 @@ namespace mu2e {
     void         completeSeed        (DeltaSeed* Seed);
 
     void         findSeeds           (int Station, int Face);
+    void         findSeeds           (int Station);
     void         findSeeds           ();
     void         linkDeltaSeeds      ();                        // do it in upstream direction
     int          mergeDeltaCandidates();
@@ -157,6 +168,12 @@ namespace mu2e {
     int          recoverStation      (DeltaCandidate* Delta, int LastStation, int Station, int UseUsedHits, int RecoverSeeds);
     void         run                 ();
 //-----------------------------------------------------------------------------
+// call Function(station) for all stations, in parallel if _nStationThreads > 0.
+// Function must only touch the data of its own station
+//-----------------------------------------------------------------------------
+    template <class F>
+    void         forEachStation      (F const& Function);
+//-----------------------------------------------------------------------------
 // chi2 calculation. Split chi^2 into parallel and perpendicular to the wire components
 //-----------------------------------------------------------------------------
     void         deltaChi2(DeltaCandidate* Delta, float Xc, float Yc, float& Chi2Par, float& Chi2Perp);
@@ -183,8 +200,21 @@ namespace mu2e {
     int          mergeNonOverlappingCandidates(std::vector<ProtonCandidate*>* Pc);
     int          mergeProtonCandidates        ();
     int          prepareProtonHits            ();
+    void         prepareProtonHits            (int Station);
     int          recoverMissingProtonHits     ();
     int          resolveProtonOverlaps        (std::vector<ProtonCandidate*>* Pc);
   };
+
+  template <class F>
+  void DeltaFinderAlg::forEachStation(F const& Function) {
+    if (_arena) {
+      _arena->execute([&]() {
+        tbb::parallel_for(0, int(kNStations), [&](int Station) { Function(Station); });
+      });
+    }
+    else {
+      for (int s=0; s<kNStations; ++s) Function(s);
+    }
+  }
 }
 #endif
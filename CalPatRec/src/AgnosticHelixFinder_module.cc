@@ -97,6 +97,9 @@ namespace mu2e {
       fhicl::Atom<float>           maxEDepAvg             {Name("maxEDepAvg"           ), Comment("max avg edep of combohits"   )  };
       fhicl::Atom<float>           tzSlopeSigThresh       {Name("tzSlopeSigThresh"     ), Comment("direction ambiguous if below")  };
       fhicl::Sequence<std::string> validHelixDirections   {Name("validHelixDirections" ), Comment("only save desired directions")  };
+      fhicl::Atom<bool>            pruneTriplets          {Name("pruneTriplets"        ), Comment("skip triplets out of the pt window"), true};
+      fhicl::Atom<bool>            rankTriplets           {Name("rankTriplets"         ), Comment("try triplets of a seed hit by area"), false};
+      fhicl::Atom<int>             maxTripletsPerCluster  {Name("maxTripletsPerCluster"), Comment("triplet budget per tc, 0: none"), 0};
 
       fhicl::Table<AgnosticHelixFinderTypes::Config> diagPlugin  {Name("diagPlugin"), Comment("diag plugin"                   )  };
     };
@@ -176,6 +179,8 @@ namespace mu2e {
     float    _maxEDepAvg;
     float    _tzSlopeSigThresh;
     std::vector<TrkFitDirection::FitDirection> _validHelixDirections;
+    bool     _rankTriplets;
+    int      _maxTripletsPerCluster;
 
     //-----------------------------------------------------------------------------
     // diagnostics
@@ -201,6 +206,23 @@ namespace mu2e {
     bool                          _intenseEvent;
     bool                          _intenseCluster;
 
+    //-----------------------------------------------------------------------------
+    // triplet search: the circle of a triplet has a radius in the pt window, so
+    // pairs farther apart than its diameter and triplets with a circumradius
+    // clearly out of the window are skipped before the circle fit
+    //-----------------------------------------------------------------------------
+    bool                          _pruneTriplets;
+    float                         _minTripletRadius;
+    float                         _maxTripletRadius;
+    float                         _maxTripletPairDistSq;
+    std::vector<tripletCandidate> _rankedTriplets;
+    int                           _nTripletsInCluster;
+    long                          _nTripletsPruned;
+    long                          _nTripletsTried;
+    long                          _nTruncatedClusters;
+    long                          _nEvents;
+    long                          _nHelices;
+
     //-----------------------------------------------------------------------------
     // stuff for tool
     //-----------------------------------------------------------------------------
@@ -240,6 +262,11 @@ namespace mu2e {
     void         setFlags                  ();
     void         resetFlags                ();
     bool         findHelix                 (size_t tc, HelixSeedCollection& HSColl);
+    bool         tryTriplet                (size_t tc, HelixSeedCollection& HSColl, const triplet& trip,
+                                            bool& uselessSeed, bool& findAnotherHelix);
+    bool         tripletPairTooFar         (const triplet& trip);
+    bool         tripletOutOfPtWindow      (const triplet& trip, float& area);
+    void         stopTripletTiming         ();
     bool         passesFlags               (size_t tcHitsIndex);
     void         setTripletI               (size_t tcHitsIndex, triplet& trip, LoopCondition& outcome);
     void         setTripletJ               (size_t tcHitsIndex, triplet& trip, LoopCondition& outcome);
@@ -309,7 +336,16 @@ namespace mu2e {
     _maxHelixMomentum              (config().maxHelixMomentum()                      ),
     _chi2LineSaveThresh            (config().chi2LineSaveThresh()                    ),
     _maxEDepAvg                    (config().maxEDepAvg()                            ),
-    _tzSlopeSigThresh              (config().tzSlopeSigThresh()                      )
+    _tzSlopeSigThresh              (config().tzSlopeSigThresh()                      ),
+    _rankTriplets                  (config().rankTriplets()                          ),
+    _maxTripletsPerCluster         (config().maxTripletsPerCluster()                 ),
+    _pruneTriplets                 (config().pruneTriplets()                         ),
+    _nTripletsInCluster            (0                                                ),
+    _nTripletsPruned               (0                                                ),
+    _nTripletsTried                (0                                                ),
+    _nTruncatedClusters            (0                                                ),
+    _nEvents                       (0                                                ),
+    _nHelices                      (0                                                )
   {
     // to cache the evaluations
     _minTripletDistSq = _minTripletDist * _minTripletDist;
@@ -324,6 +360,9 @@ namespace mu2e {
     // reserve a reasonable amount of space for future hit collections
     _tcHits.reserve(200);
 
+    // triplets are not pruned with diagnostics on, so all of them are histogrammed
+    if (_diagLevel > 0) _pruneTriplets = false;
+
       // convert the helix direction names into enums
     for(auto helix_dir : config().validHelixDirections()) {
       _validHelixDirections.push_back(TrkFitDirection::fitDirectionFromName(helix_dir));
@@ -382,6 +421,12 @@ namespace mu2e {
     _bz0Conv = _bz0 * _mmTconversion;
     _bz0ConvSq = _bz0Conv * _bz0Conv;
 
+    // circle radius window of the triplets, with a margin so that only triplets the
+    // circle fit in initTriplet would reject are pruned
+    _minTripletRadius = 0.99 * _minHelixPerpMomentum / std::fabs(_bz0Conv);
+    _maxTripletRadius = 1.01 * _maxHelixPerpMomentum / std::fabs(_bz0Conv);
+    _maxTripletPairDistSq = 4. * _maxTripletRadius * _maxTripletRadius;
+
     // Offset for calo cluster z positions
     double offset = _calorimeter->caloInfo().getDouble("diskCaseZLength");
     offset += _calorimeter->caloInfo().getDouble("BPPipeZOffset");
@@ -466,6 +511,7 @@ namespace mu2e {
         }
         const int nHelicesInitial = _diagInfo.nHelices; // Only valid if diagLevel > 0, for diagnostic tracking
         tcHitsFill(i); // Initialize the list of hits in the time cluster
+        _nTripletsInCluster = 0;
         while(findHelix(i, *hsColl) && _findMultipleHelices); // Exit the search if no helix is found or after finding a helix if not configured for multi-helix reco
 
         if (_diagLevel > 0) {
@@ -490,6 +536,9 @@ namespace mu2e {
       _hmanager->fillHistograms(&_diagInfo, DIAG::kEnd);
     }
 
+    _nEvents++;
+    _nHelices += hsColl->size();
+
     // put helix seed collection into the event record
     if(_doTiming) _watch->Increment("output");
     event.put(std::move(hsColl));
@@ -502,6 +551,10 @@ namespace mu2e {
   // endJob
   //-----------------------------------------------------------------------------
   void AgnosticHelixFinder::endJob() {
+    if(_doTiming || _diagLevel > 0) {
+      printf("[AgnosticHelixFinder::%s] events: %li helices: %li, triplets tried: %li pruned: %li, time clusters truncated: %li\n",
+             __func__, _nEvents, _nHelices, _nTripletsTried, _nTripletsPruned, _nTruncatedClusters);
+    }
     if(_doTiming) {
       for(int itest = 0; itest < 100000; ++itest) _watch->Increment("AAA-TimeTest"); // put at the top a reference for timing impacts
       _watch->StopTime("AAA-TimeTest");
@@ -766,6 +819,7 @@ namespace mu2e {
     // now we loop over triplets
     LoopCondition loopCondition;
     triplet tripletInfo;
+    bool findAnotherHelix = false;
     for (size_t i = 0; i < _tcHits.size() - 2; i++) {
       if(_doTiming > 1) _watch->Increment("triplet-i");
       if(_doTiming > 2) _watch->StopTime ("triplet-j");
@@ -773,89 +827,167 @@ namespace mu2e {
       setTripletI(i, tripletInfo, loopCondition);
       if (loopCondition == CONTINUE) { continue; }
       if (loopCondition == BREAK) { break; }
+      _rankedTriplets.clear();
       for (size_t j = i + 1; j < _tcHits.size() - 1; j++) {
         if(_doTiming > 2) _watch->Increment("triplet-j");
         if(_doTiming > 3) _watch->StopTime ("triplet-k");
         setTripletJ(j, tripletInfo, loopCondition);
         if (loopCondition == CONTINUE) { continue; }
         if (loopCondition == BREAK) { break; }
+        if (_pruneTriplets && tripletPairTooFar(tripletInfo)) { continue; }
         for (size_t k = j + 1; k < _tcHits.size(); k++) {
           if(_doTiming > 3) _watch->Increment("triplet-k");
           setTripletK(k, tripletInfo, loopCondition);
           if (loopCondition == CONTINUE) { continue; }
           if (loopCondition == BREAK) { break; }
-          // clear fitters for new triplet then initialize triplet
-          _circleFitter.clear();
-          _lineFitter.clear();
-          initTriplet(tripletInfo, loopCondition);
-          // now initialize seed circle if triplet circle passed condition check
-          if (loopCondition == CONTINUE) { continue; }
-          initSeedCircle(loopCondition);
-          if (loopCondition == CONTINUE) { continue; }
-          uselessSeed = false;
-          initHelixPhi();
-          findSeedPhiLines(loopCondition);
-          if (loopCondition == CONTINUE) { continue; }
-          resolve2PiAmbiguities();
-          // refine the seed phi lines by removing the worst hits
-          for (size_t ii = 0; ii < _seedPhiLines.size(); ii++) {
-            if ((int)_seedPhiLines[ii].tcHitsIndices.size() < _minFinalSeedHits) { continue; }
-            while (refinePhiLine(ii)); // while refinements are still made, keep going
+          float area = 0.f;
+          if (_pruneTriplets && tripletOutOfPtWindow(tripletInfo, area)) {
+            ++_nTripletsPruned;
+            continue;
           }
-          initFinalSeed(loopCondition);
-          if (loopCondition == CONTINUE) { continue; }
-          while (recoverPoints()); // while points are recovered, keep trying to recover
-          checkHelixViability(loopCondition);
-          if (loopCondition == CONTINUE) { continue; }
-          // before saving helix we make sure it has enough hits
-          int nStrawHitsInHelix = 0;
-          int nComboHitsInHelix = 0;
-          int nStrawHitsInTimeCluster = 0;
-          int nComboHitsInTimeCluster = 0;
-          // compute number of usable hits in time cluster, and number of hits in candidate helix
-          for (size_t q = 0; q < _tcHits.size(); q++) {
-            if (_tcHits[q].inHelix == true || _tcHits[q].hitIndice == HitType::STOPPINGTARGET
-                || _tcHits[q].hitIndice == HitType::CALOCLUSTER) { continue; }
-            const auto& tcHit = _tcHits[q];
-            const int nStrawHitsInHit = tcHit.hit->nStrawHits();
-            nStrawHitsInTimeCluster += nStrawHitsInHit;
-            ++nComboHitsInTimeCluster;
-            if (tcHit.used == false) { continue; }
-            nStrawHitsInHelix += nStrawHitsInHit;
-            ++nComboHitsInHelix;
+          if (_rankTriplets) { // try them once all triplets of this seed hit are known
+            _rankedTriplets.push_back(tripletCandidate{tripletInfo, area});
+            continue;
+          }
+          if (_maxTripletsPerCluster > 0 && _nTripletsInCluster >= _maxTripletsPerCluster) {
+            ++_nTruncatedClusters;
+            stopTripletTiming();
+            return false;
           }
-          if (nStrawHitsInHelix >= _minNHelixStrawHits && nComboHitsInHelix >= _minNHelixComboHits) {
-            saveHelix(tc, HSColl);
-            if (_diagLevel > 0) { _diagInfo.nHelices++; }
-            // we only want to search for another helix if we have enough remaining hits after saving helix
-            const int remainingStrawHits = nStrawHitsInTimeCluster - nStrawHitsInHelix;
-            const int remainingComboHits = nComboHitsInTimeCluster - nComboHitsInHelix;
-            const bool findAnotherHelix = remainingStrawHits >= _minNHelixStrawHits && remainingComboHits >= _minNHelixComboHits;
-            if(findAnotherHelix && _doAverageFlag) resetFlags(); // reset flags if needed
-
-            // Helix found, so we can exit this search
-            if(_doTiming > 0) _watch->StopTime(__func__);
-            if(_doTiming > 1) _watch->StopTime("triplet-i");
-            if(_doTiming > 2) _watch->StopTime("triplet-j");
-            if(_doTiming > 3) _watch->StopTime("triplet-k");
+          if (tryTriplet(tc, HSColl, tripletInfo, uselessSeed, findAnotherHelix)) {
+            stopTripletTiming();
             return findAnotherHelix;
-          } else if(_diagLevel > 4) {
-            printf("Helix hits: Failed with %i straw hits (%i combo hits)\n", nStrawHitsInHelix, nComboHitsInHelix);
           }
         } // end triplet k loop
       } // end triplet j loop
+
+      // the triplets of a seed hit with the largest triangle area, which have
+      // the best constrained circles, are tried first
+      if (_rankTriplets) {
+        std::stable_sort(_rankedTriplets.begin(), _rankedTriplets.end(),
+                         [](const tripletCandidate& a, const tripletCandidate& b) { return a.score > b.score; });
+        for (const auto& candidate : _rankedTriplets) {
+          if (_maxTripletsPerCluster > 0 && _nTripletsInCluster >= _maxTripletsPerCluster) {
+            ++_nTruncatedClusters;
+            stopTripletTiming();
+            return false;
+          }
+          if (tryTriplet(tc, HSColl, candidate.trip, uselessSeed, findAnotherHelix)) {
+            stopTripletTiming();
+            return findAnotherHelix;
+          }
+        }
+      }
       _tcHits[i].uselessTripletSeed = uselessSeed;
     } // end triplet i loop
 
-    if(_doTiming > 0) _watch->StopTime(__func__);
-    if(_doTiming > 1) _watch->StopTime("triplet-i");
-    if(_doTiming > 2) _watch->StopTime("triplet-j");
-    if(_doTiming > 3) _watch->StopTime("triplet-k");
+    stopTripletTiming();
 
     // No helix found, no need to continue searching in this time cluster
     return false;
   }
 
+  //-----------------------------------------------------------------------------
+  // search for a helix starting from one triplet, return true if a helix was saved
+  //-----------------------------------------------------------------------------
+  bool AgnosticHelixFinder::tryTriplet(size_t tc, HelixSeedCollection& HSColl, const triplet& trip,
+                                       bool& uselessSeed, bool& findAnotherHelix) {
+    ++_nTripletsInCluster;
+    ++_nTripletsTried;
+
+    // clear fitters for new triplet then initialize triplet
+    LoopCondition loopCondition;
+    _circleFitter.clear();
+    _lineFitter.clear();
+    initTriplet(trip, loopCondition);
+    // now initialize seed circle if triplet circle passed condition check
+    if (loopCondition == CONTINUE) { return false; }
+    initSeedCircle(loopCondition);
+    if (loopCondition == CONTINUE) { return false; }
+    uselessSeed = false;
+    initHelixPhi();
+    findSeedPhiLines(loopCondition);
+    if (loopCondition == CONTINUE) { return false; }
+    resolve2PiAmbiguities();
+    // refine the seed phi lines by removing the worst hits
+    for (size_t ii = 0; ii < _seedPhiLines.size(); ii++) {
+      if ((int)_seedPhiLines[ii].tcHitsIndices.size() < _minFinalSeedHits) { continue; }
+      while (refinePhiLine(ii)); // while refinements are still made, keep going
+    }
+    initFinalSeed(loopCondition);
+    if (loopCondition == CONTINUE) { return false; }
+    while (recoverPoints()); // while points are recovered, keep trying to recover
+    checkHelixViability(loopCondition);
+    if (loopCondition == CONTINUE) { return false; }
+    // before saving helix we make sure it has enough hits
+    int nStrawHitsInHelix = 0;
+    int nComboHitsInHelix = 0;
+    int nStrawHitsInTimeCluster = 0;
+    int nComboHitsInTimeCluster = 0;
+    // compute number of usable hits in time cluster, and number of hits in candidate helix
+    for (size_t q = 0; q < _tcHits.size(); q++) {
+      if (_tcHits[q].inHelix == true || _tcHits[q].hitIndice == HitType::STOPPINGTARGET
+          || _tcHits[q].hitIndice == HitType::CALOCLUSTER) { continue; }
+      const auto& tcHit = _tcHits[q];
+      const int nStrawHitsInHit = tcHit.hit->nStrawHits();
+      nStrawHitsInTimeCluster += nStrawHitsInHit;
+      ++nComboHitsInTimeCluster;
+      if (tcHit.used == false) { continue; }
+      nStrawHitsInHelix += nStrawHitsInHit;
+      ++nComboHitsInHelix;
+    }
+    if (nStrawHitsInHelix >= _minNHelixStrawHits && nComboHitsInHelix >= _minNHelixComboHits) {
+      saveHelix(tc, HSColl);
+      if (_diagLevel > 0) { _diagInfo.nHelices++; }
+      // we only want to search for another helix if we have enough remaining hits after saving helix
+      const int remainingStrawHits = nStrawHitsInTimeCluster - nStrawHitsInHelix;
+      const int remainingComboHits = nComboHitsInTimeCluster - nComboHitsInHelix;
+      findAnotherHelix = remainingStrawHits >= _minNHelixStrawHits && remainingComboHits >= _minNHelixComboHits;
+      if(findAnotherHelix && _doAverageFlag) resetFlags(); // reset flags if needed
+
+      // Helix found, so we can exit this search
+      return true;
+    } else if(_diagLevel > 4) {
+      printf("Helix hits: Failed with %i straw hits (%i combo hits)\n", nStrawHitsInHelix, nComboHitsInHelix);
+    }
+    return false;
+  }
+
+  //-----------------------------------------------------------------------------
+  // no circle in the pt window goes through two points farther apart than its diameter
+  //-----------------------------------------------------------------------------
+  bool AgnosticHelixFinder::tripletPairTooFar(const triplet& trip) {
+    const float dx = trip.i.pos.x() - trip.j.pos.x();
+    const float dy = trip.i.pos.y() - trip.j.pos.y();
+    return dx*dx + dy*dy > _maxTripletPairDistSq;
+  }
+
+  //-----------------------------------------------------------------------------
+  // circumradius R = abc/(4*area) of the triplet, compared to the pt window.
+  // Nearly collinear triplets are left to the circle fit
+  //-----------------------------------------------------------------------------
+  bool AgnosticHelixFinder::tripletOutOfPtWindow(const triplet& trip, float& area) {
+    const float xji = trip.j.pos.x() - trip.i.pos.x(), yji = trip.j.pos.y() - trip.i.pos.y();
+    const float xki = trip.k.pos.x() - trip.i.pos.x(), yki = trip.k.pos.y() - trip.i.pos.y();
+    const float xkj = trip.k.pos.x() - trip.j.pos.x(), ykj = trip.k.pos.y() - trip.j.pos.y();
+    const float dik2 = xki*xki + yki*yki;
+    const float djk2 = xkj*xkj + ykj*ykj;
+    if (dik2 > _maxTripletPairDistSq || djk2 > _maxTripletPairDistSq) { return true; }
+
+    area = 0.5f*std::fabs(xji*yki - yji*xki);
+    if (area < 1.f) { return false; } // mm^2
+    const float radius = std::sqrt((xji*xji + yji*yji)*dik2*djk2)/(4.f*area);
+    return radius < _minTripletRadius || radius > _maxTripletRadius;
+  }
+
+  //-----------------------------------------------------------------------------
+  void AgnosticHelixFinder::stopTripletTiming() {
+    if(_doTiming > 0) _watch->StopTime("findHelix");
+    if(_doTiming > 1) _watch->StopTime("triplet-i");
+    if(_doTiming > 2) _watch->StopTime("triplet-j");
+    if(_doTiming > 3) _watch->StopTime("triplet-k");
+  }
+
   //-----------------------------------------------------------------------------
   // check flags to see if point is good for triplet-ing with
   //-----------------------------------------------------------------------------
@@ -44,12 +44,22 @@ namespace mu2e {
     _testOrder             (config().testOrder()        ),
     _testHitMask           (config().testHitMask()      ),
     _goodHitMask           (config().goodHitMask()      ),
-    _bkgHitMask            (config().bkgHitMask()       )
+    _bkgHitMask            (config().bkgHitMask()       ),
+    _nStationThreads       (config().nStationThreads()  )
   {
 
     _data    = Data;
     _doTiming = _data->doTiming;
     _watch = _data->watch;
+//-----------------------------------------------------------------------------
+// the stop watch is not thread safe, so there is no timing inside the
+// per-station steps when they run in parallel
+//-----------------------------------------------------------------------------
+    _stationTiming = _doTiming;
+    if (_nStationThreads > 0) {
+      _arena = std::make_unique<tbb::task_arena>(_nStationThreads);
+      _stationTiming = 0;
+    }
 
   }
 //-----------------------------------------------------------------------------
@@ -78,7 +88,7 @@ namespace mu2e {
 // try to add more close hits to it (one hit per face)
 //-----------------------------------------------------------------------------
   void DeltaFinderAlg::completeSeed(DeltaSeed* Seed) {
-    if(_doTiming > 3) _watch->SetTime(__func__);
+    if(_stationTiming > 3) _watch->SetTime(__func__);
 //-----------------------------------------------------------------------------
 // loop over remaining faces, 'f2' - face in question
 // the time bins are 40 ns wide, only need to loop over hits in 3 of them
@@ -209,7 +219,7 @@ namespace mu2e {
       HitData_t* hd = Seed->HitData(face);
       if (hd) hd->fUsed = Seed->nHits();
     }
-    if(_doTiming > 3) _watch->StopTime(__func__);
+    if(_stationTiming > 3) _watch->StopTime(__func__);
   }
 
 //-----------------------------------------------------------------------------
@@ -217,7 +227,7 @@ namespace mu2e {
 // do not consider proton hits with eDep > _minHtEnergy
 //-----------------------------------------------------------------------------
   void DeltaFinderAlg::findSeeds(int Station, int Face) {
-    if(_doTiming > 1) _watch->SetTime("findSeeds(s,f)");
+    if(_stationTiming > 1) _watch->SetTime("findSeeds(s,f)");
     float sigma_dt_2(64);  // 8 ns^2
 
     FaceZ_t* fz1 = _data->faceData(Station,Face);
@@ -232,7 +242,7 @@ namespace mu2e {
 //-----------------------------------------------------------------------------
       HitData_t*      hd1 = &fz1->fHitData[h1];
       if (hd1->Used() >= 3)                                           continue;
-      if(_doTiming > 2) _watch->Increment("findSeeds-per-hd");
+      if(_stationTiming > 2) _watch->Increment("findSeeds-per-hd");
 
       float  wx1 = hd1->fWx;
       float  wy1 = hd1->fWy;
@@ -395,25 +405,32 @@ namespace mu2e {
         if (seed_found >= 3) break;
       }
     }
-    if(_doTiming > 2) _watch->StopTime("findSeeds-per-hd");
-    if(_doTiming > 1) _watch->StopTime("findSeeds(s,f)");
+    if(_stationTiming > 2) _watch->StopTime("findSeeds-per-hd");
+    if(_stationTiming > 1) _watch->StopTime("findSeeds(s,f)");
   }
 
 //-----------------------------------------------------------------------------
 // TODO: update the time as more hits are added
 //-----------------------------------------------------------------------------
-  void DeltaFinderAlg::findSeeds() {
-    if(_doTiming > 0) _watch->SetTime(__func__);
-
-    for (int s=0; s<kNStations; ++s) {
-      for (int face=0; face<kNFaces-1; face++) {
+  void DeltaFinderAlg::findSeeds(int Station) {
+    for (int face=0; face<kNFaces-1; face++) {
 //-----------------------------------------------------------------------------
-// find seeds starting from 'face' in a given station 's'
+// find seeds starting from 'face' in a given station
 //-----------------------------------------------------------------------------
-        findSeeds(s,face);
-      }
-      pruneSeeds(s);
+      findSeeds(Station,face);
     }
+    pruneSeeds(Station);
+  }
+
+//-----------------------------------------------------------------------------
+// the seed search only uses the hits, face data and seed lists of one station,
+// so the stations can be processed in parallel, with the same result
+//-----------------------------------------------------------------------------
+  void DeltaFinderAlg::findSeeds() {
+    if(_doTiming > 0) _watch->SetTime(__func__);
+
+    forEachStation([this](int Station) { findSeeds(Station); });
+
     if(_doTiming > 0) _watch->StopTime(__func__);
   }
 
@@ -767,7 +784,7 @@ namespace mu2e {
 // also reject seeds with Chi2Tot > _maxChi2Tot=10
 //-----------------------------------------------------------------------------
   void DeltaFinderAlg::pruneSeeds(int Station) {
-    if(_doTiming > 1) _watch->SetTime(__func__);
+    if(_stationTiming > 1) _watch->SetTime(__func__);
 
     int nseeds =  _data->NSeeds(Station);
 
@@ -878,7 +895,7 @@ namespace mu2e {
         }
       }
     }
-    if(_doTiming > 1) _watch->StopTime(__func__);
+    if(_stationTiming > 1) _watch->StopTime(__func__);
   }
 
 //------------------------------------------------------------------------------
@@ -451,33 +451,39 @@ namespace mu2e {
     return 0;
   }
 
+//-----------------------------------------------------------------------------
+// proton hits of different stations are independent, can be done in parallel
 //-----------------------------------------------------------------------------
   int  DeltaFinderAlg::prepareProtonHits() {
 
-    for (int is=0; is<kNStations; is++) {
-      for (int face=0; face<kNFaces; face++) {
-        FaceZ_t* fz = _data->faceData(is,face);
-        int nh = fz->nHits();
-        for (int ih=0; ih<nh; ih++) {
-          HitData_t* hd = fz->hitData(ih);
+    forEachStation([this](int Station) { prepareProtonHits(Station); });
+
+    return 0;
+  }
+
+//-----------------------------------------------------------------------------
+  void DeltaFinderAlg::prepareProtonHits(int Station) {
+
+    for (int face=0; face<kNFaces; face++) {
+      FaceZ_t* fz = _data->faceData(Station,face);
+      int nh = fz->nHits();
+      for (int ih=0; ih<nh; ih++) {
+        HitData_t* hd = fz->hitData(ih);
 //-----------------------------------------------------------------------------
 // require hit to have EDep consistent with 95+% of the protons and not to
 // be a part of a reconstructed delta electron candidate
 // this should significantly reduce the number of candidate hits to consider
 //-----------------------------------------------------------------------------
-          if ((hd->fHit->energyDep() > _minProtonHitEDep) and (hd->fDeltaIndex < 0)) {
+        if ((hd->fHit->energyDep() > _minProtonHitEDep) and (hd->fDeltaIndex < 0)) {
 
-            fz->fProtonHitData.push_back(hd);
+          fz->fProtonHitData.push_back(hd);
 
-            // int nph = fz->nProtonHits();
-            // int tbin = int (hd->fHit->time()/_timeBin) ;
-            // if (fz->fPFirst[tbin] < 0) fz->fPFirst[tbin] = nph;
-            // fz->fPLast[tbin] = nph;
-          }
+          // int nph = fz->nProtonHits();
+          // int tbin = int (hd->fHit->time()/_timeBin) ;
+          // if (fz->fPFirst[tbin] < 0) fz->fPFirst[tbin] = nph;
+          // fz->fPLast[tbin] = nph;
         }
       }
     }
-
-    return 0;
   }
 }
@@ -0,0 +1,123 @@
+///////////////////////////////////////////////////////////////////////////////
+// Compare the outputs of two DeltaFinder instances run on the same hits, for
+// example the serial one and one with finderParameters.nStationThreads > 0:
+// the hit flags, the single straw hit flags and the delta candidate time
+// clusters must be identical.  The differences are counted per event, and
+// the job throws at the end if there were any.
+///////////////////////////////////////////////////////////////////////////////
+#include "art/Framework/Core/EDAnalyzer.h"
+#include "art/Framework/Principal/Event.h"
+#include "cetlib_except/exception.h"
+#include "fhiclcpp/types/Atom.h"
+
+#include "Offline/RecoDataProducts/inc/ComboHit.hh"
+#include "Offline/RecoDataProducts/inc/TimeCluster.hh"
+
+#include <algorithm>
+#include <iostream>
+#include <string>
+
+namespace mu2e {
+
+  class DeltaFinderCompare : public art::EDAnalyzer {
+  public:
+    struct Config {
+      using Name    = fhicl::Name;
+      using Comment = fhicl::Comment;
+      fhicl::Atom<std::string> refLabel  {Name("refLabel" ), Comment("label of the reference DeltaFinder")};
+      fhicl::Atom<std::string> testLabel {Name("testLabel"), Comment("label of the DeltaFinder to compare")};
+      fhicl::Atom<bool>        strawHits {Name("strawHits"), Comment("also compare the single straw hits"), true};
+    };
+    using Parameters = art::EDAnalyzer::Table<Config>;
+
+    explicit DeltaFinderCompare(const Parameters& conf);
+    void analyze(const art::Event& event) override;
+    void endJob() override;
+
+  private:
+    int compareHits    (ComboHitCollection const& Ref, ComboHitCollection const& Test) const;
+    int compareClusters(TimeClusterCollection const& Ref, TimeClusterCollection const& Test) const;
+
+    std::string _refLabel;
+    std::string _testLabel;
+    bool        _strawHits;
+    int         _nEvents;
+    int         _nBadEvents;
+  };
+
+//-----------------------------------------------------------------------------
+  DeltaFinderCompare::DeltaFinderCompare(const Parameters& conf) :
+    art::EDAnalyzer(conf),
+    _refLabel  (conf().refLabel() ),
+    _testLabel (conf().testLabel()),
+    _strawHits (conf().strawHits()),
+    _nEvents   (0),
+    _nBadEvents(0)
+  {
+    for (auto const& label : {_refLabel, _testLabel}) {
+      consumes<ComboHitCollection>(art::InputTag(label));
+      consumes<TimeClusterCollection>(art::InputTag(label));
+      if (_strawHits) consumes<ComboHitCollection>(art::InputTag(label,"StrawHits"));
+    }
+  }
+
+//-----------------------------------------------------------------------------
+// number of hits that differ in flag, straw or constituents
+//-----------------------------------------------------------------------------
+  int DeltaFinderCompare::compareHits(ComboHitCollection const& Ref, ComboHitCollection const& Test) const {
+    if (Ref.size() != Test.size()) return int(std::max(Ref.size(),Test.size()));
+    int ndiff(0);
+    for (size_t i=0; i<Ref.size(); i++) {
+      ComboHit const& r = Ref[i];
+      ComboHit const& t = Test[i];
+      if (!(r.flag() == t.flag()) || r.strawId() != t.strawId() || r.nCombo() != t.nCombo() ||
+          r.indexArray() != t.indexArray()) ndiff++;
+    }
+    return ndiff;
+  }
+
+//-----------------------------------------------------------------------------
+// number of time clusters that differ in hits or t0
+//-----------------------------------------------------------------------------
+  int DeltaFinderCompare::compareClusters(TimeClusterCollection const& Ref, TimeClusterCollection const& Test) const {
+    if (Ref.size() != Test.size()) return int(std::max(Ref.size(),Test.size()));
+    int ndiff(0);
+    for (size_t i=0; i<Ref.size(); i++) {
+      TimeCluster const& r = Ref[i];
+      TimeCluster const& t = Test[i];
+      if (r.hits() != t.hits() || r.t0().t0() != t.t0().t0() || r.t0().t0Err() != t.t0().t0Err()) ndiff++;
+    }
+    return ndiff;
+  }
+
+//-----------------------------------------------------------------------------
+  void DeltaFinderCompare::analyze(const art::Event& event) {
+    _nEvents++;
+    int nhits = compareHits(*event.getValidHandle<ComboHitCollection>(art::InputTag(_refLabel)),
+                            *event.getValidHandle<ComboHitCollection>(art::InputTag(_testLabel)));
+    int nsh(0);
+    if (_strawHits) {
+      nsh = compareHits(*event.getValidHandle<ComboHitCollection>(art::InputTag(_refLabel,"StrawHits")),
+                        *event.getValidHandle<ComboHitCollection>(art::InputTag(_testLabel,"StrawHits")));
+    }
+    int ntc = compareClusters(*event.getValidHandle<TimeClusterCollection>(art::InputTag(_refLabel)),
+                              *event.getValidHandle<TimeClusterCollection>(art::InputTag(_testLabel)));
+    if (nhits+nsh+ntc > 0) {
+      _nBadEvents++;
+      std::cout << "DeltaFinderCompare: event " << event.id() << " " << _testLabel << " differs from " << _refLabel
+                << ": " << nhits << " combo hits, " << nsh << " straw hits, " << ntc << " time clusters" << std::endl;
+    }
+  }
+
+//-----------------------------------------------------------------------------
+  void DeltaFinderCompare::endJob() {
+    std::cout << "DeltaFinderCompare: " << _nBadEvents << " of " << _nEvents << " events differ between "
+              << _refLabel << " and " << _testLabel << std::endl;
+    if (_nBadEvents > 0) {
+      throw cet::exception("DELTAFINDER_COMPARE") << _nBadEvents << " events with different "
+                                                   << _refLabel << " and " << _testLabel << " output\n";
+    }
+  }
+}
+
+DEFINE_ART_MODULE(mu2e::DeltaFinderCompare)
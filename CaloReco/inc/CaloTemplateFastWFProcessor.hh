@@ -0,0 +1,98 @@
+#ifndef CaloTemplateFastWFProcessor_HH
+#define CaloTemplateFastWFProcessor_HH
+
+// Fast version of the waveform template fit, for waveforms with a single pulse.
+//
+// The pulse template and its time derivative are tabulated once at initialization. A waveform
+// with a single primary peak is fitted with a Gauss-Newton solve of the amplitude and peak time,
+// the baseline having a closed form solution for the modified chi2 used by the template fit
+// (see CaloTemplateWFUtil). All work arrays are members reused from one waveform to the next.
+//
+// Waveforms with several peaks, a secondary peak in the fit residuals, a bad chi2 or a fit that
+// does not converge are passed to CaloTemplateWFProcessor, which uses minuit.
+//
+
+#include "Offline/CaloReco/inc/CaloWaveformProcessor.hh"
+#include "Offline/CaloReco/inc/CaloTemplateWFProcessor.hh"
+#include "Offline/Mu2eUtilities/inc/CaloPulseShape.hh"
+#include <array>
+#include <vector>
+
+
+
+namespace mu2e {
+
+  class CaloTemplateFastWFProcessor : public CaloWaveformProcessor
+  {
+     public:
+        using Config = CaloTemplateWFProcessor::Config;
+
+        CaloTemplateFastWFProcessor(const Config& config);
+
+        virtual void     initialize  () override;
+        virtual void     reset       () override;
+        virtual void     extract     (const std::vector<double>& xInput, const std::vector<double>& yInput) override;
+        virtual void     plot        (const std::string& pname) const override;
+
+        virtual int      nPeaks      ()               const override {return resAmp_.size();}
+        virtual double   chi2        ()               const override {return chi2_;}
+        virtual int      ndf         ()               const override {return ndf_;}
+        virtual double   amplitude   (unsigned int i) const override {return resAmp_.at(i);}
+        virtual double   amplitudeErr(unsigned int i) const override {return resAmpErr_.at(i);}
+        virtual double   time        (unsigned int i) const override {return resTime_.at(i);}
+        virtual double   timeErr     (unsigned int i) const override {return resTimeErr_.at(i);}
+        virtual bool     isPileUp    (unsigned int i) const override {return i > 1;}
+
+        bool             usedFallback()               const {return usedFallback_;}
+        unsigned long    nFastFits   ()               const {return nFast_;}
+        unsigned long    nFallbackFits()              const {return nFallback_;}
+
+
+    private:
+       struct SinglePulseFit
+       {
+          double                          baseline  = 0;
+          double                          amplitude = 0;
+          double                          peakTime  = 0;
+          double                          chi2      = 0;
+          std::array<double,9>            cov       {};   // covariance of (baseline, amplitude, peak time)
+       };
+
+       bool   fastExtract      (const std::vector<double>& xvec, const std::vector<double>& yvec);
+       bool   fitSinglePulse   (const std::vector<double>& xvec, const std::vector<double>& yvec, unsigned i0, unsigned i1, SinglePulseFit& fit);
+       void   evalTemplate     (double dt, double& value, double& slope) const;
+       bool   isLocalPeak      (const std::vector<double>& ywork, unsigned i) const;
+       void   useFallback      (const std::vector<double>& xvec, const std::vector<double>& yvec);
+
+       unsigned                 windowPeak_ ;
+       double                   minPeakAmplitude_;
+       unsigned                 numNoiseBins_;
+       double                   minDTPeaks_;
+       double                   psdThreshold_;
+       double                   chiThreshold_;
+       bool                     refitLeadingEdge_;
+       int                      diagLevel_;
+       CaloPulseShape           pulse_;
+       CaloTemplateWFProcessor  fallback_;
+
+       double                   tabMin_;
+       double                   tabStep_;
+       std::vector<double>      tabValue_;
+       std::vector<double>      tabSlope_;
+       std::vector<double>      ywork_;
+       std::vector<double>      fvals_;
+       std::vector<double>      dvals_;
+
+       double                   chi2_;
+       int                      ndf_;
+       std::vector<double>      resAmp_;
+       std::vector<double>      resAmpErr_;
+       std::vector<double>      resTime_;
+       std::vector<double>      resTimeErr_;
+       bool                     usedFallback_;
+       unsigned long            nFast_;
+       unsigned long            nFallback_;
+  };
+
+}
+#endif
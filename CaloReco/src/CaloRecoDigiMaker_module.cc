@@ -8,6 +8,7 @@
 
 #include "Offline/CaloConditions/inc/CalCalib.hh"
 #include "Offline/CaloReco/inc/CaloRawWFProcessor.hh"
+#include "Offline/CaloReco/inc/CaloTemplateFastWFProcessor.hh"
 #include "Offline/CaloReco/inc/CaloTemplateWFProcessor.hh"
 #include "Offline/CaloReco/inc/CaloWaveformProcessor.hh"
 #include "Offline/DAQConditions/inc/EventTiming.hh"
@@ -24,7 +25,7 @@ namespace mu2e {
 
 class CaloRecoDigiMaker : public art::EDProducer {
 public:
-  enum processorStrategy { NoChoice, RawExtract, Template };
+  enum processorStrategy { NoChoice, RawExtract, Template, TemplateFast };
 
   //clang-format off
   struct Config {
@@ -62,6 +63,7 @@ public:
     std::map<std::string, processorStrategy> spmap;
     spmap["RawExtract"] = RawExtract;
     spmap["TemplateFit"] = Template;
+    spmap["TemplateFastFit"] = TemplateFast;
 
     switch (spmap[processorStrategy_]) {
     case RawExtract: {
@@ -72,6 +74,10 @@ public:
       waveformProcessor_ = std::make_unique<CaloTemplateWFProcessor>(config().proc_templ_conf());
       break;
     }
+    case TemplateFast: {
+      waveformProcessor_ = std::make_unique<CaloTemplateFastWFProcessor>(config().proc_templ_conf());
+      break;
+    }
     default: {
       throw cet::exception("CATEGORY") << "Unrecognized processor in CaloHitsFromDigis module";
     }
@@ -0,0 +1,293 @@
+#include "Offline/CaloReco/inc/CaloTemplateFastWFProcessor.hh"
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <numeric>
+#include <string>
+#include <vector>
+
+
+namespace
+{
+   constexpr unsigned maxIterations  = 20;
+   constexpr double   timeTolerance  = 1e-4;   // ns
+   constexpr double   ampTolerance   = 1e-6;   // relative
+}
+
+
+namespace mu2e {
+
+   CaloTemplateFastWFProcessor::CaloTemplateFastWFProcessor(const Config& config) :
+      CaloWaveformProcessor(),
+      windowPeak_      (std::max(config.windowPeak(),1u)),
+      minPeakAmplitude_(config.minPeakAmplitude()),
+      numNoiseBins_    (config.numNoiseBins()),
+      minDTPeaks_      (config.minDTPeaks()),
+      psdThreshold_    (config.psdThreshold()),
+      chiThreshold_    (config.chiThreshold()),
+      refitLeadingEdge_(config.refitLeadingEdge()),
+      diagLevel_       (config.diagLevel()),
+      pulse_           (config.pulseFileName(),config.pulseHistName(),config.digiSampling()),
+      fallback_        (config),
+      tabMin_          (0),
+      tabStep_         (1),
+      tabValue_        (),
+      tabSlope_        (),
+      ywork_           (),
+      fvals_           (),
+      dvals_           (),
+      chi2_            (999.),
+      ndf_             (-1),
+      resAmp_          (),
+      resAmpErr_       (),
+      resTime_         (),
+      resTimeErr_      (),
+      usedFallback_    (false),
+      nFast_           (0),
+      nFallback_       (0)
+   {}
+
+
+   //---------------------------------------------------------------------------------------------------------------------------------------
+   // Tabulate the template and its derivative on the nodes of the pulse shape
+   void CaloTemplateFastWFProcessor::initialize()
+   {
+       fallback_.initialize();
+       pulse_.buildShapes();
+
+       tabMin_  = pulse_.minTimeDifference();
+       tabStep_ = pulse_.timeStep();
+       unsigned nTab = unsigned((pulse_.maxTimeDifference()-tabMin_)/tabStep_)+1;
+
+       tabValue_.resize(nTab);
+       tabSlope_.resize(nTab);
+       for (unsigned i=0;i<nTab;++i) tabValue_[i] = pulse_.evaluate(tabMin_+i*tabStep_);
+       for (unsigned i=0;i<nTab;++i)
+       {
+           unsigned il = (i>0) ? i-1 : i, ih = (i+1<nTab) ? i+1 : i;
+           tabSlope_[i] = (ih>il) ? (tabValue_[ih]-tabValue_[il])/((ih-il)*tabStep_) : 0.0;
+       }
+   }
+
+
+   //---------------------------------------------------------------------------------------------------------------------------------------
+   void CaloTemplateFastWFProcessor::reset()
+   {
+       resAmp_.clear(); resAmpErr_.clear(); resTime_.clear(); resTimeErr_.clear();
+       ndf_ = 0; chi2_ = 999; usedFallback_ = false;
+   }
+
+
+   //---------------------------------------------------------------------------------------------------------------------------------------
+   void CaloTemplateFastWFProcessor::extract(const std::vector<double>& xInput, const std::vector<double>& yInput)
+   {
+       reset();
+       if (fastExtract(xInput,yInput))
+       {
+          ++nFast_;
+          if (diagLevel_>2) std::cout<<"[CaloTemplateFastWFProcessor] single pulse fit, npeaks="<<resAmp_.size()<<std::endl;
+          return;
+       }
+
+       reset();
+       useFallback(xInput,yInput);
+       if (diagLevel_>2) std::cout<<"[CaloTemplateFastWFProcessor] minuit fit, npeaks="<<resAmp_.size()<<std::endl;
+   }
+
+
+   //---------------------------------------------------------------------------------------------------------------------------------------
+   // Returns false if the waveform must be fitted by the template processor
+   bool CaloTemplateFastWFProcessor::fastExtract(const std::vector<double>& xvec, const std::vector<double>& yvec)
+   {
+       const unsigned nbins = yvec.size();
+       if (windowPeak_ > nbins || nbins <= numNoiseBins_) return true;
+
+       //estimate the noise level with the first few bins, as the template processor does
+       float noise = std::accumulate(yvec.begin(),yvec.begin()+numNoiseBins_,0)/float(numNoiseBins_);
+       ywork_.assign(yvec.begin(),yvec.end());
+       for (auto& val : ywork_) val -= noise;
+
+       unsigned ipeak(0),npeak(0);
+       for (unsigned i=windowPeak_;i+windowPeak_<nbins;++i)
+       {
+           if (!isLocalPeak(ywork_,i)) continue;
+           ipeak = i;
+           if (++npeak > 1) return false;
+       }
+       if (npeak == 0) return false;
+
+       // start from the parabola through the maximum
+       SinglePulseFit fit;
+       double dx    = xvec[1]-xvec[0];
+       double denom = ywork_[ipeak-1]-2*ywork_[ipeak]+ywork_[ipeak+1];
+       double shift = (denom < 0) ? 0.5*(ywork_[ipeak-1]-ywork_[ipeak+1])/denom : 0.0;
+       fit.baseline  = noise;
+       fit.amplitude = ywork_[ipeak];
+       fit.peakTime  = xvec[ipeak] + std::clamp(shift,-0.5,0.5)*dx;
+       if (!fitSinglePulse(xvec,yvec,0,nbins,fit)) return false;
+       if (fit.amplitude < 1) return false;
+
+       ndf_  = nbins - 3;
+       chi2_ = fit.chi2;
+       if (ndf_ > 0 && chi2_/float(ndf_) > chiThreshold_) return false;
+
+       // look for secondary peaks in the residuals
+       for (unsigned j=0;j<nbins;++j)
+       {
+           double value,slope;
+           evalTemplate(xvec[j]-fit.peakTime,value,slope);
+           ywork_[j] = yvec[j] - fit.baseline - fit.amplitude*value;
+       }
+       for (unsigned i=windowPeak_;i+windowPeak_<nbins;++i)
+       {
+           if (!isLocalPeak(ywork_,i)) continue;
+           if (std::abs(fit.peakTime-xvec[i]) < minDTPeaks_) continue;
+           if (yvec[i]>0 && ywork_[i]/yvec[i] < psdThreshold_) continue;
+           return false;
+       }
+
+       double time(fit.peakTime), timeVar(fit.cov[8]);
+       if (refitLeadingEdge_)
+       {
+           unsigned imax(0),ilow(0);
+           while (imax+1<nbins && xvec[imax]<fit.peakTime) ++imax;
+           for (unsigned i=imax;i>0;--i) if ((yvec[i]-fit.baseline)/(yvec[imax]-fit.baseline)>0.1) ilow = i;
+           SinglePulseFit edgeFit(fit);
+           if (imax >= ilow+4 && fitSinglePulse(xvec,yvec,0,imax,edgeFit))
+           {
+               time    = edgeFit.peakTime;
+               timeVar = edgeFit.cov[8];
+           }
+       }
+
+       if (time > xvec.back()) return true;
+       resAmp_.push_back(fit.amplitude);
+       //modified estimate for the uncertainty, see note in CaloTemplateWFUtil
+       resAmpErr_.push_back(std::sqrt(fit.cov[4]+fit.amplitude));
+       resTime_.push_back(pulse_.fromPeakToT0(time));
+       resTimeErr_.push_back(std::sqrt(timeVar));
+
+       return true;
+   }
+
+
+   //---------------------------------------------------------------------------------------------------------------------------------------
+   // Minimize sum_i (y_i-b-A*f(x_i-t))^2/b over the bins [i0,i1), the chi2 definition of the template fit.
+   // For fixed A and t the baseline is b^2 = sum_i (y_i-A*f(x_i-t))^2 / n; A and t are updated with a
+   // Gauss-Newton step for the current baseline. At the minimum, the covariance is b*(J^T J)^-1, with J
+   // the derivatives of the model with respect to (b,A,t).
+   bool CaloTemplateFastWFProcessor::fitSinglePulse(const std::vector<double>& xvec, const std::vector<double>& yvec,
+                                                    unsigned i0, unsigned i1, SinglePulseFit& fit)
+   {
+       const unsigned n = i1-i0;
+       if (n < 4) return false;
+       fvals_.resize(n);
+       dvals_.resize(n);
+
+       const double maxStep = xvec[i0+1]-xvec[i0];
+       double A(fit.amplitude), t(fit.peakTime), b(fit.baseline);
+       bool converged(false);
+       for (unsigned iter=0;iter<=maxIterations;++iter)
+       {
+           double see(0);
+           for (unsigned j=0;j<n;++j)
+           {
+               evalTemplate(xvec[i0+j]-t,fvals_[j],dvals_[j]);
+               double e = yvec[i0+j]-A*fvals_[j];
+               see += e*e;
+           }
+           b = std::sqrt(see/n);
+           if (!(b > 1e-5)) return false;
+           if (converged) break;
+           if (iter == maxIterations) return false;
+
+           double sff(0),sfd(0),sdd(0),gA(0),gt(0);
+           for (unsigned j=0;j<n;++j)
+           {
+               double r  = yvec[i0+j]-b-A*fvals_[j];
+               double jt = -A*dvals_[j];
+               sff += fvals_[j]*fvals_[j];
+               sfd += fvals_[j]*jt;
+               sdd += jt*jt;
+               gA  += fvals_[j]*r;
+               gt  += jt*r;
+           }
+           double det = sff*sdd-sfd*sfd;
+           if (!(det > 0)) return false;
+
+           double dA = (sdd*gA-sfd*gt)/det;
+           double dt = std::clamp((sff*gt-sfd*gA)/det,-maxStep,maxStep);
+           A += dA;
+           t += dt;
+           if (!(A > 0) || !std::isfinite(t)) return false;
+           converged = std::abs(dt) < timeTolerance && std::abs(dA) < ampTolerance*std::max(A,1.0);
+       }
+
+       // chi2 and covariance at the minimum
+       double s1(0),sf(0),sd(0),sff(0),sfd(0),sdd(0),chi2(0);
+       for (unsigned j=0;j<n;++j)
+       {
+           double f(fvals_[j]), d(-A*dvals_[j]), r(yvec[i0+j]-b-A*f);
+           s1 += 1; sf += f; sd += d; sff += f*f; sfd += f*d; sdd += d*d;
+           chi2 += r*r;
+       }
+       const double c00 = sff*sdd-sfd*sfd, c01 = sd*sfd-sf*sdd, c02 = sf*sfd-sd*sff;
+       const double c11 = s1*sdd-sd*sd,    c12 = sf*sd-s1*sfd,  c22 = s1*sff-sf*sf;
+       const double det = s1*c00+sf*c01+sd*c02;
+       if (!(det > 0)) return false;
+       const double scale = b/det;
+       fit.cov = {c00*scale,c01*scale,c02*scale, c01*scale,c11*scale,c12*scale, c02*scale,c12*scale,c22*scale};
+       if (!(fit.cov[4] >= 0) || !(fit.cov[8] >= 0)) return false;
+
+       fit.baseline  = b;
+       fit.amplitude = A;
+       fit.peakTime  = t;
+       fit.chi2      = chi2/b;
+       return true;
+   }
+
+
+   //---------------------------------------------------------------------------------------------------------------------------------------
+   void CaloTemplateFastWFProcessor::evalTemplate(double dt, double& value, double& slope) const
+   {
+       double u = (dt-tabMin_)/tabStep_;
+       if (!(u >= 0) || u >= tabValue_.size()-1) {value = slope = 0; return;}
+       unsigned k = unsigned(u);
+       double   w = u-k;
+       value = tabValue_[k] + w*(tabValue_[k+1]-tabValue_[k]);
+       slope = tabSlope_[k] + w*(tabSlope_[k+1]-tabSlope_[k]);
+   }
+
+   //---------------------------------------------------------------------------------------------------------------------------------------
+   bool CaloTemplateFastWFProcessor::isLocalPeak(const std::vector<double>& ywork, unsigned i) const
+   {
+       if (std::max_element(ywork.begin()+i-windowPeak_,ywork.begin()+i+windowPeak_+1) != ywork.begin()+i) return false;
+       return ywork[i-1] >= minPeakAmplitude_ && ywork[i] >= minPeakAmplitude_ && ywork[i+1] >= minPeakAmplitude_;
+   }
+
+   //---------------------------------------------------------------------------------------------------------------------------------------
+   void CaloTemplateFastWFProcessor::useFallback(const std::vector<double>& xvec, const std::vector<double>& yvec)
+   {
+       usedFallback_ = true;
+       ++nFallback_;
+       fallback_.extract(xvec,yvec);
+       for (int i=0;i<fallback_.nPeaks();++i)
+       {
+           resAmp_.push_back(fallback_.amplitude(i));
+           resAmpErr_.push_back(fallback_.amplitudeErr(i));
+           resTime_.push_back(fallback_.time(i));
+           resTimeErr_.push_back(fallback_.timeErr(i));
+       }
+       chi2_ = fallback_.chi2();
+       ndf_  = fallback_.ndf();
+   }
+
+   //---------------------------------------------------------------------------------------------------------------------------------------
+   void CaloTemplateFastWFProcessor::plot(const std::string& name) const
+   {
+       if (usedFallback_) fallback_.plot(name);
+       else if (diagLevel_>0) std::cout<<"[CaloTemplateFastWFProcessor] no minuit fit to plot for the last waveform"<<std::endl;
+   }
+
+}
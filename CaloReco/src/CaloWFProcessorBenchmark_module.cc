@@ -0,0 +1,156 @@
+//
+// Compare the template (minuit) and fast template waveform processors on the same CaloDigis.
+// Both processors are run on every waveform with the TemplateProcessor configuration; at the end
+// of the job the time per waveform of each processor is printed, together with the fraction of
+// waveforms handled by the fast single pulse fit and the amplitude and time residuals of the
+// fast processor with respect to the template one (for waveforms where both find one peak).
+//
+
+#include "art/Framework/Core/EDAnalyzer.h"
+#include "art/Framework/Principal/Event.h"
+#include "canvas/Utilities/InputTag.h"
+#include "fhiclcpp/types/Atom.h"
+#include "fhiclcpp/types/Table.h"
+
+#include "Offline/CaloReco/inc/CaloTemplateFastWFProcessor.hh"
+#include "Offline/CaloReco/inc/CaloTemplateWFProcessor.hh"
+#include "Offline/RecoDataProducts/inc/CaloDigi.hh"
+
+#include <chrono>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <vector>
+
+namespace mu2e {
+
+class CaloWFProcessorBenchmark : public art::EDAnalyzer {
+public:
+  //clang-format off
+  struct Config {
+    using Name = fhicl::Name;
+    using Comment = fhicl::Comment;
+    fhicl::Table<mu2e::CaloTemplateWFProcessor::Config> proc_templ_conf    { Name("TemplateProcessor"),  Comment("Template processor config, used by both processors") };
+    fhicl::Atom<art::InputTag>                          caloDigiCollection { Name("caloDigiCollection"), Comment("Calo Digi module label") };
+    fhicl::Atom<double>                                 digiSampling       { Name("digiSampling"),       Comment("Calo ADC sampling time (ns)") };
+  };
+  //clang-format on
+
+  explicit CaloWFProcessorBenchmark(const art::EDAnalyzer::Table<Config>& config) :
+      EDAnalyzer{config},
+      caloDigisToken_(consumes<CaloDigiCollection>(config().caloDigiCollection())),
+      digiSampling_  (config().digiSampling()),
+      templProc_     (config().proc_templ_conf()),
+      fastProc_      (config().proc_templ_conf()) {}
+
+  void beginRun(const art::Run& aRun) override;
+  void analyze(const art::Event& event) override;
+  void endJob() override;
+
+private:
+  struct Peaks {
+    int    nPeaks = 0;
+    double amplitude = 0;
+    double time = 0;
+  };
+
+  double runProcessor(CaloWaveformProcessor& processor, std::vector<Peaks>& peaks);
+
+  const art::ProductToken<CaloDigiCollection> caloDigisToken_;
+  double digiSampling_;
+  CaloTemplateWFProcessor templProc_;
+  CaloTemplateFastWFProcessor fastProc_;
+  std::vector<std::vector<double>> x_, y_;
+  std::vector<Peaks> templPeaks_, fastPeaks_;
+
+  unsigned long nWaveforms_ = 0, nCompared_ = 0, nPeakMismatch_ = 0;
+  double templTime_ = 0, fastTime_ = 0;
+  double sumdA_ = 0, sumdA2_ = 0, sumdt_ = 0, sumdt2_ = 0;
+};
+
+//--------------------------------------------------
+void CaloWFProcessorBenchmark::beginRun(const art::Run& aRun) {
+  templProc_.initialize();
+  fastProc_.initialize();
+}
+
+//--------------------------------------------------
+void CaloWFProcessorBenchmark::analyze(const art::Event& event) {
+  const auto& caloDigis = event.get(caloDigisToken_);
+
+  // prepare the waveforms as CaloRecoDigiMaker does, outside of the timed loops
+  x_.resize(caloDigis.size());
+  y_.resize(caloDigis.size());
+  for (size_t idigi = 0; idigi < caloDigis.size(); ++idigi) {
+    const auto& waveform = caloDigis[idigi].waveform();
+    x_[idigi].clear();
+    y_[idigi].clear();
+    for (unsigned int i = 0; i < waveform.size(); ++i) {
+      x_[idigi].push_back(caloDigis[idigi].t0() + (i + 0.5) * digiSampling_);
+      y_[idigi].push_back(waveform[i]);
+    }
+  }
+
+  templTime_ += runProcessor(templProc_, templPeaks_);
+  fastTime_ += runProcessor(fastProc_, fastPeaks_);
+  nWaveforms_ += caloDigis.size();
+
+  for (size_t idigi = 0; idigi < caloDigis.size(); ++idigi) {
+    const auto& tp = templPeaks_[idigi];
+    const auto& fp = fastPeaks_[idigi];
+    if (tp.nPeaks != fp.nPeaks)
+      ++nPeakMismatch_;
+    if (tp.nPeaks != 1 || fp.nPeaks != 1 || tp.amplitude <= 0)
+      continue;
+    double dA = fp.amplitude / tp.amplitude - 1.0;
+    double dt = fp.time - tp.time;
+    sumdA_ += dA;
+    sumdA2_ += dA * dA;
+    sumdt_ += dt;
+    sumdt2_ += dt * dt;
+    ++nCompared_;
+  }
+}
+
+//--------------------------------------------------
+double CaloWFProcessorBenchmark::runProcessor(CaloWaveformProcessor& processor, std::vector<Peaks>& peaks) {
+  peaks.resize(x_.size());
+  auto t0 = std::chrono::steady_clock::now();
+  for (size_t idigi = 0; idigi < x_.size(); ++idigi) {
+    processor.reset();
+    processor.extract(x_[idigi], y_[idigi]);
+    peaks[idigi].nPeaks = processor.nPeaks();
+    if (processor.nPeaks() > 0) {
+      peaks[idigi].amplitude = processor.amplitude(0);
+      peaks[idigi].time = processor.time(0);
+    }
+  }
+  auto t1 = std::chrono::steady_clock::now();
+  return std::chrono::duration<double, std::milli>(t1 - t0).count();
+}
+
+//--------------------------------------------------
+void CaloWFProcessorBenchmark::endJob() {
+  if (nWaveforms_ == 0)
+    return;
+  double nwf = nWaveforms_;
+  double nfit = fastProc_.nFastFits() + fastProc_.nFallbackFits();
+  std::cout << "CaloWFProcessorBenchmark: " << nWaveforms_ << " waveforms" << std::endl
+            << std::fixed << std::setprecision(3)
+            << "  template fit      " << 1000.0 * templTime_ / nwf << " us/waveform" << std::endl
+            << "  fast template fit " << 1000.0 * fastTime_ / nwf << " us/waveform, speedup "
+            << templTime_ / fastTime_ << ", single pulse fits " << 100.0 * fastProc_.nFastFits() / nfit << "%" << std::endl
+            << "  different number of peaks " << 100.0 * nPeakMismatch_ / nwf << "%" << std::endl;
+  if (nCompared_ > 0) {
+    double n = nCompared_;
+    double mdA = sumdA_ / n, mdt = sumdt_ / n;
+    std::cout << "  single peak residuals (" << nCompared_ << " waveforms): amplitude ratio-1 mean "
+              << mdA << " rms " << std::sqrt(std::max(sumdA2_ / n - mdA * mdA, 0.0)) << ", time mean " << mdt
+              << " ns rms " << std::sqrt(std::max(sumdt2_ / n - mdt * mdt, 0.0)) << " ns" << std::endl;
+  }
+  std::cout << std::defaultfloat;
+}
+
+} // namespace mu2e
+
+DEFINE_ART_MODULE(mu2e::CaloWFProcessorBenchmark)
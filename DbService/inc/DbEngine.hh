@@ -7,6 +7,8 @@
 // and extract a set of IoVs and calibration pointerss.  The DbHandle contacts
 // this class through the service, and asks the update method
 // for appropriate tables.  Database tables can be overridden by a text file.
+// If a DbSnapshot is set, the IoV structure and the tables are read from the
+// snapshot file instead of the database.
 
 #include <chrono>
 #include <shared_mutex>
@@ -16,6 +18,7 @@
 #include "Offline/DbTables/inc/DbId.hh"
 #include "Offline/DbTables/inc/DbLiveTable.hh"
 #include "Offline/DbTables/inc/DbSet.hh"
+#include "Offline/DbTables/inc/DbSnapshot.hh"
 #include "Offline/DbTables/inc/DbTable.hh"
 #include "Offline/DbTables/inc/DbTableCollection.hh"
 #include "Offline/DbTables/inc/DbValCache.hh"
@@ -26,7 +29,8 @@ class DbEngine {
  public:
   DbEngine() :
       _verbose(0), _saveCsv(true), _nearestMatch(false), _initialized(false),
-      _lockWaitTime(0), _lockTime(0) {}
+      _prefetchThreads(0), _nPrefetched(0), _prefetchReadTime(0.0),
+      _lockWaitTime(0), _lockTime(0), _prefetchTime(0) {}
   // the big read of the IOV structure is done in beginJob
   int beginJob();
   int endJob();
@@ -36,6 +40,8 @@ class DbEngine {
   DbVersion const& version() const { return _version; }
   // copy in the cache - optionally set before beginJob
   void setValCache(std::shared_ptr<DbValCache> vcache) { _vcache = vcache; }
+  // read from a snapshot file, not the database - optionally set before beginJob
+  void setSnapshot(std::shared_ptr<DbSnapshot> snapshot) { _snapshot = snapshot; }
   // add tables directly - optionally set before beginJob
   void addOverride(DbTableCollection const& coll);
   void setVerbose(int verbose = 0) { _verbose = verbose; }
@@ -43,6 +49,10 @@ class DbEngine {
   void setSaveCsv(bool saveCsv) { _saveCsv = saveCsv; }
   // whether, if no perfect match, accept neaby data
   void setNearestMatch(bool nearestMatch) { _nearestMatch = nearestMatch; }
+  // number of concurrent database reads in prefetch, 0 disables prefetch
+  void setPrefetchThreads(int prefetchThreads) {
+    _prefetchThreads = prefetchThreads;
+  }
   // these should only be called in after startup
   std::shared_ptr<DbValCache>& valCache() { return _vcache; }
   DbReader& reader() { return _reader; }
@@ -52,6 +62,10 @@ class DbEngine {
   DbLiveTable update(int tid, uint32_t run, uint32_t subrun);
   // ruten tid for table name and reverce, for connecting handles
   int tidByName(std::string const& name);
+  // read all tables of the set valid for this run/subrun which are not yet
+  // in the cache, concurrently, so later updates find them in the cache.
+  // Returns the number of tables read.  Failed reads are left for update
+  int prefetch(uint32_t run, uint32_t subrun);
 
  private:
   // call beginRun on first use, if needed
@@ -69,15 +83,20 @@ class DbEngine {
   DbTableCollection _override;  // the text tables
   DbCache _cache;               // cache of table contents
   std::shared_ptr<DbValCache> _vcache;  // full db iov heirarchy
+  std::shared_ptr<DbSnapshot> _snapshot;  // replaces the db, if set
   bool _initialized;
   DbSet _dbset;                              // simple set of relevant iovs
   std::map<std::string, int> _overrideTids;  // fake tids for text tables
+  int _prefetchThreads;
+  int _nPrefetched;
+  double _prefetchReadTime;  // sum over the prefetch threads
 
   // lock for threaded access
   mutable std::shared_mutex _mutex;
   // count the time locked
   std::chrono::microseconds _lockWaitTime;
   std::chrono::microseconds _lockTime;
+  std::chrono::microseconds _prefetchTime;
 };
 }  // namespace mu2e
 #endif
@@ -31,6 +31,8 @@ class DbReader {
   };
 
   DbReader();
+  // a new reader with the same settings, for use in another thread
+  DbReader(DbReader const& other);
   ~DbReader();
 
   const DbId& id() const { return _id; }
@@ -4,6 +4,7 @@
 #include <string>
 
 #include "Offline/DbService/inc/DbEngine.hh"
+#include "art/Framework/Principal/SubRun.h"
 #include "art/Framework/Services/Registry/ActivityRegistry.h"
 #include "art/Framework/Services/Registry/ServiceDeclarationMacros.h"
 #include "art/Framework/Services/Registry/ServiceTable.h"
@@ -39,6 +40,10 @@ class DbService {
         Name("version"), Comment("the version of the purpose"), "v*_*_*"};
     fhicl::Atom<std::string> dbName{Name("dbName"),
                                     Comment("which database to use"), "none"};
+    fhicl::OptionalAtom<std::string> snapshotFile{
+        Name("snapshotFile"),
+        Comment("binary snapshot from dbTool export-snapshot, read instead "
+                "of the database")};
     fhicl::OptionalSequence<std::string> textFile{
         Name("textFile"),
         Comment("list of text files containing override table data")};
@@ -60,6 +65,11 @@ class DbService {
         Name("nearestMatch"),
         Comment("if no proper IoV, accept nearby calibrations, default false"),
         false};
+    fhicl::Atom<int> prefetchThreads{
+        Name("prefetchThreads"),
+        Comment("at each subrun, read all tables of the set not yet cached "
+                "with this many concurrent reads, default 0 (off)"),
+        0};
     fhicl::Table<cacheConfig> cacheParameters{
         Name("cacheParameters"), Comment("database data caching details")};
   };
@@ -73,6 +83,7 @@ class DbService {
 
   // Functions registered for callbacks.
   void postBeginJob();
+  void preBeginSubRun(art::SubRun const& subrun);
   void postEndJob();
 
   // how the DbHandle interacts with this service
@@ -26,6 +26,7 @@
 #include "Offline/DbService/inc/DbReader.hh"
 #include "Offline/DbService/inc/DbSql.hh"
 #include "Offline/DbTables/inc/DbId.hh"
+#include "Offline/DbTables/inc/DbSnapshot.hh"
 #include "Offline/DbTables/inc/DbTableCollection.hh"
 #include "Offline/DbTables/inc/DbUtil.hh"
 #include "Offline/DbTables/inc/DbValCache.hh"
@@ -85,6 +86,8 @@ class DbTool {
   int commitVersion();
   int commitPatch();
   int verifySet();
+  int exportSnapshot();
+  int testSnapshot();
 
   int testUrl();
 
@@ -114,6 +117,9 @@ class DbTool {
     std::time_t end;
   };
 
+  // read all the tables of all extensions of a version
+  int fillSetTables(int vid, DbTableCollection& coll);
+
   // look up purpose and version IDs, given text or pid,vid numbers
   int findPidVid(std::string purpose, std::string version, int& pid, int& vid);
 
@@ -2,16 +2,18 @@
 #include "Offline/DbService/inc/DbValTool.hh"
 #include "Offline/DbTables/inc/DbTableFactory.hh"
 #include "cetlib_except/exception.h"
+#include <atomic>
 #include <chrono>
 #include <iostream>
 #include <mutex>
+#include <thread>
 
 using namespace std;
 
 int mu2e::DbEngine::beginJob() {
   if (_verbose > 4) cout << "DbEngine::beginJob start" << endl;
 
-  if (_id.name().empty()) {
+  if (_id.name().empty() && !_snapshot) {
     throw cet::exception("DBENGINE_DBID NOT_SET")
         << "DbEngine::beginJob found the DbId was not set\n";
   }
@@ -37,7 +39,11 @@ int mu2e::DbEngine::beginJob() {
 
   if (!_vcache) {  // if not already provided, create and fill it
     _vcache = std::make_shared<DbValCache>();
-    _reader.fillValTables(*_vcache);
+    if (_snapshot) {
+      _snapshot->fillValCache(*_vcache, _saveCsv);
+    } else {
+      _reader.fillValTables(*_vcache);
+    }
   }
 
   // use the purpose and version to fill the DbSet, the list of relevant iovs
@@ -46,6 +52,22 @@ int mu2e::DbEngine::beginJob() {
   vtool.fillSetVer(_version, _dbset);
   _dbset.setNearestMatch(_nearestMatch);
 
+  // a snapshot only holds the tables of the set it was written for,
+  // so check now that it holds all of this set
+  if (_snapshot) {
+    for (auto const& tp : _dbset.emap()) {
+      for (auto const& eiov : tp.second) {
+        if (!_snapshot->hasTable(eiov.cid())) {
+          throw cet::exception("DBENGINE_SNAPSHOT_INCOMPLETE")
+              << "DbEngine::beginJob snapshot " << _snapshot->fileName()
+              << " of " << _snapshot->purpose() << " " << _snapshot->version()
+              << " does not have cid " << eiov.cid() << " of "
+              << _version.to_string() << "\n";
+        }
+      }
+    }
+  }
+
   // if file-based override tables were loaded,
   // update tid now.  If the table is known to the database,
   // then use that tid, but if it is not, use previously
@@ -114,7 +136,7 @@ mu2e::DbLiveTable mu2e::DbEngine::update(int tid, uint32_t run,
     auto row = _dbset.find(tid, run, subrun);
     cid = row.cid();
     iov = row.iov();
-    ptr = _cache.get(row.cid());
+    if (cid >= 0) ptr = _cache.get(cid, _vcache->valTables().row(tid).name());
   }  // read lock goes out of scope
 
   // if no cid now, then table can't be found - have to stop
@@ -135,14 +157,14 @@ mu2e::DbLiveTable mu2e::DbEngine::update(int tid, uint32_t run,
 
     // have to check if some other thread loaded it
     // since the above read attempt
-    if (_cache.hasTable(cid)) {
-      ptr = _cache.get(cid);
-    } else {
+    ptr = _cache.get(cid);
+    if (!ptr) {
       auto const& tabledef = _vcache->valTables().row(tid);
       // this makes the memory
       auto ncptr = DbTableFactory::newTable(tabledef.name());
-      // the actual http read
-      int rc = _reader.fillTableByCid(ncptr, cid);
+      // the actual http read, or the snapshot
+      int rc = _snapshot ? _snapshot->fillTable(ncptr, cid, _saveCsv)
+                         : _reader.fillTableByCid(ncptr, cid);
 
       // reader does not abort, so do it here
       if (rc != 0) {
@@ -179,6 +201,113 @@ mu2e::DbLiveTable mu2e::DbEngine::update(int tid, uint32_t run,
   return dblt;
 }
 
+// read, concurrently, all the tables of the set needed for this run/subrun
+// which are not in the cache yet.  This is only an optimization - if a read
+// fails here, update will read the table again and report the error
+
+int mu2e::DbEngine::prefetch(uint32_t run, uint32_t subrun) {
+  lazyBeginJob();  // initialize if needed
+
+  if (_prefetchThreads <= 0 || !_vcache) return 0;
+
+  auto stime = std::chrono::high_resolution_clock::now();
+
+  // the (tid,cid) of tables to be read
+  std::vector<std::pair<int, int>> todo;
+  {
+    std::shared_lock lock(_mutex);  // shared read lock
+    for (auto const& p : _dbset.emap()) {
+      int tid = p.first;
+      // tables covered by an override are never read for this run
+      bool overridden = false;
+      for (auto const& oltab : _override) {
+        if (oltab.tid() == tid && oltab.iov().inInterval(run, subrun)) {
+          overridden = true;
+        }
+      }
+      if (overridden) continue;
+      int cid = _dbset.find(tid, run, subrun).cid();
+      if (cid < 0 || _cache.hasTable(cid)) continue;
+      todo.emplace_back(tid, cid);
+    }
+  }  // read lock goes out of scope
+
+  if (todo.empty()) return 0;
+
+  // each thread needs its own reader, since the curl handle is not shared
+  size_t nthread = std::min(size_t(_prefetchThreads), todo.size());
+  std::vector<DbReader> readers(nthread, _reader);
+  std::vector<DbTable::cptr_t> tables(todo.size());
+  std::atomic<size_t> next(0);
+
+  auto work = [&](DbReader& reader) {
+    reader.setAbortOnFail(false);
+    for (size_t i = next++; i < todo.size(); i = next++) {
+      int tid = todo[i].first;
+      int cid = todo[i].second;
+      try {
+        auto const& tabledef = _vcache->valTables().row(tid);
+        auto ncptr = DbTableFactory::newTable(tabledef.name());
+        int rc = _snapshot ? _snapshot->fillTable(ncptr, cid, _saveCsv)
+                           : reader.fillTableByCid(ncptr, cid);
+        if (rc == 0) {
+          tables[i] =
+              std::const_pointer_cast<const mu2e::DbTable, mu2e::DbTable>(
+                  ncptr);
+        }
+      } catch (std::exception const& e) {
+        if (_verbose > 1) {
+          cout << "DbEngine::prefetch failed to read cid " << cid << " : "
+               << e.what() << endl;
+        }
+      }
+    }
+  };
+
+  std::vector<std::thread> threads;
+  for (size_t i = 1; i < nthread; i++) {
+    threads.emplace_back(work, std::ref(readers[i]));
+  }
+  work(readers[0]);
+  for (auto& t : threads) t.join();
+
+  int nread = 0;
+  {
+    auto ltime = std::chrono::high_resolution_clock::now();
+    std::unique_lock lock(_mutex);  // write lock
+    auto mtime = std::chrono::high_resolution_clock::now();
+    _lockWaitTime +=
+        std::chrono::duration_cast<std::chrono::microseconds>(mtime - ltime);
+    for (size_t i = 0; i < todo.size(); i++) {
+      if (!tables[i]) continue;
+      // some other thread may have loaded it with update
+      if (_cache.hasTable(todo[i].second)) continue;
+      _cache.add(todo[i].second, tables[i]);
+      nread++;
+    }
+    for (auto& reader : readers) _prefetchReadTime += reader.totalTime();
+    _nPrefetched += nread;
+    auto etime = std::chrono::high_resolution_clock::now();
+    _lockTime +=
+        std::chrono::duration_cast<std::chrono::microseconds>(etime - mtime);
+    _prefetchTime +=
+        std::chrono::duration_cast<std::chrono::microseconds>(etime - stime);
+  }  // write lock goes out of scope
+
+  if (_verbose > 1) {
+    cout << "DbEngine::prefetch read " << nread << " of " << todo.size()
+         << " tables for run:subrun " << run << ":" << subrun << " with "
+         << nthread << " threads in "
+         << std::chrono::duration_cast<std::chrono::microseconds>(
+                std::chrono::high_resolution_clock::now() - stime)
+                    .count() *
+                1.0e-6
+         << " s" << endl;
+  }
+
+  return nread;
+}
+
 int mu2e::DbEngine::tidByName(std::string const& name) {
   lazyBeginJob();  // initialize if needed
 
@@ -318,8 +447,18 @@ int mu2e::DbEngine::endJob() {
   if (!_vcache) return 0;
   if (_verbose > 1) {
     std::cout << "DbEngine::endJob" << std::endl;
+    if (_snapshot) {
+      std::cout << "    Read from snapshot: " << _snapshot->fileName()
+                << std::endl;
+    }
     std::cout << "    Total time in reading DB: " << _reader.totalTime() << " s"
               << std::endl;
+    if (_prefetchThreads > 0) {
+      std::cout << "    Tables prefetched: " << _nPrefetched << " in "
+                << _prefetchTime.count() * 1.0e-6 << " s, with "
+                << _prefetchReadTime << " s reading in "
+                << _prefetchThreads << " threads" << std::endl;
+    }
     std::cout << "    Total time waiting for locks: "
               << _lockWaitTime.count() * 1.0e-6 << " s" << std::endl;
     std::cout << "    Total time in locks: " << _lockTime.count() * 1.0e-6
@@ -16,6 +16,16 @@ mu2e::DbReader::DbReader() :
   curl_global_init(CURL_GLOBAL_ALL);
 }
 
+mu2e::DbReader::DbReader(DbReader const& other) :
+    _id(other._id), _curl_handle(nullptr), _timeout(other._timeout),
+    _totalTime(0), _removeHeader(other._removeHeader),
+    _abortOnFail(other._abortOnFail), _useCache(other._useCache),
+    _cacheLifetime(other._cacheLifetime), _verbose(other._verbose),
+    _timeVerbose(other._timeVerbose), _saveCsv(other._saveCsv) {
+  // the curl handle is not copied, each reader opens its own
+  curl_global_init(CURL_GLOBAL_ALL);
+}
+
 mu2e::DbReader::~DbReader() {
   // free memory
   curl_global_cleanup();
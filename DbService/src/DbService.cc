@@ -15,6 +15,9 @@ DbService::DbService(Parameters const& config,
   // register callbacks
   iRegistry.sPostBeginJob.watch(this, &DbService::postBeginJob);
   iRegistry.sPostEndJob.watch(this, &DbService::postEndJob);
+  if (config().prefetchThreads() > 0) {
+    iRegistry.sPreBeginSubRun.watch(this, &DbService::preBeginSubRun);
+  }
 
   if (_verbose > 0) {
     std::cout << "DbService  " << config().purpose() << " "
@@ -31,6 +34,7 @@ DbService::DbService(Parameters const& config,
   // the engine which will read db, hold calibrations, deliver them
   _engine.setVerbose(_verbose);
   _engine.setSaveCsv(_config.saveCsv());
+  _engine.setPrefetchThreads(_config.prefetchThreads());
   if (_config.nearestMatch()) {
     _engine.setNearestMatch(true);
     mf::LogWarning warn("DbService");
@@ -42,6 +46,19 @@ DbService::DbService(Parameters const& config,
   _engine.setDbId(idList.getDbId(_config.dbName()));
   _engine.setVersion(_version);
 
+  // a snapshot of the calibration set replaces the database
+  std::string snapshotFile;
+  if (_config.snapshotFile(snapshotFile)) {
+    ConfigFileLookupPolicy snapshotLookup;
+    auto snapshot = std::make_shared<DbSnapshot>(snapshotLookup(snapshotFile));
+    if (_verbose > 0) {
+      std::cout << "DbService  snapshotFile: " << snapshot->fileName() << " "
+                << snapshot->purpose() << " " << snapshot->version()
+                << std::endl;
+    }
+    _engine.setSnapshot(snapshot);
+  }
+
   // if there were text files containing calibrations,
   // then read them and tell the engine to let them override IOV
   std::vector<std::string> files;
@@ -103,6 +120,12 @@ DbService::~DbService() {}
 /********************************************************/
 void DbService::postBeginJob() {}
 
+/********************************************************/
+void DbService::preBeginSubRun(art::SubRun const& subrun) {
+  // read the tables of the new subrun before the modules ask for them
+  _engine.prefetch(subrun.run(), subrun.subRun());
+}
+
 /********************************************************/
 void DbService::postEndJob() {
   // just print summaries according to verbosity
@@ -3,6 +3,7 @@
 ///////////////////////////////////////////////////////////////////////////////
 
 // C++ includes
+#include <chrono>
 #include <iostream>
 #include <stdexcept>
 #include <string>
@@ -42,7 +43,7 @@ class DbServiceTest : public art::EDAnalyzer {
   typedef art::EDAnalyzer::Table<Config> Parameters;
 
   explicit DbServiceTest(const Parameters& conf) :
-      art::EDAnalyzer(conf), _conf(conf()) {}
+      art::EDAnalyzer(conf), _conf(conf()), _firstEvent(false) {}
 
   ~DbServiceTest() {}
   void beginJob() override;
@@ -51,6 +52,7 @@ class DbServiceTest : public art::EDAnalyzer {
 
  private:
   Config _conf;
+  bool _firstEvent;  // the first event of a subrun, to time the table access
 
   mu2e::DbHandle<mu2e::TstCalib1> _testCalib1_h;
   mu2e::DbHandle<mu2e::TstCalib2> _testCalib2_h;
@@ -62,12 +64,16 @@ class DbServiceTest : public art::EDAnalyzer {
 
 void DbServiceTest::beginJob() {}
 
-void DbServiceTest::beginSubRun(const art::SubRun& subrun) {}
+void DbServiceTest::beginSubRun(const art::SubRun& subrun) {
+  _firstEvent = true;
+}
 
 //-----------------------------------------------------------------------------
 void DbServiceTest::analyze(const art::Event& event) {
   std::cout << "DbServiceTest::analyze  " << event.id() << std::endl;
 
+  auto stime = std::chrono::high_resolution_clock::now();
+
   for (auto const& tname : _conf.tableList()) {
     if (tname == "TstCalib1") {
       auto const& tc1 = _testCalib1_h.get(event.id());
@@ -89,6 +95,16 @@ void DbServiceTest::analyze(const art::Event& event) {
                 << "  rows=" << tt.nrow() << "\n";
     }
   }
+
+  // with DbService prefetchThreads, the tables of the subrun were read
+  // before the first event, which then only finds them in the cache
+  if (_firstEvent) {
+    auto dt = std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::high_resolution_clock::now() - stime);
+    std::cout << "DbServiceTest first event of subrun " << event.id()
+              << " table access " << dt.count() * 1.0e-6 << " s" << std::endl;
+    _firstEvent = false;
+  }
 }
 }  // namespace mu2e
 
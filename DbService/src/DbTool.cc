@@ -4,8 +4,10 @@
 #include "Offline/DbTables/inc/DbTableFactory.hh"
 #include "cetlib_except/exception.h"
 #include <algorithm>
+#include <chrono>
 #include <cstdlib>
 #include <fstream>
+#include <iomanip>
 #include <iostream>
 #include <iterator>
 #include <sstream>
@@ -42,6 +44,9 @@ int mu2e::DbTool::run() {
   if (_action == "commit-patch") return commitPatch();
   if (_action == "verify-set") return verifySet();
 
+  if (_action == "export-snapshot") return exportSnapshot();
+  if (_action == "test-snapshot") return testSnapshot();
+
   if (_action == "test-url") return testUrl();
 
   std::cout << "error: could not parse action : " << _args[0] << std::endl;
@@ -569,7 +574,20 @@ int mu2e::DbTool::printSet() {
   if (rc != 0) return 1;
 
   DbTableCollection coll;
+  fillSetTables(vid, coll);
+
+  if (_verbose > 1)
+    std::cout << "print-set: printing data " << coll.size() << " CIDs"
+              << std::endl;
+
+  DbUtil::writeFile(fn, coll);
+
+  return 0;
+}
 
+// ****************************************  fillSetTables
+
+int mu2e::DbTool::fillSetTables(int vid, DbTableCollection& coll) {
   for (auto const& er : _valcache.valExtensions().rows()) {
     if (er.vid() == vid) {
       for (auto const& elr : _valcache.valExtensionLists().rows()) {
@@ -594,15 +612,145 @@ int mu2e::DbTool::printSet() {
     }
   }  // extensions
 
-  if (_verbose > 1)
-    std::cout << "print-set: printing data " << coll.size() << " CIDs"
+  return 0;
+}
+
+// ****************************************  exportSnapshot
+
+int mu2e::DbTool::exportSnapshot() {
+  int rc = 0;
+
+  map_ss args;
+  args["purpose"] = "";
+  args["version"] = "";
+  args["file"] = "";
+  if ((rc = getArgs(args))) return rc;
+  std::string purpose = args["purpose"];
+  std::string version = args["version"];
+  std::string fn = args["file"];
+
+  if (purpose.empty() || version.empty() || fn.empty()) {
+    std::cout << "ERROR - purpose, version and file are required arguments "
               << std::endl;
+    return 1;
+  }
 
-  DbUtil::writeFile(fn, coll);
+  int pid = -1;
+  int vid = -1;
+  rc = findPidVid(purpose, version, pid, vid);
+  if (rc != 0) return 1;
+
+  // the snapshot is made from the csv text as it came from the database
+  _reader.setSaveCsv(true);
+  DbTableCollection coll;
+  fillSetTables(vid, coll);
+
+  DbSnapshot::write(fn, DbVersion(purpose, version), _valcache, coll);
+
+  if (_verbose > 0) {
+    DbSnapshot snapshot(fn);
+    std::cout << "export-snapshot: wrote " << snapshot.cids().size()
+              << " CIDs of " << purpose << " " << version << " to " << fn
+              << ", " << snapshot.size() << " bytes" << std::endl;
+  }
 
   return 0;
 }
 
+// ****************************************  testSnapshot
+
+int mu2e::DbTool::testSnapshot() {
+  int rc = 0;
+
+  map_ss args;
+  args["file"] = "";
+  if ((rc = getArgs(args))) return rc;
+  std::string fn = args["file"];
+
+  if (fn.empty()) {
+    std::cout << "ERROR - file is a required argument " << std::endl;
+    return 1;
+  }
+
+  typedef std::chrono::high_resolution_clock hrclock;
+  auto seconds = [](hrclock::duration dt) {
+    return std::chrono::duration_cast<std::chrono::microseconds>(dt).count() *
+           1.0e-6;
+  };
+
+  // summary per table type
+  struct Stats {
+    int ncid = 0;
+    std::size_t nrow = 0;
+    double csvTime = 0.0;
+    double snapshotTime = 0.0;
+    int nbad = 0;
+  };
+  std::map<std::string, Stats> stats;
+  Stats total;
+
+  auto t0 = hrclock::now();
+  DbSnapshot snapshot(fn);
+  DbValCache vcache;
+  snapshot.fillValCache(vcache);
+  double openTime = seconds(hrclock::now() - t0);
+
+  for (int cid : snapshot.cids()) {
+    std::string name = snapshot.tableName(cid);
+    std::string csv = snapshot.csv(cid);  // the text from the database
+
+    auto csvTable = mu2e::DbTableFactory::newTable(name);
+    auto t1 = hrclock::now();
+    csvTable->fill(csv, false);
+    auto t2 = hrclock::now();
+
+    auto snapTable = mu2e::DbTableFactory::newTable(name);
+    auto t3 = hrclock::now();
+    int frc = snapshot.fillTable(snapTable, cid, false);
+    auto t4 = hrclock::now();
+    if (frc != 0) {
+      std::cout << "test-snapshot: " << name << " cid " << cid
+                << " could not be filled from the snapshot" << std::endl;
+    }
+
+    // both must give the same binary content
+    csvTable->toCsv();
+    snapTable->toCsv();
+    bool same = frc == 0 && csvTable->csv() == snapTable->csv();
+    if (!same) {
+      std::cout << "test-snapshot: " << name << " cid " << cid
+                << " differs from its csv fill" << std::endl;
+    }
+
+    for (Stats* s : {&stats[name], &total}) {
+      s->ncid++;
+      s->nrow += csvTable->nrow();
+      s->csvTime += seconds(t2 - t1);
+      s->snapshotTime += seconds(t4 - t3);
+      if (!same) s->nbad++;
+    }
+  }
+
+  std::stringstream ss;
+  ss << "test-snapshot: " << fn << " " << snapshot.purpose() << " "
+     << snapshot.version() << ", " << snapshot.size() << " bytes" << std::endl;
+  ss << "  open and IoV structure fill " << openTime << " s" << std::endl;
+  ss << std::setw(24) << "Table" << std::setw(6) << "CIDs" << std::setw(10)
+     << "rows" << std::setw(12) << "csv (s)" << std::setw(14)
+     << "snapshot (s)" << std::setw(7) << "diffs" << std::endl;
+  stats["total"] = total;
+  for (auto const& p : stats) {
+    ss << std::setw(24) << p.first << std::setw(6) << p.second.ncid
+       << std::setw(10) << p.second.nrow << std::setw(12) << p.second.csvTime
+       << std::setw(14) << p.second.snapshotTime << std::setw(7)
+       << p.second.nbad << std::endl;
+  }
+  _result.append(ss.str());
+
+  // tables which differ or could not be filled fail the test
+  return total.nbad > 0 ? 1 : 0;
+}
+
 // **************************************** printRun
 int mu2e::DbTool::printRun() {
   int rc = 0;
@@ -2698,6 +2846,11 @@ int mu2e::DbTool::help() {
            "patches\n"
            "    verify-set : check that a calibration set is complete for a "
            "set of runs\n"
+           "    \n"
+           "    export-snapshot : write a calibration set to a binary snapshot "
+           "file\n"
+           "    test-snapshot : time filling tables from a snapshot and from "
+           "csv\n"
            " \n"
            " arguments that are lists of integers may have the form:\n"
            "    int   example: --cid 234\n"
@@ -2848,6 +3001,35 @@ int mu2e::DbTool::help() {
            "    --version VERSION : the version (required)\n"
            "    --file FILENAME : the output file (required)\n"
         << std::endl;
+  } else if (_action == "export-snapshot") {
+    std::cout
+        << " \n"
+           " dbTool export-snapshot [OPTIONS]\n"
+           " \n"
+           " Write the IoV structure and the entire content of a "
+           "PURPOSE/VERSION\n"
+           " to a binary snapshot file, which the DbService can read instead "
+           "of\n"
+           " the database (DbService.snapshotFile).\n"
+           " \n"
+           " [OPTIONS]\n"
+           "    --purpose PURPOSE : the purpose (required)\n"
+           "    --version VERSION : the version (required)\n"
+           "    --file FILENAME : the output file (required)\n"
+        << std::endl;
+  } else if (_action == "test-snapshot") {
+    std::cout
+        << " \n"
+           " dbTool test-snapshot [OPTIONS]\n"
+           " \n"
+           " Fill every table of a snapshot file from the snapshot, and from "
+           "its\n"
+           " csv text, check that they agree, and print the time of each, by "
+           "table.\n"
+           " \n"
+           " [OPTIONS]\n"
+           "    --file FILENAME : the snapshot file (required)\n"
+        << std::endl;
   } else if (_action == "print-run") {
     std::cout << " \n"
                  " dbTool print-run [OPTIONS]\n"
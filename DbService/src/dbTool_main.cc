@@ -18,8 +18,8 @@ int main(int argc, char** argv) {
   rc = tool.init();
   if (rc != 0) return rc;
   rc = tool.run();
-  if (rc != 0) return rc;
+  // a failed test still prints its summary
   std::cout << tool.getResult();
 
-  return 0;
+  return rc;
 }
@@ -60,6 +60,27 @@ class CRVSiPM : public DbTable {
                        std::stof(columns[2]), std::stof(columns[3]));
   }
 
+  bool fillColumns(DbColumns const& columns) override {
+    if (columns.ncol() != 4 || !columns.isInt(0)) return false;
+    for (std::size_t icol = 1; icol < 4; icol++) {
+      if (!columns.isNumber(icol)) return false;
+    }
+    _rows.reserve(columns.nrow());
+    for (std::size_t irow = 0; irow < columns.nrow(); irow++) {
+      std::uint16_t channel = columns.intAt(0, irow);
+      if (channel >= CRVId::nChannels || channel != _rows.size()) {
+        throw cet::exception("CRVSIPM_BAD_CHANNEL")
+            << "CRVSiPM::fillColumns bad channel, saw "
+            << columns.textAt(0, irow) << ", expected " << _rows.size()
+            << "\n";
+      }
+      _rows.emplace_back(channel, float(columns.floatAt(1, irow)),
+                         float(columns.floatAt(2, irow)),
+                         float(columns.floatAt(3, irow)));
+    }
+    return true;
+  }
+
   void rowToCsv(std::ostringstream& sstream, std::size_t irow) const override {
     Row const& r = _rows.at(irow);
     sstream << r.channel() << ",";
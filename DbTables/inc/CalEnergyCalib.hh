@@ -57,6 +57,19 @@ namespace mu2e {
 
     }
 
+    bool fillColumns(DbColumns const& columns) override {
+      if (columns.ncol()!=2 || !columns.isInt(0) || !columns.isNumber(1)) return false;
+      _rows.reserve(columns.nrow());
+      for (std::size_t irow=0; irow<columns.nrow(); irow++) {
+        std::uint16_t index = columns.intAt(0,irow);
+        if (index!=int(_rows.size())) {
+          throw cet::exception("CALOENERGYCALIB_BAD_INDEX")<<"CalEnergyCalib::fillColumns found index out of order:"<<index << " != " << int(_rows.size()) <<"\n";
+        }
+        _rows.emplace_back(CaloSiPMId(index),float(columns.floatAt(1,irow)));
+      }
+      return true;
+    }
+
 
     void rowToCsv(std::ostringstream& sstream, std::size_t irow) const override {
       Row const& r = _rows.at(irow);
@@ -5,10 +5,25 @@
 // here for a while in case they are needed, for example, by different threads.
 // Eventually a tbale may be purged.  If a needed table is purged,
 // it can always be re-read.
+//
+// The cache may be used from several threads at once.  Tables are kept in
+// shards by cid, each with its own lock and its own list of tables in the
+// order they were last used.  When the memory of the tables, counted with
+// DbTable::size(), goes over the limit, the least recently used tables of
+// all shards are removed until the size is below purgeEnd of the limit.
+// Hits, misses, adds and evictions are counted for each table name.  A miss
+// is only counted by the get which is given the table name.  Tables are
+// added after a failed lookup or ahead of time (prefetch), so adds are not
+// the same as misses.
 
 #include "Offline/DbTables/inc/DbTable.hh"
+#include <array>
+#include <atomic>
+#include <list>
 #include <map>
-#include <queue>
+#include <mutex>
+#include <string>
+#include <unordered_map>
 
 namespace mu2e {
 
@@ -17,39 +32,66 @@ class DbCache {
   DbCache() :
       _limitSize(200000000),  // 200 MB
       _purgeInterval(20), _purgeEnd(0.9), _hwmSize(0), _size(0), _nPurges(0),
-      _nPurged(0), _nAdded(0) {}
+      _nPurged(0), _nAdded(0), _clock(0) {}
 
   void setLimitSize(int64_t limitSize) { _limitSize = limitSize; }
   void setPurgeInterval(int purgeInterval) { _purgeInterval = purgeInterval; }
   void setPurgeEnd(float purgeEnd) { _purgeEnd = purgeEnd; }
   void add(int cid, mu2e::DbTable::cptr_t const& ptr);
 
-  bool hasTable(int cid) { return _tables.find(cid) != _tables.end(); }
+  bool hasTable(int cid);
 
+  // returns nullptr if the table is not in the cache
   mu2e::DbTable::cptr_t get(int cid);
+  // same, and counts a miss for the table name if it is not in the cache
+  mu2e::DbTable::cptr_t get(int cid, std::string const& name);
 
-  void clear() { _tables.clear(); }
+  void clear();
   int64_t size() const { return _size; }
-  void print() const;
-  void printStats() const;
+  void print();
+  void printStats();
 
  private:
-  typedef std::map<int, mu2e::DbTable::cptr_t> table_map;
+  struct Entry {
+    mu2e::DbTable::cptr_t ptr;
+    std::list<int>::iterator lru;  // position in the shard lru list
+    uint64_t stamp;                // _clock when last used
+  };
+
+  struct TableStats {
+    int64_t nHit = 0;
+    int64_t nMiss = 0;
+    int64_t nAdd = 0;
+    int64_t nEvict = 0;
+  };
+
+  struct Shard {
+    std::mutex mutex;
+    std::unordered_map<int, Entry> tables;
+    std::list<int> lru;  // cids, most recently used first
+    std::map<std::string, TableStats> stats;
+  };
+
+  static constexpr std::size_t _nShard = 16;
+  Shard& shard(int cid) { return _shards[std::size_t(cid) % _nShard]; }
 
   void purge();
+  // remove the least recently used table in all shards
+  bool evictOne();
 
-  table_map _tables;
+  std::array<Shard, _nShard> _shards;
 
   // items needed for monitoring and purging
   int64_t _limitSize;  // max size for cache in bytes
   int _purgeInterval;  // check purge after every purgeInterval add()'s
   float _purgeEnd;     // purge down to this fraction of the limit
-  int64_t _hwmSize;
-  int64_t _size;
-  std::queue<int> _cidFifo;
-  int _nPurges;
-  int _nPurged;
-  int _nAdded;
+  std::atomic<int64_t> _hwmSize;
+  std::atomic<int64_t> _size;
+  std::atomic<int> _nPurges;
+  std::atomic<int> _nPurged;
+  std::atomic<int> _nAdded;
+  std::atomic<uint64_t> _clock;  // counts uses, for the lru order
+  std::mutex _purgeMutex;        // one thread purges at a time
 };
 
 }  // namespace mu2e
@@ -0,0 +1,78 @@
+#ifndef DbTables_DbColumns_hh
+#define DbTables_DbColumns_hh
+
+// A read-only, column-wise view of the content of a DbTable, as it is
+// stored in a DbSnapshot file.  Every column holds the text of its fields,
+// exactly as split from the database csv, and columns which are all
+// integers, or all numbers, also hold the values in binary, so that tables
+// can be filled without any string conversion (see DbTable::fillColumns).
+// Binary values of number columns are doubles; converting them to float
+// agrees with std::stof for the short decimal values in the database.
+// The view does not own the memory, which belongs to the snapshot.
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace mu2e {
+
+class DbColumns {
+ public:
+  enum colType { Int = 0, Float = 1, Text = 2 };
+
+  struct Column {
+    colType type;
+    int64_t const* ints;     // values of Int columns
+    double const* floats;    // values of Float columns
+    uint64_t const* offsets; // nrow+1 offsets of the fields in text
+    char const* text;
+  };
+
+  DbColumns(std::size_t nrow, std::vector<Column> const& columns) :
+      _nrow(nrow), _columns(columns) {}
+
+  std::size_t nrow() const { return _nrow; }
+  std::size_t ncol() const { return _columns.size(); }
+  colType type(std::size_t icol) const { return _columns[icol].type; }
+  // all fields of the column are integers
+  bool isInt(std::size_t icol) const { return type(icol) == Int; }
+  // all fields of the column are numbers, integers included
+  bool isNumber(std::size_t icol) const { return type(icol) != Text; }
+
+  // only valid if isInt(icol)
+  int64_t intAt(std::size_t icol, std::size_t irow) const {
+    return _columns[icol].ints[irow];
+  }
+  // only valid if isNumber(icol)
+  double floatAt(std::size_t icol, std::size_t irow) const {
+    Column const& c = _columns[icol];
+    return c.type == Int ? double(c.ints[irow]) : c.floats[irow];
+  }
+  // the field as it appeared in the csv
+  std::string_view textAt(std::size_t icol, std::size_t irow) const {
+    Column const& c = _columns[icol];
+    return std::string_view(c.text + c.offsets[irow],
+                            c.offsets[irow + 1] - c.offsets[irow]);
+  }
+
+  // rebuild the csv text, identical to the text the columns were split from
+  std::string csv() const {
+    std::string csv;
+    for (std::size_t irow = 0; irow < _nrow; irow++) {
+      for (std::size_t icol = 0; icol < ncol(); icol++) {
+        if (icol > 0) csv.push_back(',');
+        csv.append(textAt(icol, irow));
+      }
+      csv.push_back('\n');
+    }
+    return csv;
+  }
+
+ private:
+  std::size_t _nrow;
+  std::vector<Column> _columns;
+};
+
+}  // namespace mu2e
+#endif
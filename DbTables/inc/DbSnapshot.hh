@@ -0,0 +1,123 @@
+#ifndef DbTables_DbSnapshot_hh
+#define DbTables_DbSnapshot_hh
+
+// A binary snapshot of a calibration set: the IoV structure (DbValCache)
+// and the content of all the tables of one purpose/version, written by
+// "dbTool export-snapshot".  The DbEngine can read tables from the snapshot
+// instead of the database, so jobs need no database or web cache.
+//
+// The file is memory mapped.  Each table is stored by columns (see
+// DbColumns), with the csv fields pre-split and the number columns also in
+// binary, so a table is filled without parsing csv text.  Tables are only
+// filled when they are requested.  Offsets and arrays are 8-byte aligned.
+// The file is in the byte order of the machine that wrote it, which is
+// checked when the file is opened.
+
+#include "Offline/DbTables/inc/DbColumns.hh"
+#include "Offline/DbTables/inc/DbTable.hh"
+#include "Offline/DbTables/inc/DbTableCollection.hh"
+#include "Offline/DbTables/inc/DbValCache.hh"
+#include "Offline/DbTables/inc/DbVersion.hh"
+#include <cstdint>
+#include <map>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace mu2e {
+
+class DbSnapshot {
+ public:
+  // map the file, and check its header
+  explicit DbSnapshot(std::string const& fileName);
+  ~DbSnapshot();
+
+  DbSnapshot(DbSnapshot const&) = delete;
+  DbSnapshot& operator=(DbSnapshot const&) = delete;
+
+  std::string const& fileName() const { return _fileName; }
+  // the purpose and version given when the snapshot was written
+  std::string const& purpose() const { return _purpose; }
+  std::string const& version() const { return _version; }
+  // size of the file in bytes
+  std::size_t size() const { return _size; }
+
+  // the calibration tables in the snapshot
+  std::vector<int> cids() const;
+  bool hasTable(int cid) const { return _cids.find(cid) != _cids.end(); }
+  // the table name of the cid, empty if it is not in the snapshot
+  std::string tableName(int cid) const;
+  // the csv text of the table, as it was read from the database
+  std::string csv(int cid) const;
+
+  // fill the IoV structure
+  void fillValCache(DbValCache& vcache, bool saveCsv = false) const;
+  // fill a table, created with DbTableFactory, with the content of the cid.
+  // Returns 0 if successful, 1 if the cid is not in the snapshot
+  int fillTable(DbTable::ptr_t const& ptr, int cid, bool saveCsv = false) const;
+
+  // write a snapshot of the IoV structure and the tables, which must
+  // hold the csv text they were filled with.  Repeated cids are written once
+  static void write(std::string const& fileName, DbVersion const& version,
+                    DbValCache const& vcache, DbTableCollection const& coll);
+
+ private:
+  struct Header {
+    char magic[8];
+    uint32_t format;
+    uint32_t byteOrder;
+    uint64_t ntable;
+    uint64_t tableOffset;  // the TableEntry array
+    uint64_t purposeOffset;
+    uint64_t purposeSize;
+    uint64_t versionOffset;
+    uint64_t versionSize;
+  };
+
+  struct TableEntry {
+    int32_t tid;  // -1 for the IoV structure tables
+    int32_t cid;  // -1 for the IoV structure tables
+    uint64_t nrow;
+    uint64_t ncol;
+    uint64_t nameOffset;
+    uint64_t nameSize;
+    uint64_t columnOffset;  // the ncol ColumnEntry array
+  };
+
+  struct ColumnEntry {
+    uint64_t type;  // DbColumns::colType
+    uint64_t valueOffset;  // nrow int64 or double, 0 for Text columns
+    uint64_t offsetOffset;  // nrow+1 uint64 offsets of the fields in the text
+    uint64_t textOffset;
+  };
+
+  static constexpr uint32_t _format = 1;
+  static constexpr uint32_t _byteOrder = 0x01020304;
+
+  template <class T>
+  T const* at(uint64_t offset) const {
+    return reinterpret_cast<T const*>(_data + offset);
+  }
+  std::string stringAt(uint64_t offset, uint64_t size) const {
+    return std::string(_data + offset, size);
+  }
+  DbColumns columns(TableEntry const& entry) const;
+  // true if n elements of the given size at offset are inside the file
+  bool inFile(uint64_t offset, uint64_t n, uint64_t size = 1) const {
+    return offset <= _size && n <= (_size - offset) / size;
+  }
+  // true if the entry, its columns and their fields are inside the file
+  bool validEntry(TableEntry const& entry) const;
+
+  std::string _fileName;
+  char const* _data;
+  std::size_t _size;
+  std::string _purpose;
+  std::string _version;
+  TableEntry const* _entries;
+  std::unordered_map<int, std::size_t> _cids;  // entry index by cid
+  std::map<std::string, std::size_t> _vals;    // entry index of val tables
+};
+
+}  // namespace mu2e
+#endif
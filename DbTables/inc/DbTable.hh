@@ -1,6 +1,7 @@
 #ifndef DbTables_DbTable_hh
 #define DbTables_DbTable_hh
 
+#include "Offline/DbTables/inc/DbColumns.hh"
 #include <cstdint>
 #include <memory>
 #include <sstream>
@@ -43,11 +44,17 @@ class DbTable {
 
   // take the cvs text from a query and build out the table contents
   int fill(const std::string& csv, bool saveCsv = true);
+  // build out the table contents from pre-split columns of a DbSnapshot
+  int fill(DbColumns const& columns, bool saveCsv = true);
   // in case table was filled with binary values, convert to csv
   int toCsv();
 
   // part of building content, convert list of strings to binary row
   virtual void addRow(const std::vector<std::string>& columns) = 0;
+  // optionally overridden by derived class: fill all rows from the binary
+  // column values. Return false, leaving the table empty, if the column
+  // types do not allow it; the rows are then added from text by addRow
+  virtual bool fillColumns(DbColumns const& columns) { return false; }
   // convert a row in a binary format to a string
   virtual void rowToCsv(std::ostringstream& stream, size_t irow) const = 0;
   // remove all rows
@@ -55,6 +62,9 @@ class DbTable {
   void baseClear() { _csv.clear(); }
 
  private:
+  // check the number of rows of tables with a fixed number of rows
+  void checkRowCount() const;
+
   std::string _name;
   std::string _dbname;
   std::string _query;
@@ -52,6 +52,32 @@ class TrkAlignStraw : public DbTable {
                        std::stof(columns[9]));
   }
 
+  bool fillColumns(DbColumns const& columns) override {
+    if (columns.ncol() != 10 || !columns.isInt(0)) return false;
+    for (std::size_t icol = 2; icol < 10; icol++) {
+      if (!columns.isNumber(icol)) return false;
+    }
+    _rows.reserve(columns.nrow());
+    for (std::size_t irow = 0; irow < columns.nrow(); irow++) {
+      int index = columns.intAt(0, irow);
+      if (index != int(_rows.size())) {
+        throw cet::exception("TRKALIGNSTRAW_BAD_INDEX")
+            << "TrkAlignStraw::fillColumns found index out of order: "
+            << index << " != " << _rows.size() << "\n";
+      }
+      _rows.emplace_back(index, StrawId(std::string(columns.textAt(1, irow))),
+                         float(columns.floatAt(2, irow)),
+                         float(columns.floatAt(3, irow)),
+                         float(columns.floatAt(4, irow)),
+                         float(columns.floatAt(5, irow)),
+                         float(columns.floatAt(6, irow)),
+                         float(columns.floatAt(7, irow)),
+                         float(columns.floatAt(8, irow)),
+                         float(columns.floatAt(9, irow)));
+    }
+    return true;
+  }
+
   void rowToCsv(std::ostringstream& sstream, std::size_t irow) const override {
     TrkStrawEndAlign const& r = _rows.at(irow);
     sstream << r._index << ",";
@@ -63,6 +63,28 @@ class TrkPreampStraw : public DbTable {
                        std::stof(columns[5]));
   }
 
+  bool fillColumns(DbColumns const& columns) override {
+    if (columns.ncol() != 6 || !columns.isInt(0)) return false;
+    for (std::size_t icol = 1; icol < 6; icol++) {
+      if (!columns.isNumber(icol)) return false;
+    }
+    _rows.reserve(columns.nrow());
+    for (std::size_t irow = 0; irow < columns.nrow(); irow++) {
+      int index = columns.intAt(0, irow);
+      if (index != int(_rows.size())) {
+        throw cet::exception("TRKPREAMPSTRAW_BAD_INDEX")
+            << "TrkPreampStraw::fillColumns found index out of order: "
+            << index << " != " << _rows.size() << "\n";
+      }
+      _rows.emplace_back(index, float(columns.floatAt(1, irow)),
+                         float(columns.floatAt(2, irow)),
+                         float(columns.floatAt(3, irow)),
+                         float(columns.floatAt(4, irow)),
+                         float(columns.floatAt(5, irow)));
+    }
+    return true;
+  }
+
   void rowToCsv(std::ostringstream& sstream, std::size_t irow) const override {
     Row const& r = _rows.at(irow);
     sstream << r.index() << ",";
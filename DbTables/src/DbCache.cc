@@ -2,54 +2,151 @@
 #include "Offline/DbTables/inc/DbCache.hh"
 #include <iomanip>
 #include <iostream>
+#include <limits>
 
 void mu2e::DbCache::add(int cid, mu2e::DbTable::cptr_t const& ptr) {
-  _tables[cid] = ptr;
+  {
+    Shard& sh = shard(cid);
+    std::lock_guard<std::mutex> lock(sh.mutex);
+    auto it = sh.tables.find(cid);
+    if (it != sh.tables.end()) {  // replace, keeping the size right
+      _size -= it->second.ptr->size();
+      sh.lru.erase(it->second.lru);
+      sh.tables.erase(it);
+    }
+    sh.lru.push_front(cid);
+    sh.tables[cid] = Entry{ptr, sh.lru.begin(), ++_clock};
+    sh.stats[ptr->name()].nAdd++;
+  }
+
+  int64_t size = (_size += ptr->size());
+  int64_t hwm = _hwmSize;
+  while (size > hwm && !_hwmSize.compare_exchange_weak(hwm, size)) {
+  }
+  if (++_nAdded % _purgeInterval == 0) purge();
+}
 
-  _cidFifo.push(cid);
-  _nAdded++;
-  _size += ptr->size();
-  if (_size > _hwmSize) _hwmSize = _size;
-  if (_nAdded % _purgeInterval == 0) purge();
+bool mu2e::DbCache::hasTable(int cid) {
+  Shard& sh = shard(cid);
+  std::lock_guard<std::mutex> lock(sh.mutex);
+  return sh.tables.find(cid) != sh.tables.end();
 }
 
 mu2e::DbTable::cptr_t mu2e::DbCache::get(int cid) {
-  auto it = _tables.find(cid);
-  if (it != _tables.end()) {
-    return it->second;
-  } else {
-    return mu2e::DbTable::cptr_t(nullptr);
+  Shard& sh = shard(cid);
+  std::lock_guard<std::mutex> lock(sh.mutex);
+  auto it = sh.tables.find(cid);
+  if (it == sh.tables.end()) return mu2e::DbTable::cptr_t(nullptr);
+
+  Entry& e = it->second;
+  sh.lru.splice(sh.lru.begin(), sh.lru, e.lru);  // now most recently used
+  e.stamp = ++_clock;
+  sh.stats[e.ptr->name()].nHit++;
+  return e.ptr;
+}
+
+mu2e::DbTable::cptr_t mu2e::DbCache::get(int cid, std::string const& name) {
+  auto ptr = get(cid);
+  if (!ptr) {
+    Shard& sh = shard(cid);
+    std::lock_guard<std::mutex> lock(sh.mutex);
+    sh.stats[name].nMiss++;
+  }
+  return ptr;
+}
+
+void mu2e::DbCache::clear() {
+  for (auto& sh : _shards) {
+    std::lock_guard<std::mutex> lock(sh.mutex);
+    for (auto const& p : sh.tables) _size -= p.second.ptr->size();
+    sh.tables.clear();
+    sh.lru.clear();
   }
 }
 
 void mu2e::DbCache::purge() {
   if (_size < _limitSize) return;
 
+  std::lock_guard<std::mutex> plock(_purgeMutex);
+  if (_size < _limitSize) return;  // another thread purged
+
   _nPurges++;
   while (_size > _purgeEnd * _limitSize) {
-    int cid = _cidFifo.front();
-    _cidFifo.pop();
-    auto it = _tables.find(cid);
-    if (it != _tables.end()) {
-      _size = -it->second->size();
-      _nPurged++;
-      _tables.erase(it);
-    }
+    if (!evictOne()) break;
   }
 
   return;
 }
 
-void mu2e::DbCache::print() const {
-  for (auto t : _tables) {
-    std::cout << std::setw(6) << t.first << " " << std::setw(15)
-              << t.second->name() << std::endl;
+bool mu2e::DbCache::evictOne() {
+  // the least recently used table of a shard is at the end of its list,
+  // so the oldest of those is the least recently used table overall
+  Shard* oldest = nullptr;
+  uint64_t oldestStamp = std::numeric_limits<uint64_t>::max();
+  for (auto& sh : _shards) {
+    std::lock_guard<std::mutex> lock(sh.mutex);
+    if (sh.lru.empty()) continue;
+    uint64_t stamp = sh.tables.find(sh.lru.back())->second.stamp;
+    if (stamp < oldestStamp) {
+      oldestStamp = stamp;
+      oldest = &sh;
+    }
   }
+  if (!oldest) return false;
+
+  // the shard may have changed since, but its last table is still
+  // a good choice
+  std::lock_guard<std::mutex> lock(oldest->mutex);
+  if (oldest->lru.empty()) return true;
+  auto it = oldest->tables.find(oldest->lru.back());
+  _size -= it->second.ptr->size();
+  oldest->stats[it->second.ptr->name()].nEvict++;
+  oldest->lru.pop_back();
+  oldest->tables.erase(it);
+  _nPurged++;
+  return true;
 }
 
-void mu2e::DbCache::printStats() const {
+void mu2e::DbCache::print() {
+  std::map<int, std::string> names;
+  for (auto& sh : _shards) {
+    std::lock_guard<std::mutex> lock(sh.mutex);
+    for (auto const& p : sh.tables) names[p.first] = p.second.ptr->name();
+  }
+  for (auto const& t : names) {
+    std::cout << std::setw(6) << t.first << " " << std::setw(15) << t.second
+              << std::endl;
+  }
+}
+
+void mu2e::DbCache::printStats() {
+  std::map<std::string, TableStats> stats;
+  for (auto& sh : _shards) {
+    std::lock_guard<std::mutex> lock(sh.mutex);
+    for (auto const& p : sh.stats) {
+      auto& s = stats[p.first];
+      s.nHit += p.second.nHit;
+      s.nMiss += p.second.nMiss;
+      s.nAdd += p.second.nAdd;
+      s.nEvict += p.second.nEvict;
+    }
+  }
+
   std::cout << "    cache nTable : " << _nAdded << "\n";
+  std::cout << "    cache size   : " << _size << " b\n";
   std::cout << "    cache HWM    : " << _hwmSize << " b\n";
   std::cout << "    cache nPurges : " << _nPurges << "\n";
   std::cout << "    cache nPurged : " << _nPurged << "\n";
+  if (stats.empty()) return;
+  std::cout << "    " << std::setw(25) << std::left << "table" << std::right
+            << std::setw(10) << "hits" << std::setw(10) << "misses"
+            << std::setw(10) << "adds"
+            << std::setw(10) << "evicts"
+            << "\n";
+  for (auto const& p : stats) {
+    std::cout << "    " << std::setw(25) << std::left << p.first << std::right
+              << std::setw(10) << p.second.nHit << std::setw(10)
+              << p.second.nMiss << std::setw(10) << p.second.nAdd
+              << std::setw(10) << p.second.nEvict << "\n";
+  }
 }
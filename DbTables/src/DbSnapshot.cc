@@ -0,0 +1,355 @@
+#include "Offline/DbTables/inc/DbSnapshot.hh"
+#include "Offline/DbTables/inc/DbUtil.hh"
+#include "cetlib_except/exception.h"
+#include <algorithm>
+#include <cerrno>
+#include <charconv>
+#include <cstdlib>
+#include <cstring>
+#include <fcntl.h>
+#include <fstream>
+#include <set>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace {
+
+// the names of the tables of the IoV structure, in DbValCache
+const std::vector<std::string> valNames = {
+    "ValTables",   "ValCalibrations", "ValIovs",
+    "ValGroups",   "ValGroupLists",   "ValPurposes",
+    "ValLists",    "ValTableLists",   "ValVersions",
+    "ValExtensions", "ValExtensionLists"};
+
+bool parseInt(std::string const& text, int64_t& value) {
+  if (text.empty()) return false;
+  auto end = text.data() + text.size();
+  auto res = std::from_chars(text.data(), end, value);
+  return res.ec == std::errc() && res.ptr == end;
+}
+
+bool parseFloat(std::string const& text, double& value) {
+  if (text.empty()) return false;
+  char* end = nullptr;
+  errno = 0;
+  value = std::strtod(text.c_str(), &end);
+  return errno == 0 && end == text.c_str() + text.size();
+}
+
+// the snapshot file image, with 8-byte aligned appends
+class Buffer {
+ public:
+  uint64_t append(void const* data, std::size_t size) {
+    uint64_t offset = _bytes.size();
+    _bytes.append(static_cast<char const*>(data), size);
+    _bytes.append((8 - _bytes.size() % 8) % 8, '\0');
+    return offset;
+  }
+  template <class T>
+  uint64_t append(std::vector<T> const& v) {
+    return append(v.data(), v.size() * sizeof(T));
+  }
+  uint64_t append(std::string const& s) { return append(s.data(), s.size()); }
+  void overwrite(uint64_t offset, void const* data, std::size_t size) {
+    std::memcpy(&_bytes[offset], data, size);
+  }
+  std::string const& bytes() const { return _bytes; }
+
+ private:
+  std::string _bytes;
+};
+
+}  // namespace
+
+mu2e::DbSnapshot::DbSnapshot(std::string const& fileName) :
+    _fileName(fileName), _data(nullptr), _size(0), _entries(nullptr) {
+  int fd = ::open(fileName.c_str(), O_RDONLY);
+  if (fd < 0) {
+    throw cet::exception("DBSNAPSHOT_OPEN_FAILED")
+        << "DbSnapshot could not open " << fileName << " : "
+        << std::strerror(errno) << "\n";
+  }
+  struct stat st;
+  if (::fstat(fd, &st) != 0 || std::size_t(st.st_size) < sizeof(Header)) {
+    ::close(fd);
+    throw cet::exception("DBSNAPSHOT_BAD_FILE")
+        << "DbSnapshot file " << fileName << " is too short\n";
+  }
+  _size = st.st_size;
+  void* addr = ::mmap(nullptr, _size, PROT_READ, MAP_PRIVATE, fd, 0);
+  ::close(fd);  // the mapping stays valid
+  if (addr == MAP_FAILED) {
+    throw cet::exception("DBSNAPSHOT_OPEN_FAILED")
+        << "DbSnapshot could not map " << fileName << " : "
+        << std::strerror(errno) << "\n";
+  }
+  _data = static_cast<char const*>(addr);
+
+  Header const& header = *at<Header>(0);
+  if (std::memcmp(header.magic, "MU2EDBSS", 8) != 0 ||
+      header.format != _format || header.byteOrder != _byteOrder ||
+      header.tableOffset % 8 != 0 ||
+      !inFile(header.tableOffset, header.ntable, sizeof(TableEntry)) ||
+      !inFile(header.purposeOffset, header.purposeSize) ||
+      !inFile(header.versionOffset, header.versionSize)) {
+    ::munmap(const_cast<char*>(_data), _size);
+    throw cet::exception("DBSNAPSHOT_BAD_FILE")
+        << "DbSnapshot file " << fileName
+        << " is not a snapshot of format " << _format
+        << " in the byte order of this machine\n";
+  }
+
+  _purpose = stringAt(header.purposeOffset, header.purposeSize);
+  _version = stringAt(header.versionOffset, header.versionSize);
+  _entries = at<TableEntry>(header.tableOffset);
+  for (std::size_t i = 0; i < header.ntable; i++) {
+    TableEntry const& e = _entries[i];
+    if (!validEntry(e)) {
+      ::munmap(const_cast<char*>(_data), _size);
+      throw cet::exception("DBSNAPSHOT_BAD_FILE")
+          << "DbSnapshot file " << fileName << " table entry " << i
+          << " points outside the file\n";
+    }
+    if (e.cid < 0) {
+      _vals[stringAt(e.nameOffset, e.nameSize)] = i;
+    } else {
+      _cids[e.cid] = i;
+    }
+  }
+}
+
+mu2e::DbSnapshot::~DbSnapshot() {
+  if (_data) ::munmap(const_cast<char*>(_data), _size);
+}
+
+std::vector<int> mu2e::DbSnapshot::cids() const {
+  std::vector<int> cids;
+  cids.reserve(_cids.size());
+  for (auto const& p : _cids) cids.push_back(p.first);
+  std::sort(cids.begin(), cids.end());
+  return cids;
+}
+
+std::string mu2e::DbSnapshot::tableName(int cid) const {
+  auto it = _cids.find(cid);
+  if (it == _cids.end()) return std::string();
+  TableEntry const& e = _entries[it->second];
+  return stringAt(e.nameOffset, e.nameSize);
+}
+
+std::string mu2e::DbSnapshot::csv(int cid) const {
+  auto it = _cids.find(cid);
+  if (it == _cids.end()) return std::string();
+  return columns(_entries[it->second]).csv();
+}
+
+bool mu2e::DbSnapshot::validEntry(TableEntry const& entry) const {
+  if (!inFile(entry.nameOffset, entry.nameSize)) return false;
+  if (entry.columnOffset % 8 != 0 ||
+      !inFile(entry.columnOffset, entry.ncol, sizeof(ColumnEntry)))
+    return false;
+  if (entry.nrow >= _size / sizeof(uint64_t)) return false;
+  ColumnEntry const* ce = at<ColumnEntry>(entry.columnOffset);
+  for (std::size_t icol = 0; icol < entry.ncol; icol++) {
+    ColumnEntry const& c = ce[icol];
+    if (c.type > DbColumns::Text) return false;
+    if (c.type != DbColumns::Text &&
+        (c.valueOffset % 8 != 0 || !inFile(c.valueOffset, entry.nrow, 8)))
+      return false;
+    if (c.offsetOffset % 8 != 0 ||
+        !inFile(c.offsetOffset, entry.nrow + 1, sizeof(uint64_t)))
+      return false;
+    // the field offsets must increase and end inside the text
+    uint64_t const* offsets = at<uint64_t>(c.offsetOffset);
+    if (!inFile(c.textOffset, offsets[entry.nrow])) return false;
+    for (std::size_t irow = 0; irow < entry.nrow; irow++) {
+      if (offsets[irow] > offsets[irow + 1]) return false;
+    }
+  }
+  return true;
+}
+
+mu2e::DbColumns mu2e::DbSnapshot::columns(TableEntry const& entry) const {
+  std::vector<DbColumns::Column> cols;
+  cols.reserve(entry.ncol);
+  ColumnEntry const* ce = at<ColumnEntry>(entry.columnOffset);
+  for (std::size_t icol = 0; icol < entry.ncol; icol++) {
+    DbColumns::Column c;
+    c.type = DbColumns::colType(ce[icol].type);
+    c.ints = c.type == DbColumns::Int ? at<int64_t>(ce[icol].valueOffset)
+                                      : nullptr;
+    c.floats = c.type == DbColumns::Float ? at<double>(ce[icol].valueOffset)
+                                          : nullptr;
+    c.offsets = at<uint64_t>(ce[icol].offsetOffset);
+    c.text = at<char>(ce[icol].textOffset);
+    cols.push_back(c);
+  }
+  return DbColumns(entry.nrow, cols);
+}
+
+void mu2e::DbSnapshot::fillValCache(DbValCache& vcache, bool saveCsv) const {
+  auto fillVal = [&](DbTable& table) {
+    auto it = _vals.find(table.name());
+    if (it == _vals.end()) {
+      throw cet::exception("DBSNAPSHOT_MISSING_TABLE")
+          << "DbSnapshot file " << _fileName << " has no " << table.name()
+          << "\n";
+    }
+    table.fill(columns(_entries[it->second]), saveCsv);
+  };
+
+  ValTables tables;
+  fillVal(tables);
+  vcache.setValTables(tables);
+  ValCalibrations calibrations;
+  fillVal(calibrations);
+  vcache.setValCalibrations(calibrations);
+  ValIovs iovs;
+  fillVal(iovs);
+  vcache.setValIovs(iovs);
+  ValGroups groups;
+  fillVal(groups);
+  vcache.setValGroups(groups);
+  ValGroupLists grouplists;
+  fillVal(grouplists);
+  vcache.setValGroupLists(grouplists);
+  ValPurposes purposes;
+  fillVal(purposes);
+  vcache.setValPurposes(purposes);
+  ValLists lists;
+  fillVal(lists);
+  vcache.setValLists(lists);
+  ValTableLists tablelists;
+  fillVal(tablelists);
+  vcache.setValTableLists(tablelists);
+  ValVersions versions;
+  fillVal(versions);
+  vcache.setValVersions(versions);
+  ValExtensions extensions;
+  fillVal(extensions);
+  vcache.setValExtensions(extensions);
+  ValExtensionLists extensionlists;
+  fillVal(extensionlists);
+  vcache.setValExtensionLists(extensionlists);
+}
+
+int mu2e::DbSnapshot::fillTable(DbTable::ptr_t const& ptr, int cid,
+                                bool saveCsv) const {
+  auto it = _cids.find(cid);
+  if (it == _cids.end()) return 1;
+  TableEntry const& e = _entries[it->second];
+  if (stringAt(e.nameOffset, e.nameSize) != ptr->name()) {
+    throw cet::exception("DBSNAPSHOT_WRONG_TABLE")
+        << "DbSnapshot cid " << cid << " holds "
+        << stringAt(e.nameOffset, e.nameSize) << ", not " << ptr->name()
+        << "\n";
+  }
+  ptr->fill(columns(e), saveCsv);
+  return 0;
+}
+
+void mu2e::DbSnapshot::write(std::string const& fileName,
+                             DbVersion const& version,
+                             DbValCache const& vcache,
+                             DbTableCollection const& coll) {
+  Buffer buf;
+  Header header;
+  std::memset(&header, 0, sizeof(header));
+  buf.append(&header, sizeof(header));  // filled at the end
+
+  std::vector<TableEntry> entries;
+
+  auto addTable = [&](DbTable const& table, int tid, int cid) {
+    if (table.nrow() > 0 && table.csv().empty()) {
+      throw cet::exception("DBSNAPSHOT_NO_CSV")
+          << "DbSnapshot::write table " << table.name() << " cid " << cid
+          << " was not filled with saveCsv\n";
+    }
+    std::vector<std::vector<std::string>> rows;
+    for (auto const& line : DbUtil::splitCsvLines(table.csv())) {
+      rows.emplace_back(DbUtil::splitCsv(line));
+      if (rows.back().size() != rows.front().size()) {
+        throw cet::exception("DBSNAPSHOT_BAD_COLUMN_COUNT")
+            << "DbSnapshot::write found " << rows.back().size()
+            << " columns when " << rows.front().size()
+            << " was seen in previous rows of " << table.name() << "\n";
+      }
+    }
+    std::size_t nrow = rows.size();
+    std::size_t ncol = rows.empty() ? 0 : rows.front().size();
+
+    std::vector<ColumnEntry> cols(ncol);
+    std::vector<int64_t> ints(nrow);
+    std::vector<double> floats(nrow);
+    std::vector<uint64_t> offsets(nrow + 1);
+    std::string text;
+    for (std::size_t icol = 0; icol < ncol; icol++) {
+      bool isInt = true;
+      bool isFloat = true;
+      text.clear();
+      for (std::size_t irow = 0; irow < nrow; irow++) {
+        std::string const& field = rows[irow][icol];
+        isInt = isInt && parseInt(field, ints[irow]);
+        isFloat = isFloat && parseFloat(field, floats[irow]);
+        offsets[irow] = text.size();
+        text.append(field);
+      }
+      offsets[nrow] = text.size();
+
+      ColumnEntry& ce = cols[icol];
+      ce.valueOffset = 0;
+      if (isInt) {
+        ce.type = DbColumns::Int;
+        ce.valueOffset = buf.append(ints);
+      } else if (isFloat) {
+        ce.type = DbColumns::Float;
+        ce.valueOffset = buf.append(floats);
+      } else {
+        ce.type = DbColumns::Text;
+      }
+      ce.offsetOffset = buf.append(offsets);
+      ce.textOffset = buf.append(text);
+    }
+
+    TableEntry e;
+    e.tid = tid;
+    e.cid = cid;
+    e.nrow = nrow;
+    e.ncol = ncol;
+    e.nameOffset = buf.append(table.name());
+    e.nameSize = table.name().size();
+    e.columnOffset = buf.append(cols);
+    entries.push_back(e);
+  };
+
+  for (auto const& name : valNames) addTable(vcache.asTable(name), -1, -1);
+
+  std::set<int> done;
+  for (auto const& lt : coll) {
+    if (!done.insert(lt.cid()).second) continue;
+    addTable(lt.table(), lt.tid(), lt.cid());
+  }
+
+  std::string vstr = std::to_string(version.major()) + "_" +
+                     std::to_string(version.minor()) + "_" +
+                     std::to_string(version.extension());
+  std::memcpy(header.magic, "MU2EDBSS", 8);
+  header.format = _format;
+  header.byteOrder = _byteOrder;
+  header.ntable = entries.size();
+  header.purposeOffset = buf.append(version.purpose());
+  header.purposeSize = version.purpose().size();
+  header.versionOffset = buf.append(vstr);
+  header.versionSize = vstr.size();
+  header.tableOffset = buf.append(entries);
+  buf.overwrite(0, &header, sizeof(header));
+
+  std::ofstream out(fileName, std::ios::binary | std::ios::trunc);
+  out.write(buf.bytes().data(), buf.bytes().size());
+  out.close();
+  if (!out) {
+    throw cet::exception("DBSNAPSHOT_WRITE_FAILED")
+        << "DbSnapshot::write could not write " << fileName << "\n";
+  }
+}
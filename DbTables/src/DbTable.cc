@@ -20,13 +20,7 @@ int mu2e::DbTable::fill(const std::string& csv, bool saveCsv) {
     addRow(columns);
   }
 
-  // if this table has a fixed number of rows, check that
-  if (nrowFix() > 0 && nrow() != nrowFix()) {
-    throw cet::exception("DBTABLE_BAD_ROW_COUNT")
-        << "DbTable::fill csv line counts is " << std::to_string(nrow())
-        << " but " << std::to_string(nrowFix()) << " is required while filling "
-        << name();
-  }
+  checkRowCount();
 
   // save the plain text
   if (saveCsv) {
@@ -38,6 +32,39 @@ int mu2e::DbTable::fill(const std::string& csv, bool saveCsv) {
   return 0;
 }
 
+int mu2e::DbTable::fill(DbColumns const& columns, bool saveCsv) {
+  if (!fillColumns(columns)) {
+    std::vector<std::string> row(columns.ncol());
+    for (std::size_t irow = 0; irow < columns.nrow(); irow++) {
+      for (std::size_t icol = 0; icol < columns.ncol(); icol++) {
+        row[icol].assign(columns.textAt(icol, irow));
+      }
+      addRow(row);
+    }
+  }
+
+  checkRowCount();
+
+  // the text is only rebuilt if it is requested
+  if (saveCsv) {
+    _csv = columns.csv();
+  } else {
+    _csv.clear();
+  }
+
+  return 0;
+}
+
+void mu2e::DbTable::checkRowCount() const {
+  // if this table has a fixed number of rows, check that
+  if (nrowFix() > 0 && nrow() != nrowFix()) {
+    throw cet::exception("DBTABLE_BAD_ROW_COUNT")
+        << "DbTable::fill csv line counts is " << std::to_string(nrow())
+        << " but " << std::to_string(nrowFix()) << " is required while filling "
+        << name();
+  }
+}
+
 int mu2e::DbTable::toCsv() {
   if (!_csv.empty()) return 0;
   std::ostringstream ss;
@@ -61,6 +61,12 @@ namespace mu2e {
                       const std::string& resolvedFileName,
                       const BFieldConfig& config);
 
+        // Create a new magnetic field map that uses a .bfmap file in place.
+        void loadMapped(MapContainerType& whichMap,
+                        const std::string& key,
+                        const std::string& resolvedFileName,
+                        const BFieldConfig& config);
+
         // Read a G4BL text format map.
         void readG4BLMap(const std::string& filename, BFGridMap& bfmap,
                          CLHEP::Hep3Vector offset);
@@ -73,6 +79,9 @@ namespace mu2e {
 
         // Write an existing BFMap in binary format.
         void writeG4BLBinary(const BFGridMap& bf, const std::string& outputfile);
+
+        // Write an existing BFMap in the mapped (.bfmap) format.
+        void writeMappedMap(const BFGridMap& bf, const std::string& outputfile);
         void flipMap(BFGridMap& bf);
 
     };  // end class BFieldManagerMaker
@@ -43,8 +43,12 @@ namespace mu2e {
     BFieldConfigMaker::BFieldConfigMaker(const SimpleConfig& config, const Beamline& beamg)
         : bfconf_(new BFieldConfig()) {
         bfconf_->writeBinaries_ = config.getBool("bfield.writeG4BLBinaries", false);
+        bfconf_->writeMappedMaps_ = config.getBool("bfield.writeMappedMaps", false);
+        bfconf_->verifyMappedMaps_ = config.getBool("bfield.verifyMappedMaps", false);
         bfconf_->verbosityLevel_ = config.getInt("bfield.verbosityLevel");
         bfconf_->flipBFieldMaps_ = config.getBool("bfield.flipMaps", false);
+        bfconf_->brickedStorage_ = config.getBool("bfield.brickedStorage", false);
+        bfconf_->spatialIndex_ = config.getBool("bfield.spatialIndex", false);
 
         bfconf_->scaleFactor_ = config.getDouble("bfield.scaleFactor", 1.0);
 
@@ -31,6 +31,7 @@
 // Includes from Mu2e
 #include "Offline/BFieldGeom/inc/BFInterpolationStyle.hh"
 #include "Offline/BFieldGeom/inc/BFieldConfig.hh"
+#include "Offline/BFieldGeom/inc/BFMappedFile.hh"
 #include "Offline/BFieldGeom/inc/BFieldManager.hh"
 #include "Offline/GeneralUtilities/inc/MinMax.hh"
 #include "Offline/GeometryService/inc/BFieldManagerMaker.hh"
@@ -136,7 +137,7 @@ namespace mu2e {
           constOuterMaps.emplace_back(mapptr);
         }
 
-        _bfmgr = std::unique_ptr<BFieldManager>(new BFieldManager(constInnerMaps,constOuterMaps));
+        _bfmgr = std::unique_ptr<BFieldManager>(new BFieldManager(constInnerMaps,constOuterMaps,config.spatialIndex()));
 
         if (config.writeBinaries()) {
           for (auto mapptr : innerMaps ) {
@@ -148,6 +149,16 @@ namespace mu2e {
             }
         }
 
+        if (config.writeMappedMaps()) {
+          for (auto mapptr : innerMaps ) {
+                writeMappedMap(dynamic_cast<const BFGridMap&>(*mapptr), mapptr->getKey() + ".bfmap");
+            }
+
+          for (auto mapptr : outerMaps) {
+                writeMappedMap(dynamic_cast<const BFGridMap&>(*mapptr), mapptr->getKey() + ".bfmap");
+            }
+        }
+
         // For debug purposes: print the field in the target region
         if (bfieldVerbosityLevel > 0) {
             CLHEP::Hep3Vector b = _bfmgr->getBField(CLHEP::Hep3Vector(3900.0, 0.0, -6550.0));
@@ -377,6 +388,12 @@ namespace mu2e {
                                       const std::string& resolvedFileName,
                                       const BFieldConfig& config) {
 
+        // Maps in the mapped format carry their own header.
+        if (resolvedFileName.find(".bfmap") != string::npos) {
+            loadMapped(mapContainer, key, resolvedFileName, config);
+            return;
+        }
+
         // Extract information from the header.
         vector<double> X0;
         vector<int> dim;
@@ -402,11 +419,50 @@ namespace mu2e {
 
         if(config.flipBFieldMaps()) flipMap(*dsmap);
 
+        if (config.brickedStorage()) {
+            dsmap->buildBrickedField();
+            if (bfieldVerbosityLevel > 0) {
+                cout << "Bricked copy of " << key << " uses "
+                     << dsmap->brickedField().memoryUsed() << " bytes" << endl;
+            }
+        }
+
         mapContainer.emplace_back(dsmap);
 
     }
 
 
+    // Create a map that uses the field values in the file in place.
+    void BFieldManagerMaker::loadMapped(MapContainerType& mapContainer,
+                                        const std::string& key,
+                                        const std::string& resolvedFileName,
+                                        const BFieldConfig& config) {
+
+        auto file = std::make_shared<const BFMappedFile>(resolvedFileName, config.verifyMappedMaps());
+        auto dsmap = std::make_shared<BFGridMap>(key, file,
+                                                 BFMapType::G4BL,
+                                                 config.scaleFactor(),
+                                                 config.interpolationStyle());
+
+        // The mapping is read-only; flip the map when making the .bfmap file instead.
+        if (config.flipBFieldMaps()) {
+            throw cet::exception("GEOM")
+                << "BFieldManagerMaker: cannot flip the mapped field map " << resolvedFileName
+                << "\nMake the .bfmap file from a map that was flipped when it was read.\n";
+        }
+
+        if (config.brickedStorage()) {
+            dsmap->buildBrickedField();
+        }
+
+        if (bfieldVerbosityLevel > 1) {
+            std::cout << "BFieldManagerMaker: mapped " << file->header().dataSize
+                      << " bytes of field values from " << resolvedFileName << std::endl;
+        }
+
+        mapContainer.emplace_back(dsmap);
+    }
+
     //
     // Read one magnetic field map file in G4BL (TD) format.
     //
@@ -717,7 +773,7 @@ namespace mu2e {
         unsigned int deadbeef(0XDEADBEEF);
 
         // Address of the first element in the big array.
-        CLHEP::Hep3Vector const* fieldAddr = &bf._field.get(0, 0, 0);
+        CLHEP::Hep3Vector const* fieldAddr = bf.fieldData();
 
         // Open the output file.
         mode_t mode = S_IRUSR | S_IWUSR | S_IRGRP | S_IROTH;
@@ -762,6 +818,19 @@ namespace mu2e {
     }  // end BFieldManagerMaker::writeG4BLBinary
 
 
+    void BFieldManagerMaker::writeMappedMap(const BFGridMap& bf, const std::string& outputfile) {
+        cout << "Writing G4BL Magnetic field map in mapped format to file: " << outputfile << endl;
+
+        BFMappedFile::write(outputfile,
+                            bf.nx(), bf.ny(), bf.nz(),
+                            bf.xmin(), bf.ymin(), bf.zmin(),
+                            bf.dx(), bf.dy(), bf.dz(),
+                            bf._flipy,
+                            bf.fieldData());
+
+        cout << "Writing complete for file: " << outputfile << endl;
+    }
+
     void BFieldManagerMaker::flipMap(BFGridMap& bf) {
         std::cout << "Flipping B field vector in map " << bf.getKey() << std::endl;
         for (size_t ix = 0; ix < bf.nx(); ++ix) {
@@ -103,6 +103,14 @@ namespace mu2e {
       return mgr;
     }
 
+    // Create the equation of motion and the G4 stepper selected by name (the Mu2eG4 physics.stepper
+    // names), for the given field.  The "WSpin" variants use G4Mag_SpinEqRhs.  The caller owns
+    // both the returned stepper and rhs.  Throws for unknown names.
+    static G4MagIntegratorStepper* createStepper(const std::string& stepperName,
+                                                 G4MagneticField* field,
+                                                 G4Mag_EqRhs*& rhs,
+                                                 int verbosityLevel=0);
+
     // Release all of the objects that this class owns.
     void release();
 
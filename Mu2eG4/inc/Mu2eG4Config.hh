@@ -44,6 +44,8 @@ namespace mu2e {
       fhicl::OptionalTuple<int,double,int> ionToGenerate { Name("ionToGenerate") };
 
       fhicl::Atom<int> checkFieldMap {Name("checkFieldMap"), 0 };
+      fhicl::Atom<bool> printBFieldCacheStats {Name("printBFieldCacheStats"),
+          Comment("Print the field map lookup counters of each thread at the end of each run"), false };
 
       fhicl::Atom<bool> printElements {Name("printElements"), Comment("Print elements from constructMaterials()")};
       fhicl::Atom<bool> printMaterials {Name("printMaterials"), Comment("Print materials from constructMaterials()")};
@@ -97,6 +99,19 @@ namespace mu2e {
       fhicl::Atom<size_t> minTrackerStepPoints {Name("minTrackerStepPoints"), 15};
     };
 
+    struct FieldRegion {
+      using Name = fhicl::Name;
+      using Comment = fhicl::Comment;
+      fhicl::Sequence<std::string> volumes {Name("volumes"),
+          Comment("Logical volumes given this field manager; their daughters get it too")};
+      fhicl::Atom<std::string> field {Name("field"),
+          Comment("map, uniform (the map value at the center of the first volume) or zero"), "map"};
+      fhicl::Atom<std::string> stepper {Name("stepper"),
+          Comment("As physics.stepper; uniform fields always use G4ExactHelixStepper"), "G4DormandPrince745"};
+      fhicl::Atom<double> cacheDistance {Name("cacheDistance"),
+          Comment("In mm. Reuse the last field map value within this distance; 0 disables the cache"), 0.};
+    };
+
     struct Physics {
       using Name = fhicl::Name;
       using Comment = fhicl::Comment;
@@ -110,6 +125,8 @@ namespace mu2e {
       fhicl::Atom<double> deltaChord {Name("deltaChord"), Comment("In mm")};
       fhicl::Atom<double> stepMinimum {Name("stepMinimum"), Comment("In mm")};
       fhicl::Atom<int> maxIntSteps {Name("maxIntSteps")};
+      fhicl::OptionalSequence<fhicl::Table<FieldRegion>> fieldRegions {Name("fieldRegions"),
+          Comment("Field managers for regions of the world, overriding the global field manager")};
       fhicl::Atom<double> bfieldMaxStep {Name("bfieldMaxStep"), Comment("In mm")};
       fhicl::Atom<double> strawGasMaxStep {Name("strawGasMaxStep"), Comment("In mm")};
       fhicl::Atom<bool> limitStepInAllVolumes {Name("limitStepInAllVolumes")};
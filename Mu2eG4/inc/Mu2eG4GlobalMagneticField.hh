@@ -36,6 +36,9 @@ namespace mu2e {
     // the map or the offset changes (begin run probably).
     void update( const G4ThreeVector& mapOrigin );
 
+    // Counters of the field map lookups done by this instance.
+    const BFCacheManager::Stats& cacheStats() const { return _cache.stats(); }
+
   private:
     // The map is stored in the Mu2e coordinate system.
     // This is the location of the origin the Mu2e system, measured in the G4 world system.
@@ -44,8 +47,9 @@ namespace mu2e {
     // Non-owning pointer to the field map object (it is owned by the geometry service).
     const BFieldManager* _map;
 
-    // A copy of the bfield cache manager - must be thread local.
-    BFCacheManager _cm;
+    // Memory of the last field map used.  G4 makes one instance of this class per
+    // thread, so this is thread local.
+    mutable BFCacheManager::Cache _cache;
 
   };
 }
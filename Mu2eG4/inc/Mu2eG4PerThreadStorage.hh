@@ -12,6 +12,7 @@
 #include "Offline/Mu2eG4/inc/Mu2eG4IOConfigHelper.hh"
 #include "Offline/Mu2eG4/inc/SimParticleHelper.hh"
 #include "Offline/Mu2eG4/inc/SimParticlePrimaryHelper.hh"
+#include "Offline/Mu2eG4/inc/SimParticleStore.hh"
 #include "Offline/Mu2eG4/inc/IMu2eG4Cut.hh"
 #include "Offline/MCDataProducts/inc/GenParticle.hh"
 #include "Offline/MCDataProducts/inc/StatusG4.hh"
@@ -95,6 +96,11 @@ namespace mu2e {
 
     std::unordered_map< std::string, std::unique_ptr<StepPointMCCollection> > sensitiveDetectorSteps;
 
+    // SimParticles of the current event while G4 runs; moved into simPartCollection
+    // at the end of the event.  Kept for the lifetime of the thread so that its
+    // buffers are reused from event to event.
+    SimParticleStore simParticleStore;
+
     std::unique_ptr<IMu2eG4Cut> stackingCuts = nullptr;
     std::unique_ptr<IMu2eG4Cut> steppingCuts = nullptr;
     std::unique_ptr<IMu2eG4Cut> commonCuts = nullptr;
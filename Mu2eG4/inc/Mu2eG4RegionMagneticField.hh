@@ -0,0 +1,79 @@
+#ifndef Mu2eG4_Mu2eG4RegionMagneticField_hh
+#define Mu2eG4_Mu2eG4RegionMagneticField_hh
+//
+// G4 interface to the magnetic field of one region of the world, used by the
+// field managers of Mu2eG4Config physics.fieldRegions.
+//
+// The field is either looked up in the Mu2e field maps, or is a uniform field
+// with the map value at a reference point.  For the field maps an optional
+// distance cache returns the previous value when the point is within
+// cacheDistance of the previous lookup, as G4CachedMagneticField does.
+// Calls and field map evaluations are counted for the end of run report.
+//
+// G4 makes one instance of each region field per thread.
+//
+
+#include <ostream>
+#include <string>
+
+#include "Offline/Mu2eG4/inc/Mu2eG4GlobalMagneticField.hh"
+
+#include "Geant4/G4MagneticField.hh"
+#include "Geant4/G4Types.hh"
+#include "Geant4/G4ThreeVector.hh"
+
+namespace mu2e {
+
+  class Mu2eG4RegionMagneticField: public G4MagneticField {
+
+  public:
+
+    // Field from the maps, reusing the last value within cacheDistance (0 disables the cache).
+    Mu2eG4RegionMagneticField(const std::string& name,
+                              const G4ThreeVector& mapOrigin,
+                              G4double cacheDistance);
+
+    // Uniform field with the map value at the reference point, given in the G4 world system.
+    Mu2eG4RegionMagneticField(const std::string& name,
+                              const G4ThreeVector& mapOrigin,
+                              const G4ThreeVector& referencePoint);
+
+    virtual ~Mu2eG4RegionMagneticField(){}
+
+    // This is called by G4.
+    virtual void GetFieldValue(const G4double Point[4],
+                               G4double *Bfield) const;
+
+    const std::string& name() const { return _name; }
+    bool isUniform() const { return _uniform; }
+    G4ThreeVector uniformValue() const { return G4ThreeVector(_lastField[0],_lastField[1],_lastField[2]); }
+
+    // Counters of this instance.
+    unsigned long nCalls()       const { return _nCalls; }
+    unsigned long nEvaluations() const { return _nEvaluations; }
+    void resetCounters() const { _nCalls = 0; _nEvaluations = 0; }
+    void print(std::ostream& os) const;
+
+  private:
+    std::string _name;
+    Mu2eG4GlobalMagneticField _map;
+    bool     _uniform;
+    G4double _cacheDistance2;
+
+    // The last point looked up in the map and its field; the uniform value for uniform fields.
+    mutable bool     _lastValid;
+    mutable G4double _lastPoint[3];
+    mutable G4double _lastField[3];
+
+    mutable unsigned long _nCalls;
+    mutable unsigned long _nEvaluations;
+
+  };
+
+  inline std::ostream& operator<<(std::ostream& os, const Mu2eG4RegionMagneticField& field) {
+    field.print(os);
+    return os;
+  }
+
+}
+#endif /* Mu2eG4_Mu2eG4RegionMagneticField_hh */
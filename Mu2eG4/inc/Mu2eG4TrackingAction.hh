@@ -16,6 +16,7 @@
 
 #include "Offline/Mu2eG4/inc/EventNumberList.hh"
 #include "Offline/Mu2eG4/inc/PhysicsProcessInfo.hh"
+#include "Offline/Mu2eG4/inc/SimParticleStore.hh"
 #include "Offline/DataProducts/inc/PDGCode.hh"
 
 #include "art/Framework/Principal/Event.h"
@@ -23,7 +24,6 @@
 #include "canvas/Persistency/Provenance/ProductID.h"
 #include "cetlib/cpu_timer.h"
 
-#include <map>
 #include <string>
 
 namespace mu2e {
@@ -76,7 +76,6 @@ namespace mu2e {
 
     typedef SimParticleCollection::key_type    key_type;
     typedef SimParticleCollection::mapped_type mapped_type;
-    typedef std::map<key_type,mapped_type>     map_type;
 
     // Lists of events and tracks for which to enable debug printout.
     EventNumberList _debugList;
@@ -93,9 +92,10 @@ namespace mu2e {
     // Event timer.
     cet::cpu_timer _timer;
 
-    // Information about SimParticles is collected in this map
+    // Information about SimParticles is collected in this store
     // during the operation of G4.  This is not persistent.
-    map_type _transientMap;
+    // The store is owned by the per thread storage.
+    SimParticleStore& _transientSims;
 
     // Limit maximum size of the steps collection
     unsigned _sizeLimit;
@@ -9,7 +9,6 @@
 
 
 // C++ includes
-#include <map>
 #include <string>
 
 // CLHEP includes
@@ -24,6 +23,7 @@
 // Mu2e includes
 
 #include "Offline/MCDataProducts/inc/SimParticle.hh"
+#include "Offline/Mu2eG4/inc/SimParticleStore.hh"
 
 class G4Track;
 class G4Step;
@@ -34,14 +34,13 @@ namespace mu2e {
 
     typedef SimParticleCollection::key_type    key_type;
     typedef SimParticleCollection::mapped_type mapped_type;
-    typedef std::map<key_type,mapped_type>     map_type;
 
     // Check consistency of mother-daughter pointers.
-    bool checkCrossReferences( bool doPrint, bool doThrow, map_type const& transientMap);
+    bool checkCrossReferences( bool doPrint, bool doThrow, SimParticleStore const& transientSims);
 
     // Debug printout.
     void printTrackInfo(G4Track const* const trk, std::string const& text,
-                        map_type const& transientMap,
+                        SimParticleStore const& transientSims,
                         cet::cpu_timer const& timer,
                         CLHEP::Hep3Vector const& mu2eOrigin,
                         bool isEnd=false, bool printTimers=true);
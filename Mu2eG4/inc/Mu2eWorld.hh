@@ -88,6 +88,7 @@ namespace mu2e {
     VolumeInfo constructCal();
     void constructMagnetYoke();
     void constructBFieldAndManagers();
+    void constructFieldRegions();
     void constructStepLimiters();
     void constructITStepLimiters();
 
@@ -0,0 +1,81 @@
+#ifndef Mu2eG4_SimParticleStore_hh
+#define Mu2eG4_SimParticleStore_hh
+//
+// Transient storage of the SimParticles of one event while G4 runs.
+//
+// SimParticle keys are the G4 track IDs plus the offset of the current simulation
+// stage, so they are dense: a particle is found by indexing a table of slots with
+// its key, instead of searching a tree.  The particles themselves are stored in a
+// vector in insertion order; at the end of the event they are moved, in key order,
+// into the SimParticleCollection.  The store is meant to be reused for all events
+// of a thread, so that its buffers are only allocated during the first events.
+//
+// Pointers returned by find() and operator[] are invalidated by the next insertion.
+//
+
+#include "Offline/MCDataProducts/inc/SimParticle.hh"
+
+#include <limits>
+#include <vector>
+
+namespace mu2e {
+
+  class SimParticleStore {
+  public:
+    typedef SimParticleCollection::key_type    key_type;
+    typedef SimParticleCollection::mapped_type mapped_type;
+    typedef SimParticleCollection::value_type  value_type;
+    typedef std::vector<value_type>::const_iterator const_iterator;
+
+    void reserve(size_t nparticles) { _particles.reserve(nparticles); }
+
+    bool   empty() const { return _particles.empty(); }
+    size_t size()  const { return _particles.size(); }
+
+    // Iteration is in insertion order.
+    const_iterator begin() const { return _particles.begin(); }
+    const_iterator end()   const { return _particles.end(); }
+
+    // Null if there is no particle with this key.
+    mapped_type*       find(key_type key);
+    mapped_type const* find(key_type key) const;
+
+    // Returns false, and leaves the store unchanged, if the key is already used.
+    bool insert(key_type key, mapped_type&& particle);
+
+    // Find, or insert a default constructed particle, as cet::map_vector does.
+    mapped_type& operator[](key_type key);
+
+    // Move all particles into the collection, in key order, and clear the store.
+    void moveTo(SimParticleCollection& out);
+
+    void clear();
+
+  private:
+    static constexpr unsigned noSlot = std::numeric_limits<unsigned>::max();
+
+    unsigned slot(key_type key) const {
+      auto ikey = key.asUint();
+      return ikey < _slots.size() ? _slots[ikey] : noSlot;
+    }
+    mapped_type& append(key_type key, mapped_type&& particle);
+
+    std::vector<value_type> _particles; // in insertion order
+    std::vector<unsigned>   _slots;     // index into _particles, by key
+    std::vector<value_type> _sorted;    // buffer to reorder the particles by key
+    bool _ordered = true;               // particles were inserted in increasing key order
+  };
+
+  inline SimParticleStore::mapped_type* SimParticleStore::find(key_type key) {
+    auto islot = slot(key);
+    return islot == noSlot ? nullptr : &_particles[islot].second;
+  }
+
+  inline SimParticleStore::mapped_type const* SimParticleStore::find(key_type key) const {
+    auto islot = slot(key);
+    return islot == noSlot ? nullptr : &_particles[islot].second;
+  }
+
+}
+
+#endif /* Mu2eG4_SimParticleStore_hh */
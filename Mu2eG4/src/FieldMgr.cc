@@ -11,6 +11,25 @@
 #include "Geant4/G4ExactHelixStepper.hh"
 #include "Geant4/G4ChordFinder.hh"
 #include "Geant4/G4FieldManager.hh"
+#include "Geant4/G4Mag_SpinEqRhs.hh"
+#include "Geant4/G4ClassicalRK4.hh"
+#include "Geant4/G4ImplicitEuler.hh"
+#include "Geant4/G4ExplicitEuler.hh"
+#include "Geant4/G4SimpleRunge.hh"
+#include "Geant4/G4SimpleHeum.hh"
+#include "Geant4/G4HelixImplicitEuler.hh"
+#include "Geant4/G4HelixSimpleRunge.hh"
+#if G4VERSION>4103
+#include "Geant4/G4DormandPrince745.hh"
+#include "Geant4/G4BogackiShampine23.hh"
+#endif
+#if G4VERSION>4106
+#include "Geant4/G4TDormandPrince45.hh"
+#endif
+#include "Geant4/globals.hh"
+
+// Framework includes
+#include "cetlib_except/exception.h"
 
 // Mu2e includes
 #include "Offline/Mu2eG4/inc/FieldMgr.hh"
@@ -64,6 +83,76 @@ namespace mu2e {
     return mgr;
   }
 
+  // Create the equation of motion and the stepper selected by name. See notes in header file.
+  G4MagIntegratorStepper* FieldMgr::createStepper(const std::string& stepperName,
+                                                  G4MagneticField* field,
+                                                  G4Mag_EqRhs*& rhs,
+                                                  int verbosityLevel){
+
+    G4MagIntegratorStepper * stepper = nullptr;
+    rhs = nullptr;
+    if ( verbosityLevel > 0 ) G4cout << __func__ << " Setting up " << stepperName << " stepper" << G4endl;
+
+    // the spin variants integrate 12 variables with the spin equation of motion
+    if ( stepperName  == "G4ClassicalRK4WSpin" ) {
+      rhs = new G4Mag_SpinEqRhs(field);
+      stepper = new G4ClassicalRK4(rhs, 12);
+#if G4VERSION>4103
+    } else if ( stepperName  == "G4DormandPrince745WSpin" ) {
+      rhs = new G4Mag_SpinEqRhs(field);
+      stepper = new G4DormandPrince745(rhs, 12);
+#endif
+#if G4VERSION>4106
+    } else if ( stepperName  == "G4TDormandPrince45WSpin" ) {
+      rhs = new G4Mag_SpinEqRhs(field);
+      stepper = new G4TDormandPrince45(rhs, 12);
+#endif
+    }
+    if ( stepper != nullptr ) {
+      if ( verbosityLevel > 0) {
+        G4cout << __func__ << " Used G4Mag_SpinEqRhs for " << stepperName << G4endl;
+      }
+      return stepper;
+    }
+
+    rhs = new G4Mag_UsualEqRhs(field);
+    if ( stepperName  == "G4ClassicalRK4" ) {
+      stepper = new G4ClassicalRK4(rhs);
+    } else if ( stepperName  == "G4ImplicitEuler" ) {
+      stepper = new G4ImplicitEuler(rhs);
+    } else if ( stepperName  == "G4ExplicitEuler" ) {
+      stepper = new G4ExplicitEuler(rhs);
+    } else if ( stepperName  == "G4SimpleHeum" ) {
+      stepper = new G4SimpleHeum(rhs);
+    } else if ( stepperName  == "G4HelixImplicitEuler" ) {
+      stepper = new G4HelixImplicitEuler(rhs);
+    } else if ( stepperName  == "G4HelixSimpleRunge" ) {
+      stepper = new G4HelixSimpleRunge(rhs);
+    } else if ( stepperName  == "G4ExactHelixStepper" ) {
+      stepper = new G4ExactHelixStepper(rhs);
+#if G4VERSION>4103
+    } else if ( stepperName  == "G4DormandPrince745" ) {
+      stepper = new G4DormandPrince745(rhs);
+    } else if ( stepperName  == "G4BogackiShampine23" ) {
+      stepper = new G4BogackiShampine23(rhs);
+#endif
+#if G4VERSION>4106
+    } else if ( stepperName  == "G4TDormandPrince45" ) {
+      stepper = new G4TDormandPrince45(rhs);
+#endif
+    } else if ( stepperName  == "G4SimpleRunge" ) {
+      stepper = new G4SimpleRunge(rhs);
+    } else {
+      delete rhs;
+      rhs = nullptr;
+      throw cet::exception("GEOM")
+        << "Unrecognized stepper : "
+        << stepperName
+        << "\n";
+    }
+    return stepper;
+  }
+
   // Release all of the objects that this class owns.
   void FieldMgr::release(){
     _field.release();
@@ -0,0 +1,77 @@
+//
+// G4 interface to the magnetic field of one region of the world.
+//
+
+#include "Offline/Mu2eG4/inc/Mu2eG4RegionMagneticField.hh"
+
+#include "CLHEP/Units/SystemOfUnits.h"
+
+namespace mu2e {
+
+  Mu2eG4RegionMagneticField::Mu2eG4RegionMagneticField(const std::string& name,
+                                                       const G4ThreeVector& mapOrigin,
+                                                       G4double cacheDistance):
+    _name(name),
+    _map(mapOrigin),
+    _uniform(false),
+    _cacheDistance2(cacheDistance*cacheDistance),
+    _lastValid(false),
+    _lastPoint{0.,0.,0.},
+    _lastField{0.,0.,0.},
+    _nCalls(0),
+    _nEvaluations(0){
+  }
+
+  Mu2eG4RegionMagneticField::Mu2eG4RegionMagneticField(const std::string& name,
+                                                       const G4ThreeVector& mapOrigin,
+                                                       const G4ThreeVector& referencePoint):
+    _name(name),
+    _map(mapOrigin),
+    _uniform(true),
+    _cacheDistance2(0.),
+    _lastValid(true),
+    _lastPoint{referencePoint.x(),referencePoint.y(),referencePoint.z()},
+    _lastField{0.,0.,0.},
+    _nCalls(0),
+    _nEvaluations(0){
+    const G4double point[4] = {referencePoint.x(),referencePoint.y(),referencePoint.z(),0.};
+    _map.GetFieldValue(point,_lastField);
+  }
+
+  void Mu2eG4RegionMagneticField::GetFieldValue(const G4double Point[4],
+                                                G4double *Bfield) const {
+    ++_nCalls;
+    if ( !_uniform ){
+      bool reuse = false;
+      if ( _lastValid && _cacheDistance2 > 0. ){
+        G4double dx = Point[0]-_lastPoint[0];
+        G4double dy = Point[1]-_lastPoint[1];
+        G4double dz = Point[2]-_lastPoint[2];
+        reuse = dx*dx + dy*dy + dz*dz < _cacheDistance2;
+      }
+      if ( !reuse ){
+        ++_nEvaluations;
+        _map.GetFieldValue(Point,_lastField);
+        _lastPoint[0] = Point[0];
+        _lastPoint[1] = Point[1];
+        _lastPoint[2] = Point[2];
+        _lastValid = true;
+      }
+    }
+    Bfield[0] = _lastField[0];
+    Bfield[1] = _lastField[1];
+    Bfield[2] = _lastField[2];
+  }
+
+  void Mu2eG4RegionMagneticField::print(std::ostream& os) const {
+    os << "field region " << _name;
+    if ( _uniform ){
+      os << " uniform field " << uniformValue()/CLHEP::tesla << " T";
+    }
+    os << " calls " << _nCalls << " map evaluations " << _nEvaluations;
+    if ( _nCalls > 0 ){
+      os << " (" << double(_nEvaluations)/double(_nCalls) << " per call)";
+    }
+  }
+
+}
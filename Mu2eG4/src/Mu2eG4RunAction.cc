@@ -7,6 +7,8 @@
 
 //Mu2e includes
 #include "Offline/Mu2eG4/inc/Mu2eG4RunAction.hh"
+#include "Offline/Mu2eG4/inc/Mu2eG4GlobalMagneticField.hh"
+#include "Offline/Mu2eG4/inc/Mu2eG4RegionMagneticField.hh"
 #include "Offline/Mu2eG4/inc/PhysicalVolumeHelper.hh"
 #include "Offline/Mu2eG4/inc/PhysicsProcessInfo.hh"
 #include "Offline/Mu2eG4/inc/Mu2eG4TrackingAction.hh"
@@ -15,12 +17,19 @@
 #include "Offline/Mu2eG4/inc/SensitiveDetectorName.hh"
 
 //G4 includes
+#include "Geant4/G4FieldManager.hh"
+#include "Geant4/G4LogicalVolume.hh"
+#include "Geant4/G4LogicalVolumeStore.hh"
 #include "Geant4/G4RunManager.hh"
+#include "Geant4/G4Threading.hh"
 #include "Geant4/G4TransportationManager.hh"
 
 //CLHEP includes
 #include "CLHEP/Vector/ThreeVector.h"
 
+//C++ includes
+#include <set>
+
 using namespace std;
 
 namespace mu2e {
@@ -85,6 +94,34 @@ namespace mu2e {
   void Mu2eG4RunAction::EndOfRunAction(const G4Run* aRun)
   {
     _processInfo->endRun();
+
+    if (debug_.printBFieldCacheStats()) {
+      // the transportation manager, and so the global field, are thread local
+      G4FieldManager const* fm = G4TransportationManager::GetTransportationManager()->GetFieldManager();
+      auto field = dynamic_cast<Mu2eG4GlobalMagneticField const*>(fm ? fm->GetDetectorField() : nullptr);
+      if (field) {
+        G4cout << "Mu2eG4RunAction " << __func__ << " : G4Run: " << aRun->GetRunID()
+               << " thread " << G4Threading::G4GetThreadId() << " "
+               << field->cacheStats() << G4endl;
+      }
+
+      // the field managers of the physics.fieldRegions, shared by their volumes
+      std::set<Mu2eG4RegionMagneticField const*> regions;
+      for (auto const* lv : *G4LogicalVolumeStore::GetInstance()) {
+        G4FieldManager const* lvfm = lv->GetFieldManager();
+        auto region = dynamic_cast<Mu2eG4RegionMagneticField const*>(lvfm ? lvfm->GetDetectorField() : nullptr);
+        if (region == nullptr || !regions.insert(region).second) continue;
+        G4cout << "Mu2eG4RunAction " << __func__ << " : G4Run: " << aRun->GetRunID()
+               << " thread " << G4Threading::G4GetThreadId() << " "
+               << *region;
+        if (aRun->GetNumberOfEvent() > 0) {
+          G4cout << " calls/event " << double(region->nCalls())/aRun->GetNumberOfEvent()
+                 << " evaluations/event " << double(region->nEvaluations())/aRun->GetNumberOfEvent();
+        }
+        G4cout << G4endl;
+        region->resetCounters();
+      }
+    }
   }
 
 }  // end namespace mu2e
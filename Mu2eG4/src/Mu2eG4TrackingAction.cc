@@ -75,6 +75,7 @@ namespace mu2e {
     _physVolHelper(0),
     perThreadObjects_(pts),
     _timer(),
+    _transientSims(pts->simParticleStore),
     _sizeLimit(pts->ioconf.mu2elimits().maxSimParticleCollectionSize()),
     _currentSize(0),
     _overflowSimParticles(false),
@@ -302,7 +303,7 @@ namespace mu2e {
     _steppingAction->BeginOfTrack();
 
     if ( !_debugList.inList() ) return;
-    Mu2eG4UserHelpers::printTrackInfo( trk, "Start new Track: ", _transientMap,
+    Mu2eG4UserHelpers::printTrackInfo( trk, "Start new Track: ", _transientSims,
                                        _timer, _mu2eOrigin);
 
     _timer.reset();
@@ -329,7 +330,7 @@ namespace mu2e {
     _steppingAction->EndOfTrack();
 
     if ( !_debugList.inList() ) return;
-    Mu2eG4UserHelpers::printTrackInfo( trk, "End Track:       ", _transientMap,
+    Mu2eG4UserHelpers::printTrackInfo( trk, "End Track:       ", _transientSims,
                                        _timer, _mu2eOrigin, true, _printTrackTiming);
 
   }
@@ -353,12 +354,12 @@ namespace mu2e {
     if( simsInfo.isValid()) {
       const SimParticleCollection& inputSims = simsInfo.sims.ref();
       // We do not compress anything here, but use the call to reseat the pointers
-      // while copying the inputs to _transientMap.
+      // while copying the inputs to _transientSims.
       compressSimParticleCollection(perThreadObjects_->simParticleHelper->productID(),
                                     perThreadObjects_->simParticleHelper->productGetter(),
                                     inputSims,
                                     KeepAll(),
-                                    _transientMap);
+                                    _transientSims);
 
       // old -> new particle remapping
       for(const auto& sim: inputSims) {
@@ -398,9 +399,8 @@ namespace mu2e {
 
   void Mu2eG4TrackingAction::endEvent(){
 
-    Mu2eG4UserHelpers::checkCrossReferences(true,true,_transientMap);
-    perThreadObjects_->simPartCollection->insert( _transientMap.begin(), _transientMap.end() );
-    _transientMap.clear();
+    Mu2eG4UserHelpers::checkCrossReferences(true,true,_transientSims);
+    _transientSims.moveTo(*perThreadObjects_->simPartCollection);
 
     if ( !_debugList.inList() ) return;
   }
@@ -503,14 +503,6 @@ namespace mu2e {
       G4cout << G4endl; // step related info is not available at this stage
     }
 
-    // Track should not yet be in the map.  Add a debug clause to skip this test?
-    if ( _transientMap.find(kid) != _transientMap.end() ){
-      throw cet::exception("RANGE")
-        << "SimParticle already in the event.  This should never happen. id is: "
-        << kid
-        << "\n";
-    }
-
     // Add this track to the transient data.
     CLHEP::HepLorentzVector p4(trk->GetMomentum(),trk->GetTotalEnergy());
 
@@ -537,7 +529,7 @@ namespace mu2e {
         //   << ", " << static_cast<G4int>(pG4Ion->GetFloatLevelBase())
              << ", " << std::string(1,G4Ions::FloatLevelBaseChar(G4Ions::FloatLevelBase(flbi)))
              << G4endl;
-      Mu2eG4UserHelpers::printTrackInfo( trk, " Ion:          ", _transientMap,
+      Mu2eG4UserHelpers::printTrackInfo( trk, " Ion:          ", _transientSims,
                                          _timer, _mu2eOrigin);
     }
 
@@ -549,7 +541,8 @@ namespace mu2e {
       ion.floatLevelBaseIndex = dynamic_cast<const G4Ions*>(pDef)->GetFloatLevelBaseIndex();
     }
 
-    _transientMap.insert(std::make_pair(kid,SimParticle( kid,
+    // Track should not yet be in the store.
+    bool inserted = _transientSims.insert(kid,SimParticle( kid,
                                                          perThreadObjects_->simParticleHelper->simStage(),
                                                          parentPtr,
                                                          ppdgId,
@@ -561,22 +554,28 @@ namespace mu2e {
                                                          _physVolHelper->index(trk),
                                                          trk->GetTrackStatus(),
                                                          creationCode,
-                                                         ion)));
+                                                         ion));
+    if ( !inserted ){
+      throw cet::exception("RANGE")
+        << "SimParticle already in the event.  This should never happen. id is: "
+        << kid
+        << "\n";
+    }
 
     // If this track has a parent, tell the parent about this track.
     if ( parentPtr.isNonnull() ){
-      map_type::iterator i(_transientMap.find(SimParticleCollection::key_type(parentPtr.key())));
-      if ( i == _transientMap.end() ){
+      SimParticle* parent = _transientSims.find(SimParticleCollection::key_type(parentPtr.key()));
+      if ( parent == nullptr ){
         throw cet::exception("RANGE")
           << "Could not find parent SimParticle in " << __func__ << ".  id: "
           << parentPtr.key()
           << "\n";
       }
-      i->second.addDaughter(perThreadObjects_->simParticleHelper->particlePtr(trk));
+      parent->addDaughter(perThreadObjects_->simParticleHelper->particlePtr(trk));
 
       // // print parent of an ion
       //
-      // int parPDGId = i->second.pdgId();
+      // int parPDGId = parent->pdgId();
       // if ( ppdgId >PDGCode::G4Threshold ) {
       //   G4String pName = "";
       //   if ( parPDGId >PDGCode::G4Threshold ) {
@@ -587,17 +586,17 @@ namespace mu2e {
       //     pName = G4ParticleTable::GetParticleTable()->FindParticle(parPDGId)->GetParticleName();
       //   }
       //   G4cout << __func__ << " Ion parent with approximate name : "
-      //          << i->second.id()
+      //          << parent->id()
       //          << ", " << parPDGId
       //          << ", " << pName
-      //          << ", created by " << i->second.creationCode().name()
-      //          << ", stopped by " << i->second.stoppingCode().name()
+      //          << ", created by " << parent->creationCode().name()
+      //          << ", stopped by " << parent->stoppingCode().name()
       //          << G4endl;
       // }
       // // print if parent is an ion
       // if ( parPDGId)) {
       //   G4cout << __func__ << " Ion daughter pdgid: " << ppdgId << G4endl;
-      //   Mu2eG4UserHelpers::printTrackInfo( trk, "ion daughter: ", _transientMap,
+      //   Mu2eG4UserHelpers::printTrackInfo( trk, "ion daughter: ", _transientSims,
       //                                      _timer, _mu2eOrigin);
       // }
     }
@@ -613,9 +612,9 @@ namespace mu2e {
 
     key_type kid(perThreadObjects_->simParticleHelper->particleKeyFromG4TrackID(trk->GetTrackID()));
 
-    // Find the particle in the map.
-    map_type::iterator i(_transientMap.find(kid));
-    if ( i == _transientMap.end() ){
+    // Find the particle in the store.
+    SimParticle* particle = _transientSims.find(kid);
+    if ( particle == nullptr ){
       throw cet::exception("RANGE")
         << "Could not find existing SimParticle in Mu2eG4TrackingAction::saveSimParticleEnd()  id: "
         << kid
@@ -708,7 +707,7 @@ namespace mu2e {
     }
 
     // Add info about the end of the track.  Throw if SimParticle not already there.
-    i->second.addEndInfo( trk->GetPosition()-_mu2eOrigin,
+    particle->addEndInfo( trk->GetPosition()-_mu2eOrigin,
                           endMomentum, // based on pre last step
                           endGlobalTime, // based on pre last step
                           endProperTime, // based on pre last step
@@ -731,14 +730,14 @@ namespace mu2e {
     //   parentPtr = perThreadObjects_->simParticleHelper->particlePtrFromG4TrackID(parentId);
     // }
     // if ( parentPtr.isNonnull() ){
-    //   map_type::iterator i(_transientMap.find(SimParticleCollection::key_type(parentPtr.key())));
-    //   if ( i == _transientMap.end() ){
+    //   SimParticle const* parent = _transientSims.find(SimParticleCollection::key_type(parentPtr.key()));
+    //   if ( parent == nullptr ){
     //     throw cet::exception("RANGE")
     //       << "Could not find parent SimParticle in " << __func__ << ".  id: "
     //       << parentPtr.key()
     //       << "\n";
     //   }
-    //   parPDGId = i->second.pdgId();
+    //   parPDGId = parent->pdgId();
     // }
 
     if ( trackingVerbosityLevel > 1
@@ -747,7 +746,7 @@ namespace mu2e {
       G4int prec = G4cout.precision(15);
       G4cout << __func__
              << " particle "
-             << i->second.pdgId() << ", "
+             << particle->pdgId() << ", "
              << trk->GetParticleDefinition()->GetParticleName()
              << " stopped by " << stoppingCode // << ", " << pname
              << " totE deposit " << fixed << trk->GetStep()->GetTotalEnergyDeposit()
@@ -760,8 +759,8 @@ namespace mu2e {
              << " vertex KE " << trk->GetVertexKineticEnergy()
              << " vertex direction " << trk->GetVertexMomentumDirection()
              << G4endl;
-      G4cout << __func__ << " track statuses: " << i->second.startG4Status()
-             << ", " << i->second.endG4Status()
+      G4cout << __func__ << " track statuses: " << particle->startG4Status()
+             << ", " << particle->endG4Status()
              << G4endl;
       G4cout << __func__
              << " step length " << trk->GetStepLength()
@@ -793,9 +792,9 @@ namespace mu2e {
     const auto& trajectory = _steppingAction->trajectory();
     if ( int(trajectory.size()) < _mcTrajectoryMinSteps ) return;
 
-    // Find the particle in the map.
-    map_type::iterator i(_transientMap.find(kid));
-    if ( i == _transientMap.end() ){
+    // Find the particle in the store.
+    SimParticle const* particle = _transientSims.find(kid);
+    if ( particle == nullptr ){
       G4Event const* event = G4RunManager::GetRunManager()->GetCurrentEvent();
 
       mf::LogWarning("G4") << "Mu2eG4TrackingAction::swapTrajectory: "
@@ -806,7 +805,7 @@ namespace mu2e {
       return;
     }
 
-    CLHEP::HepLorentzVector const& p0 = i->second.startMomentum();
+    CLHEP::HepLorentzVector const& p0 = particle->startMomentum();
     if ( p0.vect().mag() < _mcTrajectoryMomentumCut ) return;
 
     art::Ptr<SimParticle> sim = perThreadObjects_->simParticleHelper->particlePtr(trk);
@@ -334,7 +334,7 @@ namespace mu2e {
     }
 
     void printTrackInfo(G4Track const* const trk, std::string const& text,
-                        map_type const& transientMap,
+                        SimParticleStore const& transientSims,
                         cet::cpu_timer const& timer,
                         CLHEP::Hep3Vector const& mu2eOrigin,
                         bool isEnd, bool printTimers) {
@@ -376,10 +376,9 @@ namespace mu2e {
 
       if ( isEnd ){
         cout << trk->GetProperTime() <<  " | ";
-        map_type::const_iterator i(transientMap.find(key_type(id)));
-        if ( i != transientMap.end() ){
-          SimParticle const& particle = i->second;
-          cout << particle.startGlobalTime() <<  " ";
+        SimParticle const* particle = transientSims.find(key_type(id));
+        if ( particle != nullptr ){
+          cout << particle->startGlobalTime() <<  " ";
         } else {
           cout << -1. <<  " ";
         }
@@ -401,14 +400,14 @@ namespace mu2e {
 
     }
 
-    bool checkCrossReferences( bool doPrint, bool doThrow, map_type const& transientMap ){
+    bool checkCrossReferences( bool doPrint, bool doThrow, SimParticleStore const& transientSims ){
 
       // Start by assuming we are ok; any error will turn this to false.
       bool ok(true);
 
       // Loop over all simulated particles.
-      for ( map_type::const_iterator i=transientMap.begin();
-            i!=transientMap.end(); ++i ){
+      for ( SimParticleStore::const_iterator i=transientSims.begin();
+            i!=transientSims.end(); ++i ){
 
         // The next particle to look at.
         SimParticle const& sim = i->second;
@@ -423,10 +422,10 @@ namespace mu2e {
 
           key_type parentId;
 
-          map_type::const_iterator fdi = transientMap.find(*j);
-          bool daugterFound = fdi !=transientMap.end();
+          SimParticle const* fdi = transientSims.find(*j);
+          bool daugterFound = fdi != nullptr;
           if (daugterFound) {
-            parentId = (fdi->second).parentId();
+            parentId = fdi->parentId();
           }
 
           if ( !daugterFound || parentId != simid ){
@@ -449,8 +448,8 @@ namespace mu2e {
         if ( sim.hasParent() ){
           key_type parentId = sim.parentId();
 
-          map_type::const_iterator fpi = transientMap.find(parentId);
-          bool parentFound = fpi != transientMap.end();
+          SimParticle const* fpi = transientSims.find(parentId);
+          bool parentFound = fpi != nullptr;
 
           if ( !parentFound ){
             ok = false;
@@ -464,7 +463,7 @@ namespace mu2e {
             }
           } else {
 
-            std::vector<key_type> const& mdau = (fpi->second).daughterIds();
+            std::vector<key_type> const& mdau = fpi->daughterIds();
             bool inList(false);
 
             if (find(mdau.begin(), mdau.end(), simid)!=mdau.end()) {
@@ -111,32 +111,19 @@
 #include "Geant4/G4UniformMagField.hh"
 #include "Geant4/G4FieldManager.hh"
 #include "Geant4/G4Mag_UsualEqRhs.hh"
-#include "Geant4/G4Mag_SpinEqRhs.hh"
 #include "Geant4/G4ExactHelixStepper.hh"
 #include "Geant4/G4ChordFinder.hh"
 #include "Geant4/G4TransportationManager.hh"
 #include "Geant4/G4PropagatorInField.hh"
 #include "Geant4/G4MagIntegratorDriver.hh"
 #include "Geant4/G4UserLimits.hh"
-#include "Geant4/G4ClassicalRK4.hh"
-#include "Geant4/G4ImplicitEuler.hh"
-#include "Geant4/G4ExplicitEuler.hh"
-#include "Geant4/G4SimpleRunge.hh"
-#include "Geant4/G4SimpleHeum.hh"
-#include "Geant4/G4HelixImplicitEuler.hh"
-#include "Geant4/G4HelixSimpleRunge.hh"
-#if G4VERSION>4103
-#include "Geant4/G4DormandPrince745.hh"
-#include "Geant4/G4BogackiShampine23.hh"
-#endif
-#if G4VERSION>4106
-#include "Geant4/G4TDormandPrince45.hh"
-#endif
 #include "Geant4/G4GDMLParser.hh"
 #include "Geant4/G4ProductionCuts.hh"
 #include "Geant4/G4Region.hh"
+#include "Geant4/G4AutoDelete.hh"
 
 #include "Offline/Mu2eG4/inc/Mu2eG4GlobalMagneticField.hh"
+#include "Offline/Mu2eG4/inc/Mu2eG4RegionMagneticField.hh"
 
 #include "boost/regex.hpp"
 
@@ -437,67 +424,8 @@ namespace mu2e {
     // Create global field managers; don't use FieldMgr here to avoid problem with ownership
 
     G4MagneticField * _field = new Mu2eG4GlobalMagneticField(worldGeom->mu2eOriginInWorld());
-    G4Mag_EqRhs * _rhs  = new G4Mag_UsualEqRhs(_field);
-    G4MagIntegratorStepper * _stepper;
-    if ( _g4VerbosityLevel > 0 ) G4cout << __func__ << " Setting up " << g4stepperName_ << " stepper" << G4endl;
-    if ( g4stepperName_  == "G4ClassicalRK4" ) {
-      _stepper = new G4ClassicalRK4(_rhs);
-    } else if ( g4stepperName_  == "G4ClassicalRK4WSpin" ) {
-      delete _rhs; // FIXME: avoid the delete
-      _rhs  = new G4Mag_SpinEqRhs(_field);
-      _stepper = new G4ClassicalRK4(_rhs, 12);
-      if ( _g4VerbosityLevel > 0) {
-        G4cout << __func__ << " Replaced G4Mag_UsualEqRhs with G4ClassicalRK4WSpin "
-               << "and used G4ClassicalRK4 with Spin" << G4endl;
-      }
-#if G4VERSION>4103
-    } else if ( g4stepperName_  == "G4DormandPrince745WSpin" ) {
-      delete _rhs; // FIXME: avoid the delete
-      _rhs  = new G4Mag_SpinEqRhs(_field);
-      _stepper = new G4DormandPrince745(_rhs, 12);
-      if ( _g4VerbosityLevel > 0) {
-        G4cout << __func__ << " Replaced G4Mag_UsualEqRhs with G4DormandPrince745WSpin "
-               << "and used G4DormandPrince745 with Spin" << G4endl;
-      }
-#endif
-#if G4VERSION>4106
-    } else if ( g4stepperName_  == "G4TDormandPrince45WSpin" ) {
-      delete _rhs; // consider avoiding the delete once we really start tracking with spin
-      _rhs  = new G4Mag_SpinEqRhs(_field);
-      _stepper = new G4TDormandPrince45(_rhs, 12);
-      if ( _g4VerbosityLevel > 0) {
-        G4cout << __func__ << " Replaced G4Mag_UsualEqRhs with G4TDormandPrince45WSpin "
-               << "and used G4TDormandPrince45 with Spin" << G4endl;
-      }
-#endif
-    } else if ( g4stepperName_  == "G4ImplicitEuler" ) {
-      _stepper = new G4ImplicitEuler(_rhs);
-    } else if ( g4stepperName_  == "G4ExplicitEuler" ) {
-      _stepper = new G4ExplicitEuler(_rhs);
-    } else if ( g4stepperName_  == "G4SimpleHeum" ) {
-      _stepper = new G4SimpleHeum(_rhs);
-    } else if ( g4stepperName_  == "G4HelixImplicitEuler" ) {
-      _stepper = new G4HelixImplicitEuler(_rhs);
-    } else if ( g4stepperName_  == "G4HelixSimpleRunge" ) {
-      _stepper = new G4HelixSimpleRunge(_rhs);
-#if G4VERSION>4103
-    } else if ( g4stepperName_  == "G4DormandPrince745" ) {
-      _stepper = new G4DormandPrince745(_rhs);
-    } else if ( g4stepperName_  == "G4BogackiShampine23" ) {
-      _stepper = new G4BogackiShampine23(_rhs);
-#endif
-#if G4VERSION>4106
-    } else if ( g4stepperName_  == "G4TDormandPrince45" ) {
-      _stepper = new G4TDormandPrince45(_rhs);
-#endif
-    } else if ( g4stepperName_  == "G4SimpleRunge" ) {
-      _stepper = new G4SimpleRunge(_rhs);
-    } else {
-      throw cet::exception("GEOM")
-        << "Unrecognized stepper : "
-        << g4stepperName_
-        << "\n";
-    }
+    G4Mag_EqRhs * _rhs = nullptr;
+    G4MagIntegratorStepper * _stepper = FieldMgr::createStepper(g4stepperName_, _field, _rhs, _g4VerbosityLevel);
 
     G4ChordFinder * _chordFinder = new G4ChordFinder(_field,g4StepMinimum_,_stepper);
     G4FieldManager * _manager = new G4FieldManager(_field,_chordFinder,true);
@@ -567,8 +495,82 @@ namespace mu2e {
       G4cout << __func__ << " g4MaxIntStep        " << _propInField->GetMaxLoopCount() << G4endl;
     }
 
+    constructFieldRegions();
+
   } // end Mu2eWorld::constructBFieldAndManagers
 
+  // Field managers for the regions configured in physics.fieldRegions; they override the
+  // global and DS field managers set above.  This is called in each thread and the
+  // G4LogicalVolume field managers are thread local, so each thread gets its own objects.
+  void Mu2eWorld::constructFieldRegions(){
+
+    std::vector<Mu2eG4Config::FieldRegion> regions;
+    if ( !conf_.physics().fieldRegions(regions) ) return;
+
+    GeomHandle<WorldG4> worldGeom;
+
+    for ( auto const& region : regions ){
+      std::vector<std::string> const volumes = region.volumes();
+      std::string const fieldType = region.field();
+      if ( volumes.empty() ) {
+        throw cet::exception("GEOM") << __func__ << " field region without volumes\n";
+      }
+
+      G4FieldManager * manager = nullptr;
+      if ( fieldType == "zero" ) {
+        manager = new G4FieldManager();
+      } else {
+        Mu2eG4RegionMagneticField * field = nullptr;
+        std::string stepperName = region.stepper();
+        if ( fieldType == "map" ) {
+          field = new Mu2eG4RegionMagneticField(volumes.front(),
+                                                worldGeom->mu2eOriginInWorld(),
+                                                region.cacheDistance()*CLHEP::mm);
+        } else if ( fieldType == "uniform" ) {
+          field = new Mu2eG4RegionMagneticField(volumes.front(),
+                                                worldGeom->mu2eOriginInWorld(),
+                                                _helper->locateVolInfo(volumes.front()).centerInWorld);
+          stepperName = "G4ExactHelixStepper";
+        } else {
+          throw cet::exception("GEOM")
+            << __func__ << " unrecognized field type " << fieldType
+            << " for region " << volumes.front() << "\n";
+        }
+
+        G4Mag_EqRhs * rhs = nullptr;
+        G4MagIntegratorStepper * stepper = FieldMgr::createStepper(stepperName, field, rhs, _g4VerbosityLevel);
+        G4ChordFinder * chordFinder = new G4ChordFinder(field,g4StepMinimum_,stepper);
+        chordFinder->SetDeltaChord(g4DeltaChord_);
+        manager = new G4FieldManager(field,chordFinder,true);
+        manager->SetMinimumEpsilonStep(g4epsilonMin_);
+        manager->SetMaximumEpsilonStep(g4epsilonMax_);
+        manager->SetDeltaOneStep(g4DeltaOneStep_);
+        manager->SetDeltaIntersection(g4DeltaIntersection_);
+
+        G4AutoDelete::Register(field);
+        G4AutoDelete::Register(rhs);
+        G4AutoDelete::Register(stepper);
+        G4AutoDelete::Register(chordFinder);
+
+        if ( _verbosityLevel > 0 ) {
+          G4cout << __func__ << " Use " << fieldType << " field with " << stepperName
+                 << " in region " << volumes.front();
+          if ( field->isUniform() ) G4cout << " B = " << field->uniformValue()/CLHEP::tesla << " T";
+          G4cout << G4endl;
+        }
+      }
+      G4AutoDelete::Register(manager);
+
+      for ( auto const& volume : volumes ){
+        _helper->locateVolInfo(volume).logical->SetFieldManager(manager, true);
+        if ( _verbosityLevel > 0 ) {
+          G4cout << __func__ << " Field region " << volumes.front() << " includes " << volume << G4endl;
+        }
+      }
+    }
+
+  } // end Mu2eWorld::constructFieldRegions
+
 
     // A helper function for Mu2eWorld::constructStepLimiters().
     // Find all logical volumes matching a wildcarded name and add steplimiters to them.
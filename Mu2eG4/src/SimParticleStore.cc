@@ -0,0 +1,61 @@
+//
+// Transient storage of the SimParticles of one event while G4 runs.
+//
+
+#include "Offline/Mu2eG4/inc/SimParticleStore.hh"
+
+#include <algorithm>
+#include <iterator>
+#include <utility>
+
+namespace mu2e {
+
+  SimParticleStore::mapped_type& SimParticleStore::append(key_type key, mapped_type&& particle) {
+    auto ikey = key.asUint();
+    if ( ikey >= _slots.size() ){
+      _slots.resize(std::max(size_t(ikey)+1,2*_slots.size()),noSlot);
+    }
+    _ordered = _ordered && (_particles.empty() || _particles.back().first < key);
+    _slots[ikey] = _particles.size();
+    _particles.emplace_back(key,std::move(particle));
+    return _particles.back().second;
+  }
+
+  bool SimParticleStore::insert(key_type key, mapped_type&& particle) {
+    if ( slot(key) != noSlot ) return false;
+    append(key,std::move(particle));
+    return true;
+  }
+
+  SimParticleStore::mapped_type& SimParticleStore::operator[](key_type key) {
+    auto islot = slot(key);
+    if ( islot != noSlot ) return _particles[islot].second;
+    return append(key,mapped_type());
+  }
+
+  void SimParticleStore::moveTo(SimParticleCollection& out) {
+    if ( _ordered ){
+      out.insert(std::make_move_iterator(_particles.begin()),std::make_move_iterator(_particles.end()));
+    } else {
+      // G4 tracks particles in stack order, not in track ID order; the slot table is in key order.
+      _sorted.clear();
+      _sorted.reserve(_particles.size());
+      for ( auto islot : _slots ){
+        if ( islot != noSlot ) _sorted.push_back(std::move(_particles[islot]));
+      }
+      out.insert(std::make_move_iterator(_sorted.begin()),std::make_move_iterator(_sorted.end()));
+      _sorted.clear();
+    }
+    clear();
+  }
+
+  void SimParticleStore::clear() {
+    // the keys are still valid after moving the particles
+    for ( auto const& particle : _particles ){
+      _slots[particle.first.asUint()] = noSlot;
+    }
+    _particles.clear();
+    _ordered = true;
+  }
+
+}
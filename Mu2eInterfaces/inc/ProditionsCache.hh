@@ -1,5 +1,7 @@
 #ifndef Mu2eInterfaces_ProditionsCache_hh
 #define Mu2eInterfaces_ProditionsCache_hh
+#include <atomic>
+#include <deque>
 #include <memory>
 #include <tuple>
 #include <string>
@@ -32,14 +34,18 @@ namespace mu2e {
     typedef ProditionsEntity::set_t set_t;
 
     // what is actually held in the cache
-    // new iovs are added if the data is the same
+    // new iovs are added if the data is the same.
+    // Each iov of an item also has an entry_t, and the entry found last
+    // is kept in an atomic pointer, so most calls to update only load
+    // that pointer and check its iov, without locking
     struct cacheItem {
       ProditionsEntity::ptr _p;
       std::vector<DbIoV> _iovs;
     };
 
     ProditionsCache(std::string name, int verbose=0):
-      _name(name),_verbose(verbose),_initialized(false) {}
+      _lockWaitTime(0),_lockTime(0),
+      _name(name),_verbose(verbose),_initialized(false),_current(nullptr) {}
     virtual ~ProditionsCache() {}
 
     // the following are provided by the
@@ -60,6 +66,17 @@ namespace mu2e {
     // this is the main call to the cache asking for an existing
     // entity, creating and cacheing a new entity as needed
     ret_t update(art::EventID const& eid) {
+      uint32_t run = eid.run();
+      uint32_t subrun = eid.subRun();
+
+      // the entry returned last time is usually still good - this
+      // is one atomic load, with no lock and no timing
+      entry_t const* e = _current.load(std::memory_order_acquire);
+      if(e && e->_iov.inInterval(run,subrun)) {
+        if(_verbose>1) report(*e,false,false);
+        return std::make_tuple(e->_p,e->_iov);
+      }
+
       // do lazy initialization, don't bother with
       // read lock since a bool can't be partially constructed
       if(!_initialized) {
@@ -83,20 +100,17 @@ namespace mu2e {
         _lockTime += dt;  // time we spent write locked
       } // end initialize, write lock out of scope, released
 
-      // gain shared read lock to find what
-      // set of tables are needed
+      // gain shared read lock to look for
+      // another entry which covers this run
       bool made = false;
       bool found = false;
-      ProditionsEntity::ptr p;
-      set_t cids;
-      DbIoV iov;
       { // start read lock scope
         std::shared_lock lock(_mutex);
-        p = findByRun(eid,iov);  // if found, iov is valid
+        e = findEntry(run,subrun);
       } // end read lock lifetime
 
       // if it was not found in cache, make it
-      if(!p) {
+      if(!e) {
         //gain write lock
         auto stime = std::chrono::high_resolution_clock::now();
         std::unique_lock lock(_mutex); // write lock
@@ -106,13 +120,13 @@ namespace mu2e {
          _lockWaitTime += dt;
          // need to check again in case another thread made it
          // between read lock and write lock
-         p = findByRun(eid,iov);
-         if(!p) {
+         e = findEntry(run,subrun);
+         if(!e) {
 
-           p = makeEntity(eid);
-           cids = makeSet(eid);
+           ProditionsEntity::ptr p = makeEntity(eid);
+           set_t cids = makeSet(eid);
            p->addCids(cids);
-           iov = makeIov(eid);
+           DbIoV iov = makeIov(eid);
 
            // at this point, we might have existing cache items with
            // the same cids, but not the relevant iov,
@@ -120,6 +134,7 @@ namespace mu2e {
            for(auto& ci : _cache) {
              if(ci._p->getCids()==cids) {
                ci._iovs.emplace_back(iov);
+               p = ci._p;
                found = true;
                break;
              }
@@ -129,9 +144,11 @@ namespace mu2e {
              ci._p = p;
              ci._iovs.emplace_back(iov);
              _cache.emplace_back(ci);
-             made = true;
              if(_verbose>7) p->print(std::cout);
            }
+           _entries.push_back(entry_t{p,iov});
+           e = &_entries.back();
+           made = true;
          } // p not found
 
          auto etime = std::chrono::high_resolution_clock::now();
@@ -141,49 +158,68 @@ namespace mu2e {
 
       } // endif not in cache, write lock now destroyed
 
-      if(_verbose>1) {
-        if(made) {
-          if(found) {
-            std::cout<< "ProditionsCache::update made new iov for "
-                     << name() << std::endl;
-          } else {
-            std::cout<< "ProditionsCache::update made new "
-                     << name() << std::endl;
-          }
-        } else {
-          std::cout<< "ProditionsCache::update return cached "<< name() << std::endl;
-        }
-        std::cout << "     iov " << iov.to_string(true);
-        std::cout << "     cids ";
-        for(auto cid : cids) std::cout << cid << " " ;
-        std::cout << std::endl;
-      }
+      // entries are never changed or deleted, so readers may keep using
+      // the one they loaded while it is replaced here
+      _current.store(e, std::memory_order_release);
+
+      if(_verbose>1) report(*e,made,found);
 
-      return std::make_tuple(p,iov);
+      return std::make_tuple(e->_p,e->_iov);
 
     } // end update
 
     // is there a cache entry covering this run/subrun?
     // return good pointer or null, and fill iov
     ProditionsEntity::ptr  findByRun(art::EventID eid, DbIoV& iov) {
-      uint32_t run = eid.run();
-      uint32_t subrun = eid.subRun();
-      for(auto const& ci : _cache) {
-        for(auto const& ii : ci._iovs) {
-          if(ii.inInterval(run,subrun)) {
-            iov = ii;
-            return ci._p;
-          }
+      std::shared_lock lock(_mutex);
+      entry_t const* e = findEntry(eid.run(),eid.subRun());
+      if(!e) return ProditionsEntity::ptr();
+      iov = e->_iov;
+      return e->_p;
+    }
+
+  private:
+    // an entity with one of its iovs
+    struct entry_t {
+      ProditionsEntity::ptr _p;
+      DbIoV _iov;
+    };
+
+    // call with the lock held
+    entry_t const* findEntry(uint32_t run, uint32_t subrun) const {
+      for(auto const& e : _entries) {
+        if(e._iov.inInterval(run,subrun)) return &e;
+      }
+      return nullptr;
+    }
+
+    void report(entry_t const& e, bool made, bool found) const {
+      if(made) {
+        if(found) {
+          std::cout<< "ProditionsCache::update made new iov for "
+                   << name() << std::endl;
+        } else {
+          std::cout<< "ProditionsCache::update made new "
+                   << name() << std::endl;
         }
+      } else {
+        std::cout<< "ProditionsCache::update return cached "<< name() << std::endl;
       }
-      return ProditionsEntity::ptr();
+      std::cout << "     iov " << e._iov.to_string(true);
+      std::cout << "     cids ";
+      for(auto cid : e._p->getCids()) std::cout << cid << " " ;
+      std::cout << std::endl;
     }
 
-  private:
     std::string _name;
     int _verbose;
-    bool _initialized;
+    std::atomic<bool> _initialized;
     std::vector<cacheItem> _cache;
+    // one entry per entity and iov, only appended to, so pointers to
+    // the entries stay valid for the lifetime of the cache
+    std::deque<entry_t> _entries;
+    // the entry last returned, read without locking
+    std::atomic<entry_t const*> _current;
 
   };
 
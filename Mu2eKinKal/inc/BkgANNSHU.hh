@@ -14,10 +14,6 @@
 #include <cstddef>
 #include <memory>
 
-namespace TMVA_SOFIE_TrainBkg {
-  class Session;
-}
-
 namespace mu2e {
   class ComboHit;
   // Update based just on Bkg to the wire
@@ -28,7 +24,7 @@ namespace mu2e {
       BkgANNSHU(Config const& config);
       WireHitState wireHitState(WireHitState const& input, KinKal::ClosestApproachData const& tpdata, DriftInfo const& dinfo, ComboHit const& chit) const;
     private:
-      std::shared_ptr<TMVA_SOFIE_TrainBkg::Session> mva_;
+      std::string mvaWgtsFile_; // each thread infers with its own session of these weights
       double mvacut_ =0; // cut value to decide if drift information is usable
       WHSMask freeze_; // states to freeze
       int diag_ =0; // diag print level
@@ -27,8 +27,8 @@ namespace mu2e {
       WireHitState wireHitState(WireHitState const& input, KinKal::ClosestApproachData const& tpdata, DriftInfo const& dinfo, ComboHit const& chit) const;
       static std::string const& configDescription(); // description of the variables
     private:
-      std::shared_ptr<TMVA_SOFIE_TrainSign::Session> signmva_; // ANN for selecting correct sign LR ambiguity
-      std::shared_ptr<TMVA_SOFIE_TrainCluster::Session> clustermva_; // ANN for selecting good cluster behavior
+      std::string signmvaWgtsFile_; // ANN for selecting correct sign LR ambiguity
+      std::string clustermvaWgtsFile_; // ANN for selecting good cluster behavior
       double signmvacut_ =0; // cut value for sign MVA
       double clustermvacut_ =0; // cut value for cluster MVA
       double dtmvacut_ =0; // cut value for using dt constraint
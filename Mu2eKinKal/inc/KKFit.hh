@@ -11,6 +11,7 @@
 #include "Offline/Mu2eKinKal/inc/KKCaloHit.hh"
 #include "Offline/Mu2eKinKal/inc/KKFitUtilities.hh"
 #include "Offline/Mu2eKinKal/inc/KKFitSettings.hh"
+#include "Offline/Mu2eKinKal/inc/KKStrawGrid.hh"
 #include "Offline/Mu2eKinKal/inc/WireHitState.hh"
 // art includes
 #include "canvas/Persistency/Common/Ptr.h"
@@ -47,6 +48,8 @@
 #include <cmath>
 #include <limits>
 #include <algorithm>
+#include <bitset>
+#include <mutex>
 
 using std::endl;
 
@@ -92,6 +95,7 @@ namespace mu2e {
       using DOMAINPTR = std::shared_ptr<KinKal::Domain>;
       using DOMAINCOL = std::set<DOMAINPTR>;
       enum SaveTraj {none=0, full, detector, t0seg};
+      using StrawFlags = std::bitset<StrawId::_maxval+1>; // indexed by StrawId::asUint16()
       // construct from fit configuration objects
       explicit KKFit(KKFitConfig const& fitconfig);
       // helper functions used to create components of the fit
@@ -120,11 +124,22 @@ namespace mu2e {
       bool addMaterial() const { return addmat_; }
       bool addHits() const { return addhits_; }
       auto const& strawHitClusterer() const { return shclusterer_; }
+      // straw search parameters.  The straw radius is only set once the tracker information is filled, by the first straw search
+      double tpocaPrecision() const { return tprec_; }
+      double strawRadius() const { return strawradius_; }
+      int maxDStraw() const { return maxDStraw_; }
+      float maxStrawDoca() const { return maxStrawDoca_; }
+      float maxStrawDocaConsistency() const { return maxStrawDocaCon_; }
+      float maxStrawUposBuffer() const { return maxStrawUposBuff_; }
+      // straws passing the straw DOCA and length cuts for a near-vertical trajectory, with their PCA.  Straws flagged in oldstraws are skipped
+      void verticalStraws(Tracker const& tracker, PTRAJ const& ptraj, StrawFlags const& oldstraws,
+          std::vector<std::pair<Straw const*,PCA>>& straws) const;
     private:
       void fillTrackerInfo(Tracker const& tracker) const;
       void addStrawHits(Tracker const& tracker,StrawResponse const& strawresponse, BFieldMap const& kkbf, KKStrawMaterial const& smat,
           KKTRK const& kktrk, ComboHitCollection const& chcol, KKSTRAWHITCOL& hits,KKSTRAWXINGCOL& addexings) const;
       void addStraws(Tracker const& tracker, KKStrawMaterial const& smat, KKTRK const& kktrk, KKSTRAWXINGCOL& addexings) const;
+      std::shared_ptr<KKStrawGrid const> strawGrid(Tracker const& tracker) const;
       void addCaloHit(Calorimeter const& calo, KKTRK& kktrk, CCHandle cchandle, KKCALOHITCOL& hits) const;
       void sampleFit(KKTRK const& kktrk,KalIntersectionCollection& inters) const; // sample fit at the surfaces specified in the config
       int print_;
@@ -145,12 +160,17 @@ namespace mu2e {
       // parameters controlling adding hits
       float maxStrawHitDoca_, maxStrawHitDt_, maxStrawDoca_, maxStrawDocaCon_, maxStrawUposBuff_;
       int maxDStraw_; // maximum distance from the track a strawhit can be to consider it for adding.
-      // cached info computed from the tracker, used in hit adding; these must be lazy-evaluated as the tracker doesn't exist on construction
+      // cached info computed from the tracker, used in hit adding; these must be lazy-evaluated as the tracker doesn't exist on construction.
+      // Fits can run in parallel, so this is done once for all threads
       mutable double strawradius_;
       mutable double ymin_, ymax_, umax_; // panel-level info
       mutable double rmin_, rmax_; // plane-level info
       mutable double spitch_;
-      mutable bool needstrackerinfo_ = true;
+      mutable std::once_flag trackerinfo_;
+      // straws arranged for the search of vertical tracks, built for each tracker (alignment)
+      mutable std::mutex strawgridmutex_;
+      mutable Tracker const* strawgridtracker_ = nullptr;
+      mutable std::shared_ptr<KKStrawGrid const> strawgrid_;
       // extrapolation and sampling options
       SurfaceMap::SurfacePairCollection sample_; // surfaces to sample the fit
       double intertol_; // surface intersection tolerance (mm)
@@ -442,49 +462,20 @@ namespace mu2e {
     // build the set of existing straws
     auto const& ptraj = kktrk.fitTraj();
     // pre-compute some tracker info if needed
-    if(needstrackerinfo_)fillTrackerInfo(tracker);
-    // list the IDs of existing straws: this speeds the search
-    std::set<StrawId> oldstraws;
-    for(auto const& strawxing : kktrk.strawXings())oldstraws.insert(strawxing->strawId());
-    for(auto const& strawxing : addexings)oldstraws.insert(strawxing->strawId());
+    std::call_once(trackerinfo_,[&](){ fillTrackerInfo(tracker); });
+    // flag the existing straws: this speeds the search
+    StrawFlags oldstraws;
+    for(auto const& strawxing : kktrk.strawXings())oldstraws.set(strawxing->strawId().asUint16());
+    for(auto const& strawxing : addexings)oldstraws.set(strawxing->strawId().asUint16());
     // check for vertical tracks
-    auto t0pos = ptraj.position3(ptraj.t0());
     auto t0dir = ptraj.direction(ptraj.t0());
     KKSTRAWHITPTR shptr; // empty ptr
     if (fabs(t0dir.Z()) < addStrawMinDz_){
-      // looping over every plane for vertical tracks is inefficient FIXME
-      for(auto const& plane : tracker.planes()){
-        if(tracker.planeExists(plane.id())) {
-          for(auto panel_p : plane.panels()){
-            auto const& panel = *panel_p;
-            double zbuffer = 2*strawradius_*(1+maxDStraw_);
-            if (panel.origin().z() > t0pos.Z()+zbuffer || panel.origin().z() < t0pos.Z()-zbuffer){
-              continue;
-            }
-            double t = ptraj.t0();
-            // test all straws
-            for(unsigned istr = 0; istr < panel.nStraws(); ++istr){
-              auto const& straw = panel.getStraw(istr);
-              // add strawExists test TODO
-              // make sure we haven't already seen this straw
-              if(oldstraws.find(straw.id()) == oldstraws.end()){
-                auto sline = Mu2eKinKal::strawLine(straw,t); // line down the straw axis center
-                CAHint hint(t,t);
-                // compute PCA between the trajectory and this straw
-                PCA pca(ptraj, sline, hint, tprec_ );
-                t = pca.particleToca();
-                // require consistency with this track passing through this straw
-                double du = fabs((pca.sensorPoca().Vect()-VEC3(straw.wirePosition(0.0))).Dot(VEC3(straw.wireDirection(0.0))));
-                double doca = fabs(pca.doca());
-                double dsig = std::max(0.0,doca-strawradius_)/sqrt(pca.docaVar());
-                if(doca < maxStrawDoca_ && dsig < maxStrawDocaCon_ && du < straw.halfLength() + maxStrawUposBuff_){
-                  addexings.push_back(std::make_shared<KKSTRAWXING>(shptr,static_cast<CA>(pca),smat,straw));
-                  oldstraws.insert(straw.id());
-                }
-              } // not existing straw cut
-            } // straws loop
-          }
-        }
+      std::vector<std::pair<Straw const*,PCA>> straws;
+      verticalStraws(tracker,ptraj,oldstraws,straws);
+      for(auto const& [straw,pca] : straws){
+        addexings.push_back(std::make_shared<KKSTRAWXING>(shptr,static_cast<CA>(pca),smat,*straw));
+        oldstraws.set(straw->id().asUint16());
       }
     }else{
       // Go hierarchically through planes and panels to find new straws hit by this track.
@@ -525,7 +516,7 @@ namespace mu2e {
                     auto const& straw = panel.getStraw(istr);
                     // add strawExists test TODO
                     // make sure we haven't already seen this straw
-                    if(oldstraws.find(straw.id()) == oldstraws.end()){
+                    if(!oldstraws.test(straw.id().asUint16())){
                       auto sline = Mu2eKinKal::strawLine(straw,zt); // line down the straw axis center
                       CAHint hint(zt,zt);
                       // compute PCA between the trajectory and this straw
@@ -536,7 +527,7 @@ namespace mu2e {
                       double dsig = std::max(0.0,doca-strawradius_)/sqrt(pca.docaVar());
                       if(doca < maxStrawDoca_ && dsig < maxStrawDocaCon_ && du < straw.halfLength() + maxStrawUposBuff_){
                         addexings.push_back(std::make_shared<KKSTRAWXING>(shptr,static_cast<CA>(pca),smat,straw));
-                        oldstraws.insert(straw.id());
+                        oldstraws.set(straw.id().asUint16());
                       }
                     } // not existing straw cut
                   } // straws loop
@@ -550,6 +541,70 @@ namespace mu2e {
   } // end function
 
 
+  template <class KTRAJ> void KKFit<KTRAJ>::verticalStraws(Tracker const& tracker, PTRAJ const& ptraj, StrawFlags const& oldstraws,
+      std::vector<std::pair<Straw const*,PCA>>& straws) const {
+    std::call_once(trackerinfo_,[&](){ fillTrackerInfo(tracker); });
+    // only panels near the t0 z are searched
+    auto t0pos = ptraj.position3(ptraj.t0());
+    auto t0dir = ptraj.direction(ptraj.t0());
+    double zbuffer = 2*strawradius_*(1+maxDStraw_);
+    // a straw POCA can be outside the trajectory range: sample past both ends by the path length the track
+    // needs to cross the searched z window, or the tracker diameter if that is shorter
+    double speed = ptraj.speed(ptraj.t0());
+    double zwindow = 2*(zbuffer + strawradius_ + maxStrawDoca_);
+    double diameter = 2*(std::hypot(ymax_,umax_) + maxStrawUposBuff_ + maxStrawDoca_);
+    double textend = std::min(diameter,zwindow/std::max(fabs(t0dir.Z()),1e-6))/speed;
+    // sample the trajectory, and only test the straws that pass near a sample.  A straw passing the
+    // DOCA cut has a sample within half a step of the POCA, so the search distances include that
+    static const size_t maxnsample(10000);
+    double tbeg = ptraj.range().begin() - textend;
+    double tend = ptraj.range().end() + textend;
+    double trange = tend - tbeg;
+    double dt = std::max(strawradius_/speed,trange/maxnsample);
+    size_t nsample = static_cast<size_t>(std::ceil(trange/dt)) + 1;
+    double halfstep = 0.5*dt*speed;
+    std::vector<double> stimes;
+    KKStrawGrid::Points spoints;
+    stimes.reserve(nsample);
+    spoints.reserve(nsample);
+    for(size_t isample = 0; isample < nsample; ++isample){
+      double t = std::min(tbeg + isample*dt,tend);
+      auto pos = ptraj.position3(t);
+      stimes.push_back(t);
+      spoints.emplace_back(pos.X(),pos.Y(),pos.Z());
+    }
+    std::vector<KKStrawGrid::NearStraw> nearstraws;
+    strawGrid(tracker)->nearStraws(spoints,t0pos.Z()-zbuffer,t0pos.Z()+zbuffer,
+        maxStrawDoca_+halfstep,maxStrawUposBuff_+halfstep,nearstraws);
+    for(auto const& nearstraw : nearstraws){
+      // add strawExists test TODO
+      // make sure we haven't already seen this straw
+      if(oldstraws.test(nearstraw.first.asUint16()))continue;
+      auto const& straw = tracker.getStraw(nearstraw.first);
+      double t = stimes[nearstraw.second];
+      auto sline = Mu2eKinKal::strawLine(straw,t); // line down the straw axis center
+      CAHint hint(t,t);
+      // compute PCA between the trajectory and this straw
+      PCA pca(ptraj, sline, hint, tprec_ );
+      // require consistency with this track passing through this straw
+      double du = fabs((pca.sensorPoca().Vect()-VEC3(straw.wirePosition(0.0))).Dot(VEC3(straw.wireDirection(0.0))));
+      double doca = fabs(pca.doca());
+      double dsig = std::max(0.0,doca-strawradius_)/sqrt(pca.docaVar());
+      if(doca < maxStrawDoca_ && dsig < maxStrawDocaCon_ && du < straw.halfLength() + maxStrawUposBuff_)
+        straws.emplace_back(&straw,pca);
+    } // near straws loop
+  }
+
+  template <class KTRAJ> std::shared_ptr<KKStrawGrid const> KKFit<KTRAJ>::strawGrid(Tracker const& tracker) const {
+    // trackers from proditions are kept for the job, so a new address is a new alignment
+    std::lock_guard<std::mutex> lock(strawgridmutex_);
+    if(strawgrid_ == nullptr || strawgridtracker_ != &tracker){
+      strawgrid_ = std::make_shared<KKStrawGrid const>(tracker);
+      strawgridtracker_ = &tracker;
+    }
+    return strawgrid_;
+  }
+
   template <class KTRAJ> void KKFit<KTRAJ>::addCaloHit(Calorimeter const& calo, KKTRK& kktrk, CCHandle cchandle, KKCALOHITCOL& hits) const {
     double crystalLength = calo.caloInfo().getDouble("crystalZLength");
     auto const& ptraj = kktrk.fitTraj();
@@ -620,7 +675,6 @@ namespace mu2e {
     rmin_ = innerstraw_origin.y() - maxDStraw_*strawradius_;
     rmax_ = outerstraw.wireEnd(StrawEnd::cal).mag() + maxDStraw_*strawradius_;
     spitch_ = (StrawId::_nstraws-1)/(ymax_-ymin_);
-    needstrackerinfo_= false;
   }
 
 
@@ -105,6 +105,7 @@ namespace mu2e {
       fhicl::Atom<int> printLevel { Name("PrintLevel"), Comment("Diagnostic printout Level"), 0 };
       fhicl::Sequence<float> seederrors { Name("SeedErrors"), Comment("Initial value of seed parameter errors (rms, various units)") };
       fhicl::Atom<bool> saveAll { Name("SaveAllFits"), Comment("Save all fits, whether they suceed or not"),false };
+      fhicl::Atom<unsigned> nthreads { Name("FitThreads"), Comment("Number of threads fitting seeds in parallel.  0 fits serially"), 0 };
     };
   // Extrapolation configuration
     struct KKExtrapConfig {
@@ -0,0 +1,61 @@
+#ifndef Mu2eKinKal_KKGridBField_hh
+#define Mu2eKinKal_KKGridBField_hh
+//
+//  Field map for KinKal precomputed on a regular grid in the detector system, typically
+//  covering the tracker.  The field and its gradient are sampled from the Mu2e maps once,
+//  at construction, and interpolated trilinearly afterwards, so calls inside the grid
+//  need no coordinate transform, map lookup or finite differences.
+//  Points outside the grid are passed to a KKBField.
+//
+// Mu2e includes
+#include "Offline/Mu2eKinKal/inc/KKBField.hh"
+// KinKal includes
+#include "KinKal/General/BFieldMap.hh"
+// framework includes
+#include "fhiclcpp/types/Atom.h"
+#include "fhiclcpp/types/Sequence.h"
+#include <array>
+#include <vector>
+
+namespace mu2e
+{
+  using VEC3 = KinKal::VEC3;
+  class KKGridBField : public KinKal::BFieldMap {
+    public:
+      using Grad = ROOT::Math::SMatrix<double,3>; // field gradient: ie dBi/d(x,y,z)
+      using Name    = fhicl::Name;
+      using Comment = fhicl::Comment;
+      struct Config {
+        fhicl::Sequence<double> lower { Name("Lower"), Comment("Lower corner (x,y,z) of the grid in the detector system (mm)") };
+        fhicl::Sequence<double> upper { Name("Upper"), Comment("Upper corner (x,y,z) of the grid in the detector system (mm)") };
+        fhicl::Atom<double> spacing { Name("Spacing"), Comment("Grid spacing (mm)") };
+      };
+      // sample the Mu2e maps on the grid between the lower and upper corners (detector system)
+      KKGridBField(std::vector<double> const& lower, std::vector<double> const& upper, double spacing,
+          BFieldManager const& bfmgr, DetectorSystem const& det);
+      virtual ~KKGridBField() {}
+      // KinKal BField interface
+      VEC3 fieldVect(VEC3 const& position) const override;
+      Grad fieldGrad(VEC3 const& position) const override;
+      VEC3 fieldDeriv(VEC3 const& position, VEC3 const& velocity) const override;
+      bool inRange(VEC3 const& position) const override;
+      void print(std::ostream& os ) const override;
+      // is the point inside the grid?
+      bool inGrid(VEC3 const& position) const;
+    private:
+      // values stored at each grid point
+      struct Node {
+        std::array<double,3> field; // Bx, By, Bz (Tesla)
+        std::array<std::array<double,3>,3> grad; // grad[j][i] = dB_i/dx_j (Tesla/mm)
+      };
+      KKBField full_; // used outside the grid, and to fill it
+      std::array<double,3> lower_, upper_;
+      double spacing_;
+      std::array<unsigned,3> npts_; // number of grid points along each axis
+      std::vector<Node> nodes_;
+      Node const& node(unsigned ix, unsigned iy, unsigned iz) const { return nodes_[(size_t(ix)*npts_[1] + iy)*npts_[2] + iz]; }
+      // trilinear interpolation of the node values at a point inside the grid
+      void interpolate(VEC3 const& position, Node& value, bool withgrad) const;
+  };
+}
+#endif
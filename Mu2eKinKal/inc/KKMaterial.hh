@@ -12,6 +12,7 @@
 #include "Offline/Mu2eKinKal/inc/KKFileFinder.hh"
 
 #include <memory>
+#include <mutex>
 #include <string>
 
 namespace mu2e {
@@ -45,6 +46,7 @@ namespace mu2e {
       std::string wallmatname_, gasmatname_, wirematname_,ipamatname_, stmatname_;
       mutable std::unique_ptr<MatDBInfo> matdbinfo_; // material database
       mutable std::unique_ptr<KKStrawMaterial> smat_; // straw material
+      mutable std::once_flag smatflag_; // fits can run in parallel
   };
 }
 #endif
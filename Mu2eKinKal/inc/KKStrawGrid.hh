@@ -0,0 +1,48 @@
+#ifndef Mu2eKinKal_KKStrawGrid_hh
+#define Mu2eKinKal_KKStrawGrid_hh
+//
+//  Straws of a tracker arranged for finding the straws near a set of points (samples of
+//  a trajectory) without a closest approach calculation for every straw.  Within each panel
+//  the straws are sorted by their position across the panel (v), so the straws near a point
+//  are found with a binary search.  Build one for each tracker (alignment).
+//
+#include "Offline/TrackerGeom/inc/Tracker.hh"
+#include "Offline/DataProducts/inc/StrawId.hh"
+#include "Offline/GeneralUtilities/inc/HepTransform.hh"
+#include "CLHEP/Vector/ThreeVector.h"
+#include <utility>
+#include <vector>
+
+namespace mu2e {
+  class KKStrawGrid {
+    public:
+      using Points = std::vector<CLHEP::Hep3Vector>;
+      // a straw near the points, and the index of the point closest to its axis
+      using NearStraw = std::pair<StrawId,size_t>;
+      explicit KKStrawGrid(Tracker const& tracker);
+      // find the straws whose axis passes within dmax of a point (DS frame), inside the straw
+      // length extended by ubuffer.  Only panels with origin z in [zmin,zmax] are searched.
+      // The straws are returned in StrawId order
+      void nearStraws(Points const& points, double zmin, double zmax, double dmax, double ubuffer,
+          std::vector<NearStraw>& straws) const;
+      size_t nPanels() const { return panels_.size(); }
+    private:
+      struct StrawCell {
+        StrawId id;
+        double v; // position across the panel
+        CLHEP::Hep3Vector mid, dir; // wire center and direction (DS frame)
+        double halflen;
+      };
+      struct PanelCell {
+        HepTransform dsToPanel;
+        double zorigin; // panel origin z (DS frame)
+        double zmin, zmax; // z range of the straw axes (DS frame)
+        double dzdu; // largest |dz/du| of the straw directions
+        double dvdu; // largest |dv/du| of the straw directions
+        double vmargin; // largest change of v between the center and the end of a straw
+        std::vector<StrawCell> straws; // sorted by v
+      };
+      std::vector<PanelCell> panels_;
+  };
+}
+#endif
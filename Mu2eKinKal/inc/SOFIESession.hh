@@ -0,0 +1,20 @@
+#ifndef Mu2eKinKal_SOFIESession_hh
+#define Mu2eKinKal_SOFIESession_hh
+//
+//  Per-thread SOFIE inference sessions.  A session keeps its intermediate tensors
+//  as members, so fits run in parallel each need their own.  Every thread reads
+//  its session of a given weights file the first time it asks for it.
+//
+#include <map>
+#include <memory>
+#include <string>
+
+namespace mu2e {
+  template <class SESSION> SESSION& threadSession(std::string const& wgtsfile) {
+    thread_local std::map<std::string,std::unique_ptr<SESSION>> sessions;
+    auto& session = sessions[wgtsfile];
+    if(!session) session = std::make_unique<SESSION>(wgtsfile);
+    return *session;
+  }
+}
+#endif
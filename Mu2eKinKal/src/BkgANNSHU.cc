@@ -2,17 +2,19 @@
 #include "Offline/RecoDataProducts/inc/ComboHit.hh"
 #include "Offline/Mu2eKinKal/inc/StrawHitUpdaters.hh"
 #include "Offline/ConfigTools/inc/ConfigFileLookupPolicy.hh"
+#include "Offline/Mu2eKinKal/inc/SOFIESession.hh"
 #include "Offline/Mu2eKinKal/inc/TrainBkg.hxx"
 #include <cmath>
 #include <array>
+#include <vector>
 
 namespace mu2e {
   using KinKal::ClosestApproachData;
   using KinKal::VEC3;
   BkgANNSHU::BkgANNSHU(Config const& config) {
     ConfigFileLookupPolicy configFile;
-    auto mvaWgtsFile = configFile(std::get<0>(config));
-    mva_ = std::make_shared<TMVA_SOFIE_TrainBkg::Session>(mvaWgtsFile);
+    mvaWgtsFile_ = configFile(std::get<0>(config));
+    threadSession<TMVA_SOFIE_TrainBkg::Session>(mvaWgtsFile_);
     mvacut_ = std::get<1>(config);
     std::string freeze = std::get<2>(config);
     diag_ = std::get<3>(config);
@@ -35,7 +37,7 @@ namespace mu2e {
       double upos = -endsign*tpdata.sensorDirection().Dot(tpdata.sensorPoca().Vect() - chit.centerPos());
       pars[4] = fabs(chit.wireDist() - upos);
       pars[5] = tpdata.particlePoca().Vect().Rho();
-      auto mvaout = mva_->infer(pars.data());
+      auto mvaout = threadSession<TMVA_SOFIE_TrainBkg::Session>(mvaWgtsFile_).infer(pars.data());
       whstate.quality_[WireHitState::bkg] = mvaout[0];
       whstate.algo_  = StrawHitUpdaters::BkgANN;
       if(mvaout[0] < mvacut_){
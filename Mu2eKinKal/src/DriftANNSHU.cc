@@ -1,19 +1,21 @@
 #include "Offline/Mu2eKinKal/inc/DriftANNSHU.hh"
 #include "Offline/RecoDataProducts/inc/ComboHit.hh"
 #include "Offline/ConfigTools/inc/ConfigFileLookupPolicy.hh"
+#include "Offline/Mu2eKinKal/inc/SOFIESession.hh"
 #include <cmath>
 #include <array>
+#include <vector>
 
 namespace mu2e {
   using KinKal::ClosestApproachData;
   using KinKal::VEC3;
   DriftANNSHU::DriftANNSHU(Config const& config) {
     ConfigFileLookupPolicy configFile;
-    auto signmvaWgtsFile = configFile(std::get<0>(config));
-    signmva_ = std::make_shared<TMVA_SOFIE_TrainSign::Session>(signmvaWgtsFile);
+    signmvaWgtsFile_ = configFile(std::get<0>(config));
+    threadSession<TMVA_SOFIE_TrainSign::Session>(signmvaWgtsFile_);
     signmvacut_ = std::get<1>(config);
-    auto clustermvaWgtsFile = configFile(std::get<2>(config));
-    clustermva_ = std::make_shared<TMVA_SOFIE_TrainCluster::Session>(clustermvaWgtsFile);
+    clustermvaWgtsFile_ = configFile(std::get<2>(config));
+    threadSession<TMVA_SOFIE_TrainCluster::Session>(clustermvaWgtsFile_);
     clustermvacut_ = std::get<3>(config);
     dtmvacut_ = std::get<4>(config);
     std::string freeze = std::get<5>(config);
@@ -47,14 +49,14 @@ namespace mu2e {
       // For sign, noralize only to the crossing angle, as there it serves as an estimate of the drift radius
       double sint = sqrt(1.0-tpdata.dirDot()*tpdata.dirDot());
       spars[4] = chit.energyDep()*sint;
-      auto signmvaout = signmva_->infer(spars.data());
       cpars[0] = fabs(tpdata.doca());
       cpars[1] = dinfo.cDrift_;
       cpars[2] = chit.driftTime();
       // For drift quality, normalize to the estimated path length through the straw, as that measures the clustering effects
       double plen = sqrt(std::max(0.25, 6.25-dinfo.rDrift_*dinfo.rDrift_))/sint;
       cpars[3] = chit.energyDep()/plen;
-      auto clustermvaout = clustermva_->infer(cpars.data());
+      auto signmvaout = threadSession<TMVA_SOFIE_TrainSign::Session>(signmvaWgtsFile_).infer(spars.data());
+      auto clustermvaout = threadSession<TMVA_SOFIE_TrainCluster::Session>(clustermvaWgtsFile_).infer(cpars.data());
       if(diag_ > 2)std::cout << std::setw(8) << std::setprecision(5)
         << "Drift ANN inputs: doca, cdrift, sigdoca, TOTdrift, EDep "
           << spars[0] << " , "
@@ -0,0 +1,110 @@
+#include "Offline/Mu2eKinKal/inc/KKGridBField.hh"
+#include "cetlib_except/exception.h"
+#include <algorithm>
+#include <cmath>
+namespace mu2e {
+  using Grad = ROOT::Math::SMatrix<double,3>;
+  using SVEC3 = KinKal::SVEC3;
+
+  KKGridBField::KKGridBField(std::vector<double> const& lower, std::vector<double> const& upper, double spacing,
+      BFieldManager const& bfmgr, DetectorSystem const& det) :
+    full_(bfmgr,det), spacing_(spacing) {
+    if(lower.size() != 3 || upper.size() != 3 || spacing_ <= 0.0)
+      throw cet::exception("RECO")<<"mu2e::KKGridBField: configuration error; Lower and Upper need 3 values and Spacing must be positive" << std::endl;
+    for(size_t idim=0;idim<3;++idim){
+      if(upper[idim] <= lower[idim])
+        throw cet::exception("RECO")<<"mu2e::KKGridBField: configuration error; empty grid along axis " << idim << std::endl;
+      lower_[idim] = lower[idim];
+      npts_[idim] = static_cast<unsigned>(std::ceil((upper[idim]-lower[idim])/spacing_)) + 1;
+      upper_[idim] = lower_[idim] + (npts_[idim]-1)*spacing_;
+    }
+    // sample the field at each grid point, and its gradient by central differences over half a cell
+    double const hstep = 0.5*spacing_;
+    static const std::array<VEC3,3> axes = {VEC3(1.0,0.0,0.0), VEC3(0.0,1.0,0.0), VEC3(0.0,0.0,1.0)};
+    nodes_.resize(size_t(npts_[0])*npts_[1]*npts_[2]);
+    for(unsigned ix=0;ix<npts_[0];++ix){
+      for(unsigned iy=0;iy<npts_[1];++iy){
+        for(unsigned iz=0;iz<npts_[2];++iz){
+          VEC3 pos(lower_[0]+ix*spacing_, lower_[1]+iy*spacing_, lower_[2]+iz*spacing_);
+          auto& nd = nodes_[(size_t(ix)*npts_[1] + iy)*npts_[2] + iz];
+          auto bf = full_.fieldVect(pos);
+          nd.field = {bf.X(), bf.Y(), bf.Z()};
+          for(size_t jdim=0;jdim<3;++jdim){
+            auto db = (full_.fieldVect(pos + hstep*axes[jdim]) - full_.fieldVect(pos - hstep*axes[jdim]))/(2.0*hstep);
+            nd.grad[jdim] = {db.X(), db.Y(), db.Z()};
+          }
+        }
+      }
+    }
+  }
+
+  bool KKGridBField::inGrid(VEC3 const& position) const {
+    return position.X() >= lower_[0] && position.X() <= upper_[0] &&
+      position.Y() >= lower_[1] && position.Y() <= upper_[1] &&
+      position.Z() >= lower_[2] && position.Z() <= upper_[2];
+  }
+
+  void KKGridBField::interpolate(VEC3 const& position, Node& value, bool withgrad) const {
+    double pos[3] = {position.X(), position.Y(), position.Z()};
+    unsigned icell[3];
+    double frac[3];
+    for(size_t idim=0;idim<3;++idim){
+      double u = (pos[idim]-lower_[idim])/spacing_;
+      // points on the upper face belong to the last cell
+      icell[idim] = std::min(static_cast<unsigned>(u), npts_[idim]-2);
+      frac[idim] = u - icell[idim];
+    }
+    value.field = {0.0,0.0,0.0};
+    if(withgrad) value.grad = {};
+    for(unsigned icorner=0;icorner<8;++icorner){
+      unsigned dx = (icorner>>2)&1, dy = (icorner>>1)&1, dz = icorner&1;
+      double weight = (dx ? frac[0] : 1.0-frac[0])*(dy ? frac[1] : 1.0-frac[1])*(dz ? frac[2] : 1.0-frac[2]);
+      auto const& nd = node(icell[0]+dx,icell[1]+dy,icell[2]+dz);
+      for(size_t idim=0;idim<3;++idim)value.field[idim] += weight*nd.field[idim];
+      if(withgrad){
+        for(size_t jdim=0;jdim<3;++jdim)
+          for(size_t idim=0;idim<3;++idim)value.grad[jdim][idim] += weight*nd.grad[jdim][idim];
+      }
+    }
+  }
+
+  VEC3 KKGridBField::fieldVect(VEC3 const& position) const {
+    if(!inGrid(position))return full_.fieldVect(position);
+    Node value;
+    interpolate(position,value,false);
+    return VEC3(value.field[0],value.field[1],value.field[2]);
+  }
+
+  Grad KKGridBField::fieldGrad(VEC3 const& position) const {
+    if(!inGrid(position))return full_.fieldGrad(position);
+    Node value;
+    interpolate(position,value,true);
+    Grad retval;
+    for(size_t jdim=0;jdim<3;++jdim)
+      retval.Place_in_row(SVEC3(value.grad[jdim][0],value.grad[jdim][1],value.grad[jdim][2]),jdim,0);
+    return retval;
+  }
+
+  VEC3 KKGridBField::fieldDeriv(VEC3 const& position, VEC3 const& velocity) const {
+    if(!inGrid(position))return full_.fieldDeriv(position,velocity);
+    Node value;
+    interpolate(position,value,true);
+    double vel[3] = {velocity.X(), velocity.Y(), velocity.Z()};
+    double deriv[3] = {0.0,0.0,0.0};
+    for(size_t jdim=0;jdim<3;++jdim)
+      for(size_t idim=0;idim<3;++idim)deriv[idim] += vel[jdim]*value.grad[jdim][idim];
+    return VEC3(deriv[0],deriv[1],deriv[2]);
+  }
+
+  bool KKGridBField::inRange(VEC3 const& position) const {
+    return inGrid(position) || full_.inRange(position);
+  }
+
+  void KKGridBField::print(std::ostream& os) const {
+    os << "KKGridBField " << npts_[0] << " x " << npts_[1] << " x " << npts_[2]
+      << " points, spacing " << spacing_ << " mm, from (" << lower_[0] << "," << lower_[1] << "," << lower_[2]
+      << ") to (" << upper_[0] << "," << upper_[1] << "," << upper_[2] << ") in detector coordinates; outside the grid ";
+    full_.print(os);
+  }
+
+}
@@ -25,7 +25,7 @@ namespace mu2e {
 
   KKStrawMaterial const& KKMaterial::strawMaterial() const {
     // deferred construction as this object depends on the tracker, which is created at beginJob
-    if(smat_ == nullptr){
+    std::call_once(smatflag_,[this](){
       Tracker const & tracker = *(GeomHandle<Tracker>());
       auto const& sprop = tracker.strawProperties();
       smat_ = std::make_unique<KKStrawMaterial>(
@@ -33,7 +33,7 @@ namespace mu2e {
           matdbinfo_->findDetMaterial(wallmatname_),
           matdbinfo_->findDetMaterial(gasmatname_),
           matdbinfo_->findDetMaterial(wirematname_));
-    }
+    });
     return *smat_;
   }
 }
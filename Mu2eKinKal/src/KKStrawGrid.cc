@@ -0,0 +1,83 @@
+#include "Offline/Mu2eKinKal/inc/KKStrawGrid.hh"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <unordered_map>
+
+namespace mu2e {
+  KKStrawGrid::KKStrawGrid(Tracker const& tracker) {
+    for(auto const& plane : tracker.planes()){
+      if(!tracker.planeExists(plane.id()))continue;
+      for(auto panel_p : plane.panels()){
+        auto const& panel = *panel_p;
+        PanelCell pc;
+        pc.dsToPanel = panel.dsToPanel();
+        pc.zorigin = panel.origin().z();
+        pc.zmin = std::numeric_limits<double>::max();
+        pc.zmax = -std::numeric_limits<double>::max();
+        pc.dzdu = pc.dvdu = pc.vmargin = 0.0;
+        pc.straws.reserve(panel.nStraws());
+        for(unsigned istr = 0; istr < panel.nStraws(); ++istr){
+          auto const& straw = panel.getStraw(istr);
+          StrawCell sc;
+          sc.id = straw.id();
+          sc.mid = straw.origin();
+          sc.dir = straw.wireDirection();
+          sc.halflen = straw.halfLength();
+          auto pmid = pc.dsToPanel*sc.mid;
+          sc.v = pmid.y();
+          for(int iend = -1; iend <= 1; iend += 2){
+            auto end = sc.mid + iend*sc.halflen*sc.dir;
+            auto pend = pc.dsToPanel*end;
+            pc.zmin = std::min(pc.zmin,end.z());
+            pc.zmax = std::max(pc.zmax,end.z());
+            double dv = std::fabs(pend.y()-sc.v);
+            pc.vmargin = std::max(pc.vmargin,dv);
+            pc.dvdu = std::max(pc.dvdu,dv/sc.halflen);
+          }
+          pc.dzdu = std::max(pc.dzdu,std::fabs(sc.dir.z()));
+          pc.straws.push_back(sc);
+        }
+        std::sort(pc.straws.begin(),pc.straws.end(),[](StrawCell const& a, StrawCell const& b){ return a.v < b.v; });
+        panels_.push_back(std::move(pc));
+      }
+    }
+  }
+
+  void KKStrawGrid::nearStraws(Points const& points, double zmin, double zmax, double dmax, double ubuffer,
+      std::vector<NearStraw>& straws) const {
+    straws.clear();
+    std::vector<PanelCell const*> panels;
+    for(auto const& pc : panels_){
+      if(pc.zorigin >= zmin && pc.zorigin <= zmax)panels.push_back(&pc);
+    }
+    if(panels.empty())return;
+    double dmax2 = dmax*dmax;
+    // closest point to each straw: squared distance and point index
+    std::unordered_map<uint16_t,std::pair<double,size_t>> closest;
+    for(size_t ipt = 0; ipt < points.size(); ++ipt){
+      auto const& point = points[ipt];
+      for(auto pc : panels){
+        // a point near a straw axis is near the panel in z, and near the straw in v
+        double zbuffer = dmax + pc->dzdu*ubuffer;
+        if(point.z() < pc->zmin - zbuffer || point.z() > pc->zmax + zbuffer)continue;
+        auto ppos = pc->dsToPanel*point;
+        double vbuffer = dmax + pc->vmargin + pc->dvdu*ubuffer;
+        auto first = std::lower_bound(pc->straws.begin(),pc->straws.end(),ppos.y()-vbuffer,
+            [](StrawCell const& sc, double v){ return sc.v < v; });
+        for(auto isc = first; isc != pc->straws.end() && isc->v <= ppos.y()+vbuffer; ++isc){
+          auto dpos = point - isc->mid;
+          double du = dpos.dot(isc->dir);
+          if(std::fabs(du) > isc->halflen + ubuffer)continue;
+          double d2 = dpos.mag2() - du*du;
+          if(d2 > dmax2)continue;
+          auto inserted = closest.emplace(isc->id.asUint16(),std::make_pair(d2,ipt));
+          if(!inserted.second && d2 < inserted.first->second.first)inserted.first->second = std::make_pair(d2,ipt);
+        }
+      }
+    }
+    straws.reserve(closest.size());
+    for(auto const& straw : closest)straws.emplace_back(StrawId(straw.first),straw.second.second);
+    std::sort(straws.begin(),straws.end(),[](NearStraw const& a, NearStraw const& b){ return a.first < b.first; });
+  }
+}
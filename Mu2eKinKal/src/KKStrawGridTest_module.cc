@@ -0,0 +1,170 @@
+//
+// Check the straw search of KKFit for near-vertical tracks: the straws found with KKStrawGrid
+// (KKFit::verticalStraws) must be the same as those of the original search, which tests every
+// straw of the panels near the track t0 z.  The tracks are straight lines through the tracker
+// on a grid of positions and slopes; the job throws at the end if any line differs.
+//
+// framework
+#include "fhiclcpp/types/Atom.h"
+#include "fhiclcpp/types/Sequence.h"
+#include "fhiclcpp/types/Table.h"
+#include "art/Framework/Core/EDAnalyzer.h"
+#include "art/Framework/Principal/Event.h"
+#include "cetlib_except/exception.h"
+// conditions
+#include "Offline/GlobalConstantsService/inc/GlobalConstantsHandle.hh"
+#include "Offline/GlobalConstantsService/inc/ParticleDataList.hh"
+#include "Offline/ProditionsService/inc/ProditionsHandle.hh"
+#include "Offline/TrackerGeom/inc/Tracker.hh"
+#include "Offline/DataProducts/inc/PDGCode.hh"
+// KinKal
+#include "KinKal/Trajectory/KinematicLine.hh"
+#include "KinKal/Trajectory/ParticleTrajectory.hh"
+// Mu2eKinKal
+#include "Offline/Mu2eKinKal/inc/KKFit.hh"
+#include "Offline/Mu2eKinKal/inc/KKFitSettings.hh"
+#include "Offline/Mu2eKinKal/inc/KKFitUtilities.hh"
+// C++
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <set>
+#include <vector>
+
+namespace mu2e {
+  using KTRAJ = KinKal::KinematicLine;
+  using KKFIT = KKFit<KTRAJ>;
+  using PTRAJ = KKFIT::PTRAJ;
+  using PCA = KKFIT::PCA;
+  using KinKal::VEC3;
+  using KinKal::DMAT;
+  using KinKal::TimeRange;
+  using KinKal::CAHint;
+
+  class KKStrawGridTest : public art::EDAnalyzer {
+    public:
+      using Name    = fhicl::Name;
+      using Comment = fhicl::Comment;
+      struct Config {
+        fhicl::Table<Mu2eKinKal::KKFitConfig> mu2eSettings { Name("KKFitSettings") };
+        fhicl::Sequence<float> xpos { Name("XPositions"), Comment("x of the lines at y=0 (mm)") };
+        fhicl::Sequence<float> zpos { Name("ZPositions"), Comment("z of the lines at y=0 (mm)") };
+        fhicl::Sequence<float> slopes { Name("Slopes"), Comment("dz/dy of the lines") };
+        fhicl::Atom<float> length { Name("RangeLength"), Comment("length of the trajectory range, centered on y=0 (mm)") };
+        fhicl::Atom<float> mom { Name("Momentum"), Comment("muon momentum (MeV/c)"), 1000.0 };
+        fhicl::Sequence<float> seederrors { Name("SeedErrors"), Comment("Initial value of seed parameter errors (rms, various units)") };
+      };
+      using Parameters = art::EDAnalyzer::Table<Config>;
+      explicit KKStrawGridTest(const Parameters& settings);
+      void analyze(const art::Event& event) override;
+      void endJob() override;
+    private:
+      // the original search, testing all straws of the panels near the t0 z
+      void allStraws(Tracker const& tracker, PTRAJ const& ptraj, std::set<StrawId>& straws) const;
+      ProditionsHandle<Tracker> alignedTracker_h_;
+      KKFIT kkfit_;
+      std::vector<float> xpos_, zpos_, slopes_;
+      double length_, mom_;
+      DMAT seedcov_;
+      unsigned nlines_ = 0, nbad_ = 0, nstraws_ = 0;
+      double tgrid_ = 0.0, tall_ = 0.0; // search times (ms)
+  };
+
+  KKStrawGridTest::KKStrawGridTest(const Parameters& settings) : art::EDAnalyzer{settings},
+    kkfit_(settings().mu2eSettings()),
+    xpos_(settings().xpos()),
+    zpos_(settings().zpos()),
+    slopes_(settings().slopes()),
+    length_(settings().length()),
+    mom_(settings().mom())
+  {
+    auto const& seederrors = settings().seederrors();
+    if(seederrors.size() != KinKal::NParams())
+      throw cet::exception("RECO")<<"mu2e::KKStrawGridTest: Seed error configuration error"<< std::endl;
+    for(size_t ipar=0;ipar < seederrors.size(); ++ipar){
+      seedcov_[ipar][ipar] = seederrors[ipar]*seederrors[ipar];
+    }
+  }
+
+  void KKStrawGridTest::allStraws(Tracker const& tracker, PTRAJ const& ptraj, std::set<StrawId>& straws) const {
+    auto t0pos = ptraj.position3(ptraj.t0());
+    for(auto const& plane : tracker.planes()){
+      if(tracker.planeExists(plane.id())) {
+        for(auto panel_p : plane.panels()){
+          auto const& panel = *panel_p;
+          double zbuffer = 2*kkfit_.strawRadius()*(1+kkfit_.maxDStraw());
+          if (panel.origin().z() > t0pos.Z()+zbuffer || panel.origin().z() < t0pos.Z()-zbuffer){
+            continue;
+          }
+          double t = ptraj.t0();
+          // test all straws
+          for(unsigned istr = 0; istr < panel.nStraws(); ++istr){
+            auto const& straw = panel.getStraw(istr);
+            auto sline = Mu2eKinKal::strawLine(straw,t); // line down the straw axis center
+            CAHint hint(t,t);
+            // compute PCA between the trajectory and this straw
+            PCA pca(ptraj, sline, hint, kkfit_.tpocaPrecision() );
+            t = pca.particleToca();
+            // require consistency with this track passing through this straw
+            double du = fabs((pca.sensorPoca().Vect()-VEC3(straw.wirePosition(0.0))).Dot(VEC3(straw.wireDirection(0.0))));
+            double doca = fabs(pca.doca());
+            double dsig = std::max(0.0,doca-kkfit_.strawRadius())/sqrt(pca.docaVar());
+            if(doca < kkfit_.maxStrawDoca() && dsig < kkfit_.maxStrawDocaConsistency() && du < straw.halfLength() + kkfit_.maxStrawUposBuffer()){
+              straws.insert(straw.id());
+            }
+          } // straws loop
+        }
+      }
+    }
+  }
+
+  void KKStrawGridTest::analyze(const art::Event& event) {
+    auto const& tracker = *alignedTracker_h_.getPtr(event.id());
+    auto const& ptable = GlobalConstantsHandle<ParticleDataList>();
+    auto const& muon = ptable->particle(PDGCode::mu_minus);
+    VEC3 bnom(0.0,0.0,0.001); // lines don't depend on the field
+    for(auto xpos : xpos_){
+      for(auto zpos : zpos_){
+        for(auto slope : slopes_){
+          // downward going line through (xpos,0,zpos) at t=0
+          VEC3 dir = VEC3(0.0,-1.0,slope).Unit();
+          KinKal::VEC4 pos(xpos,0.0,zpos,0.0);
+          KinKal::MOM4 mom(mom_*dir.X(),mom_*dir.Y(),mom_*dir.Z(),muon.mass());
+          KTRAJ ktraj(pos,mom,static_cast<int>(muon.charge()),bnom,TimeRange(-1.0,1.0));
+          double dt = 0.5*length_/ktraj.speed(0.0);
+          ktraj.range() = TimeRange(-dt,dt);
+          ktraj.params().covariance() = seedcov_;
+          PTRAJ ptraj(ktraj);
+          KKFIT::StrawFlags nostraws;
+          std::vector<std::pair<Straw const*,PCA>> gridstraws;
+          auto start = std::chrono::steady_clock::now();
+          kkfit_.verticalStraws(tracker,ptraj,nostraws,gridstraws);
+          auto mid = std::chrono::steady_clock::now();
+          std::set<StrawId> refstraws;
+          allStraws(tracker,ptraj,refstraws);
+          auto end = std::chrono::steady_clock::now();
+          tgrid_ += std::chrono::duration<double,std::milli>(mid-start).count();
+          tall_ += std::chrono::duration<double,std::milli>(end-mid).count();
+          std::set<StrawId> teststraws;
+          for(auto const& gridstraw : gridstraws) teststraws.insert(gridstraw.first->id());
+          ++nlines_;
+          nstraws_ += refstraws.size();
+          if(teststraws != refstraws){
+            ++nbad_;
+            std::cout << "KKStrawGridTest: line x " << xpos << " z " << zpos << " dz/dy " << slope
+              << " found " << teststraws.size() << " straws, all straws search " << refstraws.size() << std::endl;
+          }
+        }
+      }
+    }
+  }
+
+  void KKStrawGridTest::endJob() {
+    std::cout << "KKStrawGridTest: " << nbad_ << " of " << nlines_ << " lines differ, " << nstraws_ << " straws found by the all straws search" << std::endl;
+    std::cout << "KKStrawGridTest: straw grid search " << tgrid_ << " ms, all straws search " << tall_ << " ms" << std::endl;
+    if(nbad_ > 0)
+      throw cet::exception("RECO") << "mu2e::KKStrawGridTest: " << nbad_ << " lines with different straws\n";
+  }
+}
+
+DEFINE_ART_MODULE(mu2e::KKStrawGridTest)
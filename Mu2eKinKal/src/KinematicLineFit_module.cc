@@ -50,11 +50,15 @@
 #include "Offline/Mu2eKinKal/inc/KKMaterial.hh"
 #include "Offline/Mu2eKinKal/inc/KKStrawHit.hh"
 #include "Offline/Mu2eKinKal/inc/KKBField.hh"
+#include "Offline/Mu2eKinKal/inc/KKGridBField.hh"
 #include "Offline/Mu2eKinKal/inc/KKFitUtilities.hh"
 #include "Offline/Mu2eKinKal/inc/ExtrapolateTCRV.hh"
 // root
 #include "TH1F.h"
 #include "TTree.h"
+// TBB
+#include "tbb/parallel_for.h"
+#include "tbb/task_arena.h"
 // C++
 #include <iostream>
 #include <fstream>
@@ -117,6 +121,7 @@ namespace mu2e {
       fhicl::Atom<bool> sampleInBounds { Name("SampleInBounds"), Comment("Require sample intersection point be inside surface bounds (within tolerance)") };
       fhicl::Atom<float> interTol { Name("IntersectionTolerance"), Comment("Tolerance for surface intersections (mm)") };
       fhicl::Atom<float> sampleTBuff { Name("SampleTimeBuffer"), Comment("Time buffer for sample intersections (nsec)") };
+      fhicl::OptionalTable<KKGridBField::Config> gridBField { Name("GridBField"), Comment("Precompute the BField on this grid in the detector system") };
     };
 
     // Extrapolation configuration
@@ -146,6 +151,9 @@ namespace mu2e {
     private:
     // utility functions
     KTRAJ makeSeedTraj(CosmicTrackSeed const& hseed) const;
+    // fit one seed.  This only reads the module and the inputs, so seeds can be fit in parallel
+    std::unique_ptr<KKTRK> fitTrack(Tracker const& tracker, StrawResponse const& strawresponse, Calorimeter const& calo,
+        ComboHitCollection const& chcol, CCHandle const& cc_H, CosmicTrackSeed const& hseed) const;
     bool goodFit(KKTRK const& ktrk) const;
     void sampleFit(KKTRK& kktrk) const;
     void extrapolate(KKTRK& ktrk) const;
@@ -167,7 +175,10 @@ namespace mu2e {
     std::array<double,KinKal::NParams()> paramconstraints_;
     double mass_; // particle mass
     int charge_; // particle charge
-    std::unique_ptr<KKBField> kkbf_;
+    std::unique_ptr<KinKal::BFieldMap> kkbf_;
+    bool gridfield_; // use a precomputed BField grid in the detector system
+    std::vector<double> gridlower_, gridupper_; // grid corners
+    double gridspacing_; // grid spacing
     double intertol_; // surface intersection tolerance (mm)
     double sampletbuff_; // simple time buffer; replace this with extrapolation TODO
     bool sampleinrange_, sampleinbounds_; // require samples to be in range or on surface
@@ -177,6 +188,8 @@ namespace mu2e {
     double tcrvthick_ = 0.1056; // st foil thickness: should come from geometry service TODO
     Config config_; // initial fit configuration object
     Config exconfig_; // extension configuration object
+    std::unique_ptr<tbb::task_arena> arena_; // parallel fitting
+    int fitprint_; // print level inside fitTrack: fits run in parallel would interleave their output
   };
 
   KinematicLineFit::KinematicLineFit(const Parameters& settings) : art::EDProducer{settings},
@@ -189,6 +202,8 @@ namespace mu2e {
     fpart_(static_cast<PDGCode::type>(settings().modSettings().fitParticle())),
     kkfit_(settings().mu2eSettings()),
     kkmat_(settings().matSettings()),
+    gridfield_(settings().modSettings().gridBField().has_value()),
+    gridspacing_(0.0),
     intertol_(settings().modSettings().interTol()),
     sampletbuff_(settings().modSettings().sampleTBuff()),
     sampleinrange_(settings().modSettings().sampleInRange()),
@@ -204,6 +219,9 @@ namespace mu2e {
       produces<KKTRKCOL>();
       produces<KalSeedCollection>();
       produces<KalLineAssns>();
+      if(settings().modSettings().nthreads() > 0)
+        arena_ = std::make_unique<tbb::task_arena>(static_cast<int>(settings().modSettings().nthreads()));
+      fitprint_ = arena_ ? 0 : print_;
       // build the initial seed covariance
       auto const& seederrors = settings().modSettings().seederrors();
       if(seederrors.size() != KinKal::NParams())
@@ -229,6 +247,11 @@ namespace mu2e {
       // geometry service eventually, TODO
       SurfaceMap smap;
       smap.surfaces(ssids,sample_);
+      if(gridfield_){
+        gridlower_ = settings().modSettings().gridBField()->lower();
+        gridupper_ = settings().modSettings().gridBField()->upper();
+        gridspacing_ = settings().modSettings().gridBField()->spacing();
+      }
       // configure extrapolation
       if(settings().Extrapolation()){
         extrapolate_ = true;
@@ -257,7 +280,10 @@ namespace mu2e {
     // create KKBField
     GeomHandle<BFieldManager> bfmgr;
     GeomHandle<DetectorSystem> det;
-    kkbf_ = std::make_unique<KKBField>(*bfmgr,*det);
+    if(gridfield_)
+      kkbf_ = std::make_unique<KKGridBField>(gridlower_,gridupper_,gridspacing_,*bfmgr,*det);
+    else
+      kkbf_ = std::make_unique<KKBField>(*bfmgr,*det);
   }
 
   void KinematicLineFit::produce(art::Event& event ) {
@@ -276,6 +302,12 @@ namespace mu2e {
     unique_ptr<KalLineAssns> kkseedassns(new KalLineAssns());
     auto KalSeedCollectionPID = event.getProductID<KalSeedCollection>();
     auto KalSeedCollectionGetter = event.productGetter(KalSeedCollectionPID);
+    // the seeds to fit, in the order the results are saved
+    struct SeedFit {
+      HPtr hptr;
+      std::unique_ptr<KKTRK> kktrk;
+    };
+    std::vector<SeedFit> fits;
     // find the track seed collections
     unsigned nseed(0);
     for (auto const& hseedtag : seedCols_) {
@@ -284,66 +316,43 @@ namespace mu2e {
       nseed += hseedcol.size();
       // loop over the seeds
       for(size_t iseed=0; iseed < hseedcol.size(); ++iseed) {
-        auto const& hseed = hseedcol[iseed];
-        auto hptr = HPtr(hseedcol_h,iseed);
         // check helicity.  The test on the charge and helicity
-        if(hseed.status().hasAllProperties(goodline_) ){
-          // construt the seed trajectory
-          KTRAJ seedtraj = makeSeedTraj(hseed);
-          // wrap the seed traj in a Piecewise traj: needed to satisfy PTOCA interface
-          PTRAJ pseedtraj(seedtraj);
-          // first, we need to unwind the combohits.  We use this also to find the time range
-          StrawHitIndexCollection strawHitIdxs;
-          auto chcolptr = hseed.hits().fillStrawHitIndices(strawHitIdxs, StrawIdMask::uniquestraw);
-//          if(chcolptr != &chcol)
-//            throw cet::exception("RECO")<<"mu2e::KinematicLineFit: inconsistent ComboHitCollection" << std::endl;
-          // next, build straw hits and materials from these
-          KKSTRAWHITCOL strawhits;
-          KKSTRAWXINGCOL strawxings;
-          strawhits.reserve(strawHitIdxs.size());
-          strawxings.reserve(strawHitIdxs.size());
-          kkfit_.makeStrawHits(*tracker, *strawresponse, *kkbf_, kkmat_.strawMaterial(), pseedtraj, *chcolptr, strawHitIdxs, strawhits, strawxings);
+        if(hseedcol[iseed].status().hasAllProperties(goodline_) )fits.push_back(SeedFit{HPtr(hseedcol_h,iseed),nullptr});
+      }
+    }
 
-          //here
-          KKCALOHITCOL calohits;
-          //if (kkfit_.useCalo()) kkfit_.makeCaloHit(hptr->caloCluster(),*calo_h, pseedtraj, calohits); --> CosmicTrackSeed has no CaloClusters....
+    // fit the seeds.  The fits are independent, so they can run in parallel
+    auto fitseed = [&](SeedFit& fit) {
+      fit.kktrk = fitTrack(*tracker, *strawresponse, *calo_h, chcol, cc_H, *fit.hptr);
+    };
+    if(arena_ && fits.size() > 1){
+      arena_->execute([&]{
+          tbb::parallel_for(size_t(0),fits.size(),[&](size_t ifit){ fitseed(fits[ifit]); });
+          });
+    } else {
+      for(auto& fit : fits) fitseed(fit);
+    }
 
-          if(print_ > 2){
-            for(auto const& strawhit : strawhits) strawhit->print(std::cout,2);
-            for(auto const& calohit : calohits) calohit->print(std::cout,2);
-            for(auto const& strawxing :strawxings) strawxing->print(std::cout,2);
-          }
-          // set the seed range given the hit TPOCA values
-          seedtraj.range() = kkfit_.range(strawhits,calohits, strawxings);
-          if(print_ > 0){
-            //std::cout << "Seed line parameters " << hseed.track() << std::endl;
-            seedtraj.print(std::cout,print_);
-          }
-          // create and fit the track
-          auto kktrk = make_unique<KKTRK>(config_,*kkbf_,seedtraj,fpart_,kkfit_.strawHitClusterer(),strawhits,strawxings,calohits,paramconstraints_);
-          auto goodfit = goodFit(*kktrk);
-          if(goodfit && exconfig_.schedule().size() > 0){
-            kkfit_.extendTrack(exconfig_,*kkbf_, *tracker,*strawresponse, kkmat_.strawMaterial(), chcol, *calo_h, cc_H, *kktrk );
-          }
-          goodfit = goodFit(*kktrk);
-          // extrapolate as required
-          if(goodfit && extrapolate_) extrapolate(*kktrk);
-          bool save = goodFit(*kktrk);
-          if(save || saveall_){
-            TrkFitFlag fitflag(hptr->status());
-            fitflag.merge(TrkFitFlag::KKLine);
-            sampleFit(*kktrk);
-            auto kkseed = kkfit_.createSeed(*kktrk,fitflag,*calo_h,*nominalTracker_h);
-            kkseedcol->push_back(kkseed);
-            kkseedcol->back()._status.merge(TrkFitFlag::KKLine);
-            // fill assns with the cosmic seed
-            auto hptr = art::Ptr<CosmicTrackSeed>(hseedcol_h,iseed);
-            auto kseedptr = art::Ptr<KalSeed>(KalSeedCollectionPID,kkseedcol->size()-1,KalSeedCollectionGetter);
-            kkseedassns->addSingle(kseedptr,hptr);
-            // save (unpersistable) KKTrk in the event
-            kktrkcol->push_back(kktrk.release());
-          }
-        }
+    // save the results in seed order.  Extrapolation uses the cached intersection of TCRV_, so it stays serial
+    for(auto& fit : fits) {
+      auto& kktrk = fit.kktrk;
+      auto goodfit = goodFit(*kktrk);
+      // extrapolate as required
+      if(goodfit && extrapolate_) extrapolate(*kktrk);
+      bool save = goodFit(*kktrk);
+      if(save || saveall_){
+        auto const& hptr = fit.hptr;
+        TrkFitFlag fitflag(hptr->status());
+        fitflag.merge(TrkFitFlag::KKLine);
+        sampleFit(*kktrk);
+        auto kkseed = kkfit_.createSeed(*kktrk,fitflag,*calo_h,*nominalTracker_h);
+        kkseedcol->push_back(kkseed);
+        kkseedcol->back()._status.merge(TrkFitFlag::KKLine);
+        // fill assns with the cosmic seed
+        auto kseedptr = art::Ptr<KalSeed>(KalSeedCollectionPID,kkseedcol->size()-1,KalSeedCollectionGetter);
+        kkseedassns->addSingle(kseedptr,hptr);
+        // save (unpersistable) KKTrk in the event
+        kktrkcol->push_back(kktrk.release());
       }
     }
     // put the output products into the event
@@ -353,6 +362,48 @@ namespace mu2e {
     event.put(move(kkseedassns));
   }
 
+  std::unique_ptr<KKTRK> KinematicLineFit::fitTrack(Tracker const& tracker, StrawResponse const& strawresponse, Calorimeter const& calo,
+      ComboHitCollection const& chcol, CCHandle const& cc_H, CosmicTrackSeed const& hseed) const {
+    // construt the seed trajectory
+    KTRAJ seedtraj = makeSeedTraj(hseed);
+    // wrap the seed traj in a Piecewise traj: needed to satisfy PTOCA interface
+    PTRAJ pseedtraj(seedtraj);
+    // first, we need to unwind the combohits.  We use this also to find the time range
+    StrawHitIndexCollection strawHitIdxs;
+    auto chcolptr = hseed.hits().fillStrawHitIndices(strawHitIdxs, StrawIdMask::uniquestraw);
+//    if(chcolptr != &chcol)
+//      throw cet::exception("RECO")<<"mu2e::KinematicLineFit: inconsistent ComboHitCollection" << std::endl;
+    // next, build straw hits and materials from these
+    KKSTRAWHITCOL strawhits;
+    KKSTRAWXINGCOL strawxings;
+    strawhits.reserve(strawHitIdxs.size());
+    strawxings.reserve(strawHitIdxs.size());
+    kkfit_.makeStrawHits(tracker, strawresponse, *kkbf_, kkmat_.strawMaterial(), pseedtraj, *chcolptr, strawHitIdxs, strawhits, strawxings);
+
+    //here
+    KKCALOHITCOL calohits;
+    //if (kkfit_.useCalo()) kkfit_.makeCaloHit(hptr->caloCluster(),calo, pseedtraj, calohits); --> CosmicTrackSeed has no CaloClusters....
+
+    if(fitprint_ > 2){
+      for(auto const& strawhit : strawhits) strawhit->print(std::cout,2);
+      for(auto const& calohit : calohits) calohit->print(std::cout,2);
+      for(auto const& strawxing :strawxings) strawxing->print(std::cout,2);
+    }
+    // set the seed range given the hit TPOCA values
+    seedtraj.range() = kkfit_.range(strawhits,calohits, strawxings);
+    if(fitprint_ > 0){
+      //std::cout << "Seed line parameters " << hseed.track() << std::endl;
+      seedtraj.print(std::cout,fitprint_);
+    }
+    // create and fit the track
+    auto kktrk = make_unique<KKTRK>(config_,*kkbf_,seedtraj,fpart_,kkfit_.strawHitClusterer(),strawhits,strawxings,calohits,paramconstraints_);
+    auto goodfit = goodFit(*kktrk);
+    if(goodfit && exconfig_.schedule().size() > 0){
+      kkfit_.extendTrack(exconfig_,*kkbf_, tracker,strawresponse, kkmat_.strawMaterial(), chcol, calo, cc_H, *kktrk );
+    }
+    return kktrk;
+  }
+
   KTRAJ KinematicLineFit::makeSeedTraj(CosmicTrackSeed const& hseed) const {
     //exctract CosmicTrack (contains parameters)
     VEC3 bnom(0.0,0.0,0.001);// non-zero value doesn't affect fit, but insures consistency with interfaces.
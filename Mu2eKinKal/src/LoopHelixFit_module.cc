@@ -63,8 +63,12 @@
 #include "Offline/Mu2eKinKal/inc/KKCaloHit.hh"
 #include "Offline/Mu2eKinKal/inc/KKBField.hh"
 #include "Offline/Mu2eKinKal/inc/KKConstantBField.hh"
+#include "Offline/Mu2eKinKal/inc/KKGridBField.hh"
 #include "Offline/Mu2eKinKal/inc/KKFitUtilities.hh"
 #include "Offline/Mu2eKinKal/inc/KKExtrap.hh"
+// TBB
+#include "tbb/parallel_for.h"
+#include "tbb/task_arena.h"
 // C++
 #include <iostream>
 #include <string>
@@ -125,6 +129,7 @@ namespace mu2e {
   struct KKLHModuleConfig : KKModuleConfig {
     fhicl::Sequence<art::InputTag> seedCollections {Name("HelixSeedCollections"), Comment("Seed fit collections to be processed ") };
     fhicl::OptionalAtom<double> fixedBField { Name("ConstantBField"), Comment("Constant BField value") };
+    fhicl::OptionalTable<KKGridBField::Config> gridBField { Name("GridBField"), Comment("Precompute the BField on this grid in the detector system") };
   };
   struct HelixMaskConfig {
     fhicl::OptionalAtom<float> minHelixP{ Name("MinHelixMom"), Comment("Minimum Momentum of a helix for a track to be fit.")};
@@ -158,7 +163,10 @@ namespace mu2e {
       bool goodFit(KKTRK const& ktrk,KTRAJ const& seed) const;
       bool goodHelix(HelixSeed const& hseed) const;
       std::vector<TrkFitDirection::FitDirection> chooseHelixDir(HelixSeed const& hseed) const;
-      std::unique_ptr<KKTRK> fitTrack(art::Event& event, HelixSeed const& hseed, const TrkFitDirection fdir, const PDGCode::type fitpart);
+      // fit one seed.  This only reads the module and the inputs, so seeds can be fit in parallel
+      std::unique_ptr<KKTRK> fitTrack(Tracker const& tracker, StrawResponse const& strawresponse, Calorimeter const& calo,
+          ComboHitCollection const& chcol, CCHandle const& cc_H,
+          HelixSeed const& hseed, const TrkFitDirection fdir, PDGCode::type fitpart) const;
       void print_track_info(const KalSeed& kkseed, const KKTRK& ktrk) const;
 
       // data payload
@@ -186,6 +194,12 @@ namespace mu2e {
       Config fconfig_; // final final configuration object
       std::unique_ptr<KKExtrap> extrap_; // extrapolation helper
       bool fixedfield_; // special case usage for seed fits, if no BField corrections are needed
+      bool gridfield_; // use a precomputed BField grid in the detector system
+      std::vector<double> gridlower_, gridupper_; // grid corners
+      double gridspacing_; // grid spacing
+      // parallel fitting
+      std::unique_ptr<tbb::task_arena> arena_;
+      int fitprint_; // print level inside fitTrack: fits run in parallel would interleave their output
       //Helix Mask params
       float minHelixP_ = -1.;
       int nSeen_ = 0;
@@ -210,7 +224,9 @@ namespace mu2e {
     kkmat_(settings().matSettings()),
     config_(Mu2eKinKal::makeConfig(settings().fitSettings())),
     exconfig_(Mu2eKinKal::makeConfig(settings().extSettings())),
-    fixedfield_(false)
+    fixedfield_(false),
+    gridfield_(settings().modSettings().gridBField().has_value()),
+    gridspacing_(0.0)
     {
       std::string fdir;
       if(settings().fitDirection(fdir))fdir_ = fdir;
@@ -219,6 +235,9 @@ namespace mu2e {
       produces<KKTRKCOL>();
       produces<KalSeedCollection>();
       produces<KalHelixAssns>();
+      if(settings().modSettings().nthreads() > 0)
+        arena_ = std::make_unique<tbb::task_arena>(static_cast<int>(settings().modSettings().nthreads()));
+      fitprint_ = arena_ ? 0 : print_;
       // build the initial seed covariance
       auto const& seederrors = settings().modSettings().seederrors();
       if(seederrors.size() != KinKal::NParams())
@@ -232,6 +251,11 @@ namespace mu2e {
         fixedfield_ = true;
         kkbf_ = std::move(std::make_unique<KKConstantBField>(VEC3(0.0,0.0,bz)));
       }
+      if(gridfield_){
+        gridlower_ = settings().modSettings().gridBField()->lower();
+        gridupper_ = settings().modSettings().gridBField()->upper();
+        gridspacing_ = settings().modSettings().gridBField()->spacing();
+      }
       // setup extrapolation
       if(settings().extrapSettings())extrap_ = make_unique<KKExtrap>(*settings().extrapSettings(),kkmat_);
 
@@ -262,7 +286,10 @@ namespace mu2e {
     if(!fixedfield_){
       GeomHandle<BFieldManager> bfmgr;
       GeomHandle<DetectorSystem> det;
-      kkbf_ = std::move(std::make_unique<KKBField>(*bfmgr,*det));
+      if(gridfield_)
+        kkbf_ = std::move(std::make_unique<KKGridBField>(gridlower_,gridupper_,gridspacing_,*bfmgr,*det));
+      else
+        kkbf_ = std::move(std::make_unique<KKBField>(*bfmgr,*det));
     }
     if(print_ > 0) kkbf_->print(std::cout);
 
@@ -293,21 +320,13 @@ namespace mu2e {
     return fitdirs;
   }
 
-  std::unique_ptr<KKTRK> LoopHelixFit::fitTrack(art::Event& event, HelixSeed const& hseed, const TrkFitDirection fdir, PDGCode::type fitpart) {
+  std::unique_ptr<KKTRK> LoopHelixFit::fitTrack(Tracker const& tracker, StrawResponse const& strawresponse, Calorimeter const& calo,
+      ComboHitCollection const& chcol, CCHandle const& cc_H,
+      HelixSeed const& hseed, const TrkFitDirection fdir, PDGCode::type fitpart) const {
     // check the input
     if(fdir.fitDirection() != TrkFitDirection::FitDirection::downstream && fdir.fitDirection() != TrkFitDirection::FitDirection::upstream)
       throw cet::exception("RECO") << "mu2e::LoopHelixFit: Unknown helix propagation direction " << fdir.name();
 
-    // Retrieve event information
-    // calo geom
-    GeomHandle<Calorimeter> calo_h;
-    // find current proditions
-    auto const& strawresponse = strawResponse_h_.getPtr(event.id());
-    auto const& tracker = alignedTracker_h_.getPtr(event.id()).get();
-    // find input hits
-    auto ch_H = event.getValidHandle<ComboHitCollection>(chcol_T_);
-    auto cc_H = event.getHandle<CaloClusterCollection>(cccol_T_);
-    auto const& chcol = *ch_H;
     // empty collections
     static MEASCOL nohits; // empty
     static EXINGCOL noexings; // empty
@@ -345,15 +364,15 @@ namespace mu2e {
     strawhits.reserve(strawHitIdxs.size());
     KKSTRAWXINGCOL strawxings;
     strawxings.reserve(strawHitIdxs.size());
-    if(!kkfit_.makeStrawHits(*tracker, *strawresponse, *kkbf_, kkmat_.strawMaterial(), pseedtraj, chcol, strawHitIdxs, strawhits, strawxings)) {
-      if(print_>0) printf("[LoopHelixFit::%s] Failed to create a track\n", __func__);
+    if(!kkfit_.makeStrawHits(tracker, strawresponse, *kkbf_, kkmat_.strawMaterial(), pseedtraj, chcol, strawHitIdxs, strawhits, strawxings)) {
+      if(fitprint_>0) printf("[LoopHelixFit::%s] Failed to create a track\n", __func__);
       return nullptr;
     }
     // optionally (and if present) add the CaloCluster as a constraint
     // verify the cluster looks physically reasonable before adding it TODO!  Or, let the KKCaloHit updater do it TODO
     KKCALOHITCOL calohits;
     if (kkfit_.useCalo() && hseed.caloCluster().isNonnull()) {
-      kkfit_.makeCaloHit(hseed.caloCluster(),*calo_h, pseedtraj, calohits);
+      kkfit_.makeCaloHit(hseed.caloCluster(),calo, pseedtraj, calohits);
     }
     // set the seed range given the hits and xings
     seedtraj.range() = kkfit_.range(strawhits,calohits,strawxings);
@@ -363,11 +382,11 @@ namespace mu2e {
       throw cet::exception("RECO")<<"mu2e::LoopHelixFit: Track fit was performed but no track is found\n";
 
     auto goodfit = goodFit(*ktrk,seedtraj);
-    if(print_>0) printf("[LoopHelixFit::%s] Before extending the fit: goodFit = %o, fitcon = %.4f, nHits = %2lu, %lu calo-hits\n",
+    if(fitprint_>0) printf("[LoopHelixFit::%s] Before extending the fit: goodFit = %o, fitcon = %.4f, nHits = %2lu, %lu calo-hits\n",
         __func__, goodfit, ktrk->fitStatus().chisq_.probability(), ktrk->strawHits().size(), ktrk->caloHits().size());
     // if we have an extension schedule, extend.
     if(goodfit && exconfig_.schedule().size() > 0) {
-      kkfit_.extendTrack(exconfig_,*kkbf_, *tracker,*strawresponse, kkmat_.strawMaterial(), chcol, *calo_h, cc_H, *ktrk );
+      kkfit_.extendTrack(exconfig_,*kkbf_, tracker,strawresponse, kkmat_.strawMaterial(), chcol, calo, cc_H, *ktrk );
       goodfit = goodFit(*ktrk,seedtraj);
       // if finalizing, apply that now.
       if(goodfit && fconfig_.schedule().size() > 0){
@@ -375,7 +394,7 @@ namespace mu2e {
         goodfit = goodFit(*ktrk,seedtraj);
       }
     }
-    if(print_>0) printf("[LoopHelixFit::%s] After extending the fit : goodFit = %o, fitcon = %.4f, nHits = %2lu, %lu calo-hits\n",
+    if(fitprint_>0) printf("[LoopHelixFit::%s] After extending the fit : goodFit = %o, fitcon = %.4f, nHits = %2lu, %lu calo-hits\n",
         __func__, goodfit, ktrk->fitStatus().chisq_.probability(), ktrk->strawHits().size(), ktrk->caloHits().size());
     if((!goodfit) && (! saveall_)) ktrk.reset();
     return ktrk;
@@ -385,12 +404,27 @@ namespace mu2e {
     // calo geom
     GeomHandle<Calorimeter> calo_h;
     GeomHandle<mu2e::Tracker> nominalTracker_h;
+    // find current proditions
+    auto const& strawresponse = strawResponse_h_.getPtr(event.id());
+    auto const& tracker = alignedTracker_h_.getPtr(event.id()).get();
+    // find input hits
+    auto ch_H = event.getValidHandle<ComboHitCollection>(chcol_T_);
+    auto cc_H = event.getHandle<CaloClusterCollection>(cccol_T_);
+    auto const& chcol = *ch_H;
     // create output
     unique_ptr<KKTRKCOL> ktrkcol(new KKTRKCOL );
     unique_ptr<KalSeedCollection> kkseedcol(new KalSeedCollection );
     unique_ptr<KalHelixAssns> kkseedassns(new KalHelixAssns());
     auto KalSeedCollectionPID = event.getProductID<KalSeedCollection>();
     auto KalSeedCollectionGetter = event.productGetter(KalSeedCollectionPID);
+    // the fits to perform: one for each seed and direction hypothesis, in the order the results are saved
+    struct SeedFit {
+      HPtr hptr;
+      TrkFitDirection::FitDirection dir;
+      bool undefined_dir;
+      std::unique_ptr<KKTRK> ktrk;
+    };
+    std::vector<SeedFit> fits;
     // find the helix seed collections
     unsigned nseed(0);
     for (auto const& hseedtag : hseedCols_) {
@@ -411,36 +445,50 @@ namespace mu2e {
         const unsigned dirs_size = helix_dirs.size();
         const bool undefined_dir = dirs_size > 1; //fitting multiple hypotheses to determine the best fit
         if(undefined_dir) ++nAmbiguous_;
-        // fit each track hypothesis
-        for(auto helix_dir : helix_dirs) {
-          auto ktrk = fitTrack(event, hseed,  TrkFitDirection(helix_dir), fpart_);
-          if(!ktrk) continue; //ensure that the track exists
-          // extrapolate as required
-          if(extrap_)extrap_->extrapolate(*ktrk);
-          if(print_>1) ktrk->printFit(std::cout,print_-1);
-          // save the fit result
-            auto hptr = HPtr(hseedcol_h,iseed);
-            TrkFitFlag fitflag(hptr->status());
-            fitflag.merge(fitflag_);
-            if(undefined_dir) fitflag.merge(TrkFitFlag::AmbFitDir);
-            // sample the fit as requested
-            kkfit_.sampleFit(*ktrk);
-            // convert to seed output format
-            auto kkseed = kkfit_.createSeed(*ktrk,fitflag,*calo_h,*nominalTracker_h);
-            if(print_>0) print_track_info(kkseed, *ktrk);
-            kkseedcol->push_back(kkseed);
-            // fill assns with the helix seed
-            auto kseedptr = art::Ptr<KalSeed>(KalSeedCollectionPID,kkseedcol->size()-1,KalSeedCollectionGetter);
-            kkseedassns->addSingle(kseedptr,hptr);
-            // save (unpersistable) KKTrk in the event
-            ktrkcol->push_back(ktrk.release());
-            //increment the counts
-            if(helix_dir == TrkFitDirection::FitDirection::downstream) ++nDownstream_;
-            if(helix_dir == TrkFitDirection::FitDirection::upstream  ) ++nUpstream_;
-        } //end track fit result loop
+        for(auto helix_dir : helix_dirs) fits.push_back(SeedFit{HPtr(hseedcol_h,iseed),helix_dir,undefined_dir,nullptr});
       } //end helix seed loop
     } //end helix colllection loop
 
+    // fit each track hypothesis.  The fits are independent, so they can run in parallel
+    auto fitseed = [&](SeedFit& fit) {
+      fit.ktrk = fitTrack(*tracker, *strawresponse, *calo_h, chcol, cc_H, *fit.hptr, TrkFitDirection(fit.dir), fpart_);
+    };
+    if(arena_ && fits.size() > 1){
+      arena_->execute([&]{
+          tbb::parallel_for(size_t(0),fits.size(),[&](size_t ifit){ fitseed(fits[ifit]); });
+          });
+    } else {
+      for(auto& fit : fits) fitseed(fit);
+    }
+
+    // save the results in seed order.  Extrapolation uses the cached intersections of KKExtrap, so it stays serial
+    for(auto& fit : fits) {
+      auto& ktrk = fit.ktrk;
+      if(!ktrk) continue; //ensure that the track exists
+      // extrapolate as required
+      if(extrap_)extrap_->extrapolate(*ktrk);
+      if(print_>1) ktrk->printFit(std::cout,print_-1);
+      // save the fit result
+      auto const& hptr = fit.hptr;
+      TrkFitFlag fitflag(hptr->status());
+      fitflag.merge(fitflag_);
+      if(fit.undefined_dir) fitflag.merge(TrkFitFlag::AmbFitDir);
+      // sample the fit as requested
+      kkfit_.sampleFit(*ktrk);
+      // convert to seed output format
+      auto kkseed = kkfit_.createSeed(*ktrk,fitflag,*calo_h,*nominalTracker_h);
+      if(print_>0) print_track_info(kkseed, *ktrk);
+      kkseedcol->push_back(kkseed);
+      // fill assns with the helix seed
+      auto kseedptr = art::Ptr<KalSeed>(KalSeedCollectionPID,kkseedcol->size()-1,KalSeedCollectionGetter);
+      kkseedassns->addSingle(kseedptr,hptr);
+      // save (unpersistable) KKTrk in the event
+      ktrkcol->push_back(ktrk.release());
+      //increment the counts
+      if(fit.dir == TrkFitDirection::FitDirection::downstream) ++nDownstream_;
+      if(fit.dir == TrkFitDirection::FitDirection::upstream  ) ++nUpstream_;
+    } //end track fit result loop
+
     // put the output products into the event
     if(print_ > 0) std::cout << "Fitted " << ktrkcol->size() << " tracks from " << nseed << " Seeds" << std::endl;
     event.put(move(ktrkcol));
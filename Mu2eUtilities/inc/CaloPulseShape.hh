@@ -14,6 +14,7 @@
 //
 // 1) digitizedPulse(hitTime) returns a waveform with hitTime corresponding to low edge of first bin
 // 2) evaluate(deltaTime) return value of digitized bin at a given time difference with peak time value
+//    it is linear between nodes separated by timeStep(), and zero outside [minTimeDifference, maxTimeDifference)
 //
 //  NOTE: uncomment the pline creation if the discontinuities in the second order derivative arising from the
 //        linear piecewise approxmiation are problematic for the minimization
@@ -34,6 +35,9 @@ namespace mu2e {
           const std::vector<double>& digitizedPulse  (double hitTime)        const;
           double                     evaluate        (double timeDifference) const;
           double                     fromPeakToT0    (double timePeak)       const;
+          double                     minTimeDifference()                     const {return -deltaT_-nSteps_*digiStep_;}
+          double                     maxTimeDifference()                     const {return (int(pulseVec_.size())-1-nSteps_)*digiStep_-deltaT_;}
+          double                     timeStep        ()                      const {return digiStep_;}
           void                       diag            (bool fullDiag=false)   const;
 
        private:
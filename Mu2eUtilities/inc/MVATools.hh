@@ -8,8 +8,10 @@
 #include <xercesc/util/PlatformUtils.hpp>
 #include <xercesc/parsers/XercesDOMParser.hpp>
 #include <xercesc/dom/DOMDocument.hpp>
-#include <vector>
+#include <span>
 #include <string>
+#include <utility>
+#include <vector>
 
 
 namespace mu2e
@@ -30,12 +32,29 @@ namespace mu2e
        virtual ~MVATools();
        xercesc::DOMDocument* getXmlDoc();
        void     initMVA();
+       // The evaluation is const and keeps its scratch space on the stack of the caller,
+       // so one instance can be used concurrently from several threads once initMVA is done.
        float    evalMVA(const std::vector<float>&,  const MVAMask& vmask=0xffffffff) const;
        float    evalMVA(const std::vector<double>&, const MVAMask& vmask=0xffffffff) const;
+       float    evalMVA(std::span<const float>,     const MVAMask& vmask=0xffffffff) const;
+
+       // Batched evaluation: features holds scores.size() feature vectors of nvars values each,
+       // one after the other.  The results are bitwise identical to those of single evaluations.
+       void     evalMVA(std::span<const float> features, unsigned nvars, std::span<float> scores,
+                        const MVAMask& vmask=0xffffffff) const;
        void     showMVA() const;
 
        const std::vector<std::string>& titles() const { return title_;}
        const std::vector<std::string>& labels() const { return label_;}
+       // Normalization range of the ival-th input of the network, counting only the variables kept
+       // by the mask.  Only defined if the network normalizes its inputs.
+       bool     isNormalized() const { return isNorm_; }
+       std::pair<float,float> range(size_t ival) const;
+
+       // Largest number of neurons in a layer, including the bias neuron
+       static constexpr unsigned kMaxNeurons = 64;
+       // Number of candidates evaluated together by the batched evalMVA
+       static constexpr unsigned kBatch = 16;
 
 
     private:
@@ -46,10 +65,10 @@ namespace mu2e
        void   getNorm(xercesc::DOMDocument* xmlDoc);
        void   getWgts(xercesc::DOMDocument* xmlDoc);
        float  activation(float arg) const;
+       float  normalize(float arg, size_t ival) const;
+       float  output(float arg) const;
+       void   checkInputs(size_t nvars, const MVAMask& vmask) const;
 
-       mutable std::vector<float> x_;
-       mutable std::vector<float> y_;
-       mutable std::vector<float> fv_;
        std::vector<float>         wgts_;
        std::vector<unsigned>      links_;
        unsigned                   maxNeurons_;
@@ -38,9 +38,6 @@ namespace mu2e
 {
 
   MVATools::MVATools(const Config& config) :
-    x_(),
-    y_(),
-    fv_(),
     wgts_(),
     maxNeurons_(0),
     activeType_(aType::null),
@@ -59,9 +56,6 @@ namespace mu2e
   }
 
   MVATools::MVATools(fhicl::ParameterSet const& pset) :
-    x_(),
-    y_(),
-    fv_(),
     wgts_(),
     maxNeurons_(0),
     activeType_(aType::null),
@@ -80,9 +74,6 @@ namespace mu2e
   }
 
   MVATools::MVATools(const std::string& xmlfilename) :
-    x_(),
-    y_(),
-    fv_(),
     wgts_(),
     maxNeurons_(0),
     activeType_(aType::null),
@@ -376,8 +367,8 @@ namespace mu2e
       }
 
       maxNeurons_ = *std::max_element(links_.begin(),links_.end());
-      x_ = std::vector<float>(maxNeurons_,0.0f);
-      y_ = std::vector<float>(maxNeurons_,0.0f);
+      if (maxNeurons_ > kMaxNeurons)
+        throw cet::exception("RECO")<<"mu2e::MVATools: " << maxNeurons_ << " neurons in a layer, at most " << kMaxNeurons << " are supported" << std::endl;
 
       XMLString::release(&ATT_INDEX);
       XMLString::release(&ATT_NSYNAPSES);
@@ -432,12 +423,24 @@ namespace mu2e
 
   float MVATools::evalMVA(const std::vector<double >& v, const MVAMask& mask) const
   {
-     for (size_t i=0;i<v.size();++i)  fv_[i] = static_cast<float>(v[i]);
-     return evalMVA(fv_,mask);
+     float fv[sizeof(MVAMask)*8];
+     if (v.size() > std::size(fv))
+       throw cet::exception("RECO")<<"mu2e::MVATools: " << v.size() << " input variables, the mask covers at most " << std::size(fv) << std::endl;
+     for (size_t i=0;i<v.size();++i)  fv[i] = static_cast<float>(v[i]);
+     return evalMVA(std::span<const float>(fv,v.size()),mask);
   }
 
   float MVATools::evalMVA(const std::vector<float>& v, const MVAMask& mask) const
   {
+     return evalMVA(std::span<const float>(v),mask);
+  }
+
+  float MVATools::evalMVA(std::span<const float> v, const MVAMask& mask) const
+  {
+      checkInputs(v.size(),mask);
+      float xbuf[kMaxNeurons], ybuf[kMaxNeurons];
+      float* x = xbuf;
+      float* y = ybuf;
 
       // Normalize the input data and add the bias node, skip masked values
       size_t ival(0);
@@ -445,15 +448,11 @@ namespace mu2e
       {
          if ( mask & (1<<ivar) )
          {
-            x_[ival]= isNorm_ ? (v[ivar]-voffset_[ival])*vscale_[ival] - 1.0 : v[ivar];
+            x[ival]= normalize(v[ivar],ival);
             ++ival;
          }
       }
-      x_[ival] = 1.0;
-
-      if (ival != links_[0]-1)
-        throw cet::exception("RECO")<<"mu2e::MVATools: mismatch input dimension (ival = " << ival << ") and network architecture (links_[0]-1 = " << links_[0]-1 << ")" << std::endl;
-
+      x[ival] = 1.0;
 
       //perform feed forward calculation up to the last hidden layer
       unsigned idxWeight(0);
@@ -462,24 +461,123 @@ namespace mu2e
           //the number of synpases is given by the number of neurons in the next layer -1 (do not count bias neuron!)
           for (unsigned j=0;j<links_[k+1]-1;++j)
           {
-             y_[j]=0.0f;
-             for (unsigned i=0;i<links_[k];++i) y_[j] += wgts_[i+idxWeight]*x_[i];
-             y_[j] = activation(y_[j]);
+             float yj(0.0f);
+             for (unsigned i=0;i<links_[k];++i) yj += wgts_[i+idxWeight]*x[i];
+             y[j] = activation(yj);
              idxWeight += links_[k];
           }
-          x_.swap(y_);
-          x_[links_[k+1]-1] = 1.0f; //add bias neuron
+          std::swap(x,y);
+          x[links_[k+1]-1] = 1.0f; //add bias neuron
       }
 
       //calculate output neuron value
       float yf(0.0);
-      for (unsigned i=0;i<links_.back();++i) yf += wgts_[i+idxWeight]*x_[i];
+      for (unsigned i=0;i<links_.back();++i) yf += wgts_[i+idxWeight]*x[i];
+
+      return output(yf);
+  }
+
+  // The network is applied to blocks of kBatch candidates as a sequence of matrix products:
+  // the activations of a layer are stored neuron by neuron, with the kBatch candidates
+  // contiguous, so that the innermost loop runs over candidates and vectorizes.
+  // The sums over the inputs of a neuron are done in the same order as in the single
+  // candidate evaluation, which makes the results identical.
+  void MVATools::evalMVA(std::span<const float> features, unsigned nvars, std::span<float> scores, const MVAMask& mask) const
+  {
+      if (features.size() != scores.size()*nvars)
+        throw cet::exception("RECO")<<"mu2e::MVATools: " << features.size() << " input values do not make "
+                                    << scores.size() << " feature vectors of " << nvars << " variables" << std::endl;
+      checkInputs(nvars,mask);
+      const unsigned ninput = links_[0]-1;
+
+      alignas(64) float xbuf[kMaxNeurons*kBatch];
+      alignas(64) float ybuf[kMaxNeurons*kBatch];
+
+      for (size_t first=0; first < scores.size(); first += kBatch)
+      {
+          const size_t nb = std::min(size_t(kBatch), scores.size()-first);
+          float* x = xbuf;
+          float* y = ybuf;
+
+          // Normalize the input data and add the bias node, skip masked values.
+          // Unused slots of the last block are set to zero and their scores are not kept.
+          for (size_t b=0; b < nb; ++b)
+          {
+             const float* v = features.data() + (first+b)*nvars;
+             size_t ival(0);
+             for (size_t ivar=0; ivar < nvars; ivar++)
+             {
+                if ( mask & (1<<ivar) )
+                {
+                   x[ival*kBatch+b] = normalize(v[ivar],ival);
+                   ++ival;
+                }
+             }
+          }
+          for (size_t b=nb; b < kBatch; ++b)
+             for (unsigned i=0; i < ninput; ++i) x[i*kBatch+b] = 0.0f;
+          for (size_t b=0; b < kBatch; ++b) x[ninput*kBatch+b] = 1.0f;
+
+          //perform feed forward calculation up to the last hidden layer
+          unsigned idxWeight(0);
+          for (unsigned k=0;k<links_.size()-1;++k)
+          {
+              for (unsigned j=0;j<links_[k+1]-1;++j)
+              {
+                 float yj[kBatch] = {};
+                 for (unsigned i=0;i<links_[k];++i)
+                 {
+                    const float w = wgts_[i+idxWeight];
+                    const float* xi = x + i*kBatch;
+                    for (unsigned b=0; b < kBatch; ++b) yj[b] += w*xi[b];
+                 }
+                 for (unsigned b=0; b < kBatch; ++b) y[j*kBatch+b] = activation(yj[b]);
+                 idxWeight += links_[k];
+              }
+              std::swap(x,y);
+              for (unsigned b=0; b < kBatch; ++b) x[(links_[k+1]-1)*kBatch+b] = 1.0f; //add bias neuron
+          }
+
+          //calculate output neuron values
+          float yf[kBatch] = {};
+          for (unsigned i=0;i<links_.back();++i)
+          {
+             const float w = wgts_[i+idxWeight];
+             const float* xi = x + i*kBatch;
+             for (unsigned b=0; b < kBatch; ++b) yf[b] += w*xi[b];
+          }
+          for (size_t b=0; b < nb; ++b) scores[first+b] = output(yf[b]);
+      }
+  }
+
+  void MVATools::checkInputs(size_t nvars, const MVAMask& mask) const
+  {
+      if (links_.empty())
+        throw cet::exception("RECO")<<"mu2e::MVATools: evalMVA called before initMVA" << std::endl;
+      size_t ival(0);
+      for (size_t ivar=0; ivar < nvars; ivar++) if ( mask & (1<<ivar) ) ++ival;
+      if (ival != links_[0]-1)
+        throw cet::exception("RECO")<<"mu2e::MVATools: mismatch input dimension (ival = " << ival << ") and network architecture (links_[0]-1 = " << links_[0]-1 << ")" << std::endl;
+  }
 
-      if (oldMVA_) return yf;
-      return  1.0/(1.0+expf(-yf));
+  std::pair<float,float> MVATools::range(size_t ival) const
+  {
+      if (!isNorm_ || ival >= voffset_.size())
+        throw cet::exception("RECO")<<"mu2e::MVATools: no normalization range for input " << ival
+                                    << " (" << voffset_.size() << " normalized inputs)" << std::endl;
+      return {voffset_[ival], 2.0f/vscale_[ival]+voffset_[ival]};
   }
 
+  float MVATools::normalize(float arg, size_t ival) const
+  {
+      return isNorm_ ? (arg-voffset_[ival])*vscale_[ival] - 1.0 : arg;
+  }
 
+  float MVATools::output(float arg) const
+  {
+      if (oldMVA_) return arg;
+      return  1.0/(1.0+expf(-arg));
+  }
 
 
   float MVATools::activation(float arg) const
@@ -0,0 +1,104 @@
+///////////////////////////////////////////////////////////////////////////////
+// Measure the rate of ProditionsCache::update calls when many threads ask
+// for the same entities at once.  At the first event, for each number of
+// threads, every thread calls update nCalls times on each of the caches.
+///////////////////////////////////////////////////////////////////////////////
+
+// C++ includes
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Framework includes
+#include "art/Framework/Core/EDAnalyzer.h"
+#include "art/Framework/Principal/Event.h"
+#include "fhiclcpp/types/Atom.h"
+#include "fhiclcpp/types/Sequence.h"
+
+#include "Offline/ProditionsService/inc/ProditionsService.hh"
+#include "cetlib_except/exception.h"
+
+namespace mu2e {
+
+class ProditionsBench : public art::EDAnalyzer {
+ public:
+  struct Config {
+    using Name = fhicl::Name;
+    using Comment = fhicl::Comment;
+
+    fhicl::Sequence<std::string> caches{
+        Name("caches"), Comment("names of the caches to call"),
+        std::vector<std::string>{"StrawResponse", "TrackerStatus"}};
+    fhicl::Sequence<int> threads{
+        Name("threads"), Comment("numbers of threads to test"),
+        std::vector<int>{1, 2, 4, 8, 16, 32, 64}};
+    fhicl::Atom<int> nCalls{Name("nCalls"),
+                            Comment("calls to each cache per thread"), 100000};
+  };
+
+  // this line is required by art to allow the command line help print
+  typedef art::EDAnalyzer::Table<Config> Parameters;
+
+  explicit ProditionsBench(const Parameters& conf) :
+      art::EDAnalyzer(conf), _conf(conf()), _done(false) {}
+
+  void analyze(const art::Event& event) override;
+
+ private:
+  Config _conf;
+  bool _done;
+};
+
+//-----------------------------------------------------------------------------
+void ProditionsBench::analyze(const art::Event& event) {
+  if (_done) return;
+  _done = true;
+
+  art::ServiceHandle<ProditionsService> sg;
+  std::vector<ProditionsCache::ptr> caches;
+  for (auto const& name : _conf.caches()) {
+    auto cptr = sg->getCache(name);
+    if (!cptr) {
+      throw cet::exception("PRODITIONSBENCH_NO_CACHE")
+          << "ProditionsBench could not get cache " << name
+          << " from ProditionsService\n";
+    }
+    cptr->update(event.id());  // make the entity before timing
+    caches.push_back(cptr);
+  }
+
+  art::EventID const eid = event.id();
+  int const nCalls = _conf.nCalls();
+
+  std::cout << "ProditionsBench " << caches.size() << " caches, " << nCalls
+            << " calls per cache and thread\n";
+  std::cout << std::setw(10) << "threads" << std::setw(14) << "time (s)"
+            << std::setw(18) << "calls/s"
+            << "\n";
+  for (int nthread : _conf.threads()) {
+    auto work = [&]() {
+      for (int i = 0; i < nCalls; i++) {
+        for (auto const& cptr : caches) cptr->update(eid);
+      }
+    };
+
+    auto stime = std::chrono::steady_clock::now();
+    std::vector<std::thread> pool;
+    for (int i = 0; i < nthread; i++) pool.emplace_back(work);
+    for (auto& t : pool) t.join();
+    double dt = std::chrono::duration<double>(std::chrono::steady_clock::now() -
+                                              stime)
+                    .count();
+
+    double calls = double(nthread) * nCalls * caches.size();
+    std::cout << std::setw(10) << nthread << std::setw(14) << dt
+              << std::setw(18) << calls / dt << "\n";
+  }
+}
+
+}  // namespace mu2e
+
+DEFINE_ART_MODULE(mu2e::ProditionsBench)
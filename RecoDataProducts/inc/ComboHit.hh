@@ -23,6 +23,8 @@
 #include "canvas/Persistency/Common/ProductPtr.h"
 // C++ includes
 #include <array>
+#include <span>
+#include <utility>
 #include <vector>
 namespace mu2e {
 
@@ -189,10 +191,24 @@ namespace mu2e {
       auto sort() const { return _sort; }
       unsigned nStrawHits() const;
       float eDepAvg() const;
+      // Optional index of the hits by unique panel, for collections where the hits of each panel are
+      // contiguous and the panels in increasing order.  Set it once the collection is filled: it returns
+      // false, and sets no index, if the hits are not in panel order.  Changing the number of hits
+      // afterwards invalidates the index.  The index is transient: collections read from a file have none.
+      bool setPanelIndex();
+      void clearPanelIndex() { _panelOffsets.clear(); }
+      bool hasPanelIndex() const { return _panelOffsets.size() == StrawId::_nupanels+1u && _panelOffsets.back() == size(); }
+      // range [first,second) of the indices of the hits in a unique panel, or in a plane; requires the index
+      std::pair<size_t,size_t> panelRange(uint16_t upanel) const { return {_panelOffsets[upanel],_panelOffsets[upanel+1]}; }
+      std::pair<size_t,size_t> planeRange(uint16_t plane) const {
+        return {_panelOffsets[plane*StrawId::_npanels],_panelOffsets[(plane+1)*StrawId::_npanels]}; }
+      std::span<const ComboHit> panelHits(uint16_t upanel) const { auto range = panelRange(upanel); return {data()+range.first,data()+range.second}; }
+      std::span<const ComboHit> planeHits(uint16_t plane) const { auto range = planeRange(plane); return {data()+range.first,data()+range.second}; }
     private:
       // reference back to the input ComboHit collection this one references
       CHCPTR _parent; // pointer to the parent object
       Sort _sort; // record how this collection was sorted
+      std::vector<uint32_t> _panelOffsets; // index of the first hit of each unique panel, and the size; empty if no index
   };
   inline std::ostream& operator<<( std::ostream& ost,
       ComboHit const& hit){
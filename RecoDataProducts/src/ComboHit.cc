@@ -274,6 +274,23 @@ namespace mu2e {
     return eDepSum/(nStrawHits + 1e-10);
   }
 
+  bool ComboHitCollection::setPanelIndex() {
+    _panelOffsets.assign(StrawId::_nupanels+1,0);
+    uint16_t last(0);
+    for (size_t ich=0; ich < size(); ++ich) {
+      uint16_t upanel = (*this)[ich].strawId().uniquePanel();
+      if (upanel < last || upanel >= StrawId::_nupanels) {
+        _panelOffsets.clear();
+        return false;
+      }
+      // this hit opens all the panels after the last one seen
+      for (uint16_t ipanel=last+1; ipanel <= upanel; ++ipanel) _panelOffsets[ipanel] = ich;
+      last = upanel;
+    }
+    for (uint16_t ipanel=last+1; ipanel <= StrawId::_nupanels; ++ipanel) _panelOffsets[ipanel] = size();
+    return true;
+  }
+
 
 
 
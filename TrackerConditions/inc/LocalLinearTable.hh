@@ -0,0 +1,36 @@
+#ifndef TrackerConditions_LocalLinearTable_hh
+#define TrackerConditions_LocalLinearTable_hh
+//
+// Piecewise linear function on uniform bins, stored as an offset and slope per bin so that
+// an evaluation is a single table read.  Values outside the bin range are extrapolated from
+// the first or last bin.  The tables are built once per calibration (IoV) by StrawResponse.
+//
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+namespace mu2e {
+  class LocalLinearTable {
+    public:
+      LocalLinearTable() = default;
+      // linear interpolation between values given at the nodes xmin + i*xbin
+      static LocalLinearTable interpolation(double xmin, double xbin, std::vector<double> const& yvals);
+      // linear fit of the values given at the bin centers xmin + (i+0.5)*xbin, over the bins within halfrange of each bin
+      static LocalLinearTable localFit(double xmin, double xbin, std::vector<double> const& yvals, int halfrange);
+
+      size_t nBins() const { return _offset.size(); }
+      size_t bin(double x) const { return std::min(_maxbin,size_t(std::max(0,int(std::floor((x-_xmin)/_xbin))))); }
+      double value(double x) const { auto ibin = bin(x); return _offset[ibin] + _slope[ibin]*x; }
+      void value(double x, double& val, double& slope) const {
+        auto ibin = bin(x);
+        slope = _slope[ibin];
+        val = _offset[ibin] + slope*x;
+      }
+    private:
+      LocalLinearTable(double xmin, double xbin, size_t nbins);
+      double _xmin = 0, _xbin = 1;
+      size_t _maxbin = 0;
+      std::vector<double> _offset, _slope;
+  };
+}
+#endif
@@ -10,9 +10,11 @@
 
 #include <iostream>
 #include <vector>
+#include <span>
 #include <string>
 #include "Offline/DataProducts/inc/TrkTypes.hh"
 #include "Offline/Mu2eInterfaces/inc/ProditionsEntity.hh"
+#include <algorithm>
 #include <cmath>
 
 
@@ -40,7 +42,7 @@ namespace mu2e {
         _phiBins(phiBins),   _deltaPhi(M_PI_2/static_cast<double>(_phiBins-1)),
         _deltaD(deltaD), _distances_dbins(distances_dbins),
         _instantSpeed_dbins(instantSpeed_dbins), _times_dbins(times_dbins),
-        _deltaT(deltaT), _distances_tbins(distances_tbins), _times_tbins(times_tbins) {}
+        _deltaT(deltaT), _distances_tbins(distances_tbins), _times_tbins(times_tbins) { fillTables(); }
 
       virtual ~StrawDrift() = default;
 
@@ -48,8 +50,12 @@ namespace mu2e {
       double GetAverageSpeed(double dist) const; // avg nom. drift speed (phi = 0)
       double GetInstantSpeedFromT(double time) const; // (at phi = 0)
       double GetInstantSpeedFromD(double dist) const; // (at phi = 0)
-      double D2T(double dist, double phi) const;
-      double T2D(double time, double phi, bool nonnegative=true) const;
+      double D2T(double dist, double phi) const { return d2tTable().interpolate(dist,phi); }
+      double T2D(double time, double phi, bool nonnegative=true) const {
+        return (time < 0 && nonnegative) ? 0.0 : t2dTable().interpolate(time,phi); }
+      // batched conversions of all the hits of a track in one pass; the spans must have the same size
+      void D2T(std::span<const double> dist, std::span<const double> phi, std::span<double> times) const;
+      void T2D(std::span<const double> time, std::span<const double> phi, std::span<double> dists, bool nonnegative=true) const;
 
       void print(std::ostream& os) const;
 
@@ -57,11 +63,34 @@ namespace mu2e {
 
       // fold into first quadrant assuming the function
       // has x-z and y-z plane symmetry
-      double foldPhi(double phi) const;
-      void phiRange(double phi, size_t prange[2]) const;
-      size_t timeIndex(double time) const;
-      size_t distIndex(double dist) const;
-      void indexRange(double time, double phi, size_t irange[2]) const;
+      // (integer truncation rather than floor, which does not vectorize)
+      static float foldPhi(float phi) {
+        phi = std::fabs(phi);
+        phi -= float(M_PI)*float(int(phi*float(M_1_PI)));
+        return std::min(phi,float(M_PI)-phi);
+      }
+      // bilinear interpolation of a [x][phi] table on uniform bins starting at x=0, phi=0.
+      // x is extrapolated linearly from the first or last bin.  Branch-free so that the batched loops vectorize
+      struct Table {
+        const float* values;
+        int nphi, maxbin;
+        float invdx, invdphi;
+        float interpolate(double x, double phi) const {
+          float pbin = std::min(foldPhi(float(phi))*invdphi,float(nphi-1));
+          int ip = std::min(int(pbin),nphi-2);
+          float xbin = float(x)*invdx;
+          int ix = std::clamp(int(xbin),0,maxbin); // same as floor after the clamp
+          float fx = xbin - ix;
+          float fp = pbin - ip;
+          int k = ix*nphi + ip;
+          float lowPhi = values[k] + fx*(values[k+nphi]-values[k]);
+          float highPhi = values[k+1] + fx*(values[k+nphi+1]-values[k+1]);
+          return lowPhi + fp*(highPhi-lowPhi);
+        }
+      };
+      Table d2tTable() const { return Table{_d2tTable.data(),int(_phiBins),_maxDBin,_invDeltaD,_invDeltaPhi}; }
+      Table t2dTable() const { return Table{_t2dTable.data(),int(_phiBins),_maxTBin,_invDeltaT,_invDeltaPhi}; }
+      void fillTables();
 
       double _cc;
       size_t _phiBins;
@@ -76,6 +105,10 @@ namespace mu2e {
       std::vector<double> _distances_tbins; // 2d array vs time and phi
       std::vector<double> _times_tbins; // times between points for T2D
 
+      // compact copies of the 2d arrays used by D2T and T2D
+      std::vector<float> _d2tTable, _t2dTable; // [distance][phi] and [time][phi]
+      float _invDeltaPhi = 0, _invDeltaD = 0, _invDeltaT = 0;
+      int _maxDBin = 0, _maxTBin = 0; // last bin usable for interpolation
 
   };
 }
@@ -10,6 +10,7 @@
 #include <iostream>
 #include <vector>
 #include <array>
+#include <algorithm>
 
 // Mu2e includes
 #include "Offline/DataProducts/inc/StrawId.hh"
@@ -108,6 +109,19 @@ namespace mu2e {
       // linear response to a charge pulse.  This does NOT include saturation effects,
       // since those are cumulative and cannot be computed for individual charges
       double linearResponse(Straw const& straw, Path ipath, double time, double charge, double distance, bool forsaturation=false) const; // mvolts per pCoulomb
+      // the time-independent factors of the linear response to one cluster, so that
+      // the response can be sampled at many times without recomputing them
+      struct ClusterResponse {
+        double charge;
+        double distFrac; // interpolation weight of the lower wire distance point
+        double reflectionTime;
+        double reflectionScale;
+        size_t distIndex; // lower wire distance point
+      };
+      ClusterResponse clusterResponse(Straw const& straw, double charge, double distance) const;
+      double linearResponse(StrawId sid, Path ipath, double time, ClusterResponse const& cresp, bool forsaturation=false) const;
+      // relative time after which the linear response to this cluster is constant
+      double linearResponseEndTime(ClusterResponse const& cresp) const { return (_responseBins/2.)/_sampleRate + std::max(0.0,cresp.reflectionTime); }
       double adcImpulseResponse(StrawId sid, double time, double charge) const;
       // Given a (linear) total voltage, compute the saturated voltage
       double saturatedResponse(double lineearresponse) const;
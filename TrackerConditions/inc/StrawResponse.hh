@@ -15,6 +15,7 @@
 #include "Offline/TrackerConditions/inc/StrawElectronics.hh"
 #include "Offline/TrackerConditions/inc/StrawPhysics.hh"
 #include "Offline/TrackerConditions/inc/DriftInfo.hh"
+#include "Offline/TrackerConditions/inc/LocalLinearTable.hh"
 #include "Offline/GeneralUtilities/inc/SplineInterpolation.hh"
 #include "Offline/Mu2eInterfaces/inc/ProditionsEntity.hh"
 
@@ -83,7 +84,7 @@ namespace mu2e {
         _dVdI(dVdI), _vsat(vsat), _ADCped(ADCped),
         _pmpEnergyScaleAvg(pmpEnergyScaleAvg),
         _strawHalfvp(strawHalfvp),
-        _driftIgnorePhi(driftIgnorePhi){ }
+        _driftIgnorePhi(driftIgnorePhi){ fillTables(); }
 
       virtual ~StrawResponse() {}
 
@@ -151,12 +152,8 @@ namespace mu2e {
       auto const& strawDrift() const { return *_strawDrift; }
     private:
 
-      // helper functions
-      static double PieceLine(std::vector<double> const& xvals,
-          std::vector<double> const& yvals, double xval);
-      static double PieceLineDrift(std::vector<double> const& bins, std::vector<double> const& yvals, double xval);
-      static void interpolateCalib(std::vector<double> const& bins,std::vector<double> const& yvals, double xval,
-          int halfrange, double& value, double& slope);
+      // precompute the calibration tables from the parametric data
+      void fillTables();
 
       StrawDrift::cptr_t _strawDrift;
       StrawElectronics::cptr_t _strawElectronics;
@@ -214,6 +211,10 @@ namespace mu2e {
       std::array<double, StrawId::_nustraws> _strawHalfvp;
 
       bool _driftIgnorePhi;
+      // calibration functions tabulated from the above
+      LocalLinearTable _halfvpscaleTable, _centresTable, _resslopeTable; // vs edep
+      LocalLinearTable _llDriftTimeOffTable, _llDriftTimeRMSTable; // vs drift distance
+      LocalLinearTable _driftOffTable, _signedDriftRMSTable, _unsignedDriftRMSTable; // local linear fits vs drift distance
       static double rstraw_; // straw radius, = maximum drift distance
   };
 }
@@ -0,0 +1,46 @@
+#include "Offline/TrackerConditions/inc/LocalLinearTable.hh"
+#include "cetlib_except/exception.h"
+#include "gsl/gsl_fit.h"
+
+namespace mu2e {
+  LocalLinearTable::LocalLinearTable(double xmin, double xbin, size_t nbins) :
+    _xmin(xmin), _xbin(xbin), _maxbin(nbins-1), _offset(nbins), _slope(nbins) {
+    if(nbins == 0 || !(xbin > 0))throw cet::exception("RECO")<<"mu2e::LocalLinearTable: invalid binning " << nbins << " bins of width " << xbin << std::endl;
+  }
+
+  LocalLinearTable LocalLinearTable::interpolation(double xmin, double xbin, std::vector<double> const& yvals) {
+    if(yvals.size() < 2)throw cet::exception("RECO")<<"mu2e::LocalLinearTable: interpolation needs 2 values" << std::endl;
+    LocalLinearTable table(xmin,xbin,yvals.size()-1);
+    for(size_t ibin=0;ibin < table.nBins(); ++ibin){
+      double x0 = xmin + xbin*ibin;
+      table._slope[ibin] = (yvals[ibin+1]-yvals[ibin])/xbin;
+      table._offset[ibin] = yvals[ibin] - x0*table._slope[ibin];
+    }
+    return table;
+  }
+
+  LocalLinearTable LocalLinearTable::localFit(double xmin, double xbin, std::vector<double> const& yvals, int halfrange) {
+    LocalLinearTable table(xmin,xbin,yvals.size());
+    int maxindex = yvals.size()-1;
+    std::vector<double> xfit, yfit;
+    for(int ibin=0;ibin <= maxindex; ++ibin){
+      // find a range of N bins about the central bin
+      int imin = std::max(0,ibin-halfrange);
+      int imax = std::min(maxindex,ibin+halfrange);
+      xfit.clear();
+      yfit.clear();
+      for(int jbin=imin;jbin<=imax;++jbin){
+        xfit.push_back(xmin+xbin*(jbin+0.5));
+        yfit.push_back(yvals[jbin]);
+      }
+      double c0,c1;
+      double cov00, cov01, cov11, sumsq;
+      auto fitok = gsl_fit_linear(xfit.data(),1,yfit.data(),1,xfit.size(),
+          &c0, &c1, &cov00, &cov01, &cov11, &sumsq);
+      if(fitok != 0)throw cet::exception("RECO")<<"mu2e::LocalLinearTable: calibration interpolation failure" << std::endl;
+      table._offset[ibin] = c0;
+      table._slope[ibin] = c1;
+    }
+    return table;
+  }
+}
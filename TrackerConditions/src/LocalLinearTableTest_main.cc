@@ -0,0 +1,260 @@
+//
+// Regression test and timing of the StrawResponse calibration tables (LocalLinearTable)
+// against the per-call interpolation and GSL fits they replace.  Random calibration vectors
+// are generated with the binning of the default StrawResponse configuration, and both methods
+// are evaluated at random points inside and outside the bin range.  The same comparison is then
+// made through a StrawResponse built with random calibrations (driftInfo, halfPropV, wpRes,
+// driftTimeOffset and driftTimeError), which also checks how its constructor binds the
+// calibrations to the tables.  The program returns 1 if the largest difference exceeds the tolerance.
+//
+#include "Offline/TrackerConditions/inc/LocalLinearTable.hh"
+#include "Offline/TrackerConditions/inc/StrawResponse.hh"
+#include "Offline/TrackerConditions/inc/StrawDrift.hh"
+#include "gsl/gsl_fit.h"
+#include <algorithm>
+#include <array>
+#include <memory>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <vector>
+#include <getopt.h>
+
+using mu2e::LocalLinearTable;
+
+namespace {
+  // the StrawResponse functions before the tables
+  double PieceLine(std::vector<double> const& xvals, std::vector<double> const& yvals, double xval){
+    int imax = int(xvals.size()-2);
+    double xbin = (xvals.back()-xvals.front())/(xvals.size()-1);
+    int ibin = std::min(imax,std::max(0,int(floor((xval-xvals.front())/xbin))));
+    double slope = (yvals[ibin+1]-yvals[ibin])/xbin;
+    return yvals[ibin] + (xval-xvals[ibin])*slope;
+  }
+
+  double PieceLineDrift(std::vector<double> const& bins,std::vector<double> const& yvals, double xval){
+    int imax = yvals.size()-2;
+    double xbin = (bins[1]-bins[0])/yvals.size();
+    int ibin = std::min(imax,std::max(0,int(floor((xval-bins[0])/xbin))));
+    double slope = (yvals[ibin+1]-yvals[ibin])/xbin;
+    return yvals[ibin] + (xval-(bins[0]+xbin*ibin))*slope;
+  }
+
+  void interpolateCalib(std::vector<double> const& bins,std::vector<double> const& yvals, double xval,
+      int halfrange, double& value, double& slope) {
+    int maxindex = yvals.size()-1;
+    double xbin = (bins[1]-bins[0])/yvals.size();
+    int ibin = std::min(maxindex,std::max(0,int(floor((xval-bins[0])/xbin))));
+    int imin = std::max(0,ibin-halfrange);
+    int imax = std::min(maxindex,ibin+halfrange);
+    std::vector<double> xfit, yfit;
+    for(int jbin=imin;jbin<=imax;++jbin){
+      xfit.push_back(bins[0]+xbin*(jbin+0.5));
+      yfit.push_back(yvals[jbin]);
+    }
+    double c0,c1,cov00,cov01,cov11,sumsq;
+    gsl_fit_linear(xfit.data(),1,yfit.data(),1,xfit.size(),&c0,&c1,&cov00,&cov01,&cov11,&sumsq);
+    value = c0 + c1*xval;
+    slope = c1;
+  }
+
+  double relDiff(double a, double b) { return std::abs(a-b)/std::max(1.0,std::abs(b)); }
+
+  // the StrawResponse::wpRes before the tables
+  double wpRes(std::vector<double> const& edep, std::vector<double> const& centres, std::vector<double> const& resslope,
+      double central, bool rmsLongErrors, double kedep, double wlen) {
+    double tdres = PieceLine(edep,centres,kedep);
+    if (rmsLongErrors){
+      if( wlen > central){
+        double wslope = PieceLine(edep,resslope,kedep);
+        tdres += (wlen-central)*wslope;
+      }
+    }else{
+      double wslope = PieceLine(edep,resslope,kedep);
+      tdres += wslope*wlen*wlen;
+    }
+    tdres = std::max(30.0,tdres);
+    return tdres;
+  }
+
+  // drift model with a constant speed, the drift time growing with phi as in StrawDriftMaker
+  mu2e::StrawDrift::cptr_t makeDrift(double speed) {
+    size_t phiBins(10);
+    double deltaD(0.05), deltaT(1.0), rstraw(2.5);
+    double deltaPhi = M_PI_2/(phiBins-1);
+    std::vector<double> distances_dbins, instantSpeed_dbins, times_dbins;
+    for(double d=0; d < rstraw; d += deltaD){
+      distances_dbins.push_back(d);
+      instantSpeed_dbins.push_back(speed);
+      for(size_t p=0;p<phiBins;++p) times_dbins.push_back(d/speed*(1.0+0.1*std::sin(deltaPhi*p)));
+    }
+    std::vector<double> times_tbins, distances_tbins;
+    for(double t=0; t < 1.2*rstraw/speed; t += deltaT){
+      times_tbins.push_back(t);
+      for(size_t p=0;p<phiBins;++p) distances_tbins.push_back(t*speed/(1.0+0.1*std::sin(deltaPhi*p)));
+    }
+    return std::make_shared<mu2e::StrawDrift>(1.0,phiBins,deltaD,distances_dbins,instantSpeed_dbins,times_dbins,
+        deltaT,distances_tbins,times_tbins);
+  }
+}
+
+static struct option long_options[] = {
+  {"ntests",     required_argument, 0, 'n' },
+  {"npoints",     required_argument, 0, 'p' },
+  {"tolerance",     required_argument, 0, 't' },
+  {NULL, 0,0,0}
+};
+
+void print_usage() {
+  printf("Usage: LocalLinearTableTest --ntests (calibrations) --npoints (evaluations per calibration) --tolerance (relative) \n");
+}
+
+int main(int argc, char** argv) {
+  unsigned ntests(100), npoints(10000);
+  double tolerance(1e-9);
+  int opt;
+  int long_index =0;
+  while ((opt = getopt_long_only(argc, argv,"",
+          long_options, &long_index )) != -1) {
+    switch (opt) {
+      case 'n' : ntests = atoi(optarg);
+                 break;
+      case 'p' : npoints = atoi(optarg);
+                 break;
+      case 't' : tolerance = atof(optarg);
+                 break;
+      default: print_usage();
+               exit(EXIT_FAILURE);
+    }
+  }
+
+  std::mt19937 rng(12345);
+  std::uniform_real_distribution<double> flat(0.0,1.0);
+  // smooth random calibration curve with noise
+  auto makeCurve = [&](size_t n) {
+    std::vector<double> yvals(n);
+    double a = 10*flat(rng), b = flat(rng), c = 0.5*flat(rng);
+    for(size_t i=0;i<n;++i) yvals[i] = a*std::exp(-b*i/double(n)) + c*(flat(rng)-0.5);
+    return yvals;
+  };
+
+  double maxdiff(0), tref(0), ttab(0), sum(0);
+  unsigned long ncalls(0);
+  for(unsigned itest=0;itest<ntests;++itest){
+    // binnings of the default configuration: 59 edep nodes, 26 drift time bins in [0,2.5], drift offset bins in [-0.25,3.25]
+    std::vector<double> edep;
+    for(int i=0;i<59;++i) edep.push_back(0.1*i);
+    auto halfvp = makeCurve(edep.size());
+    std::vector<double> llbins{0,2.5};
+    auto llrms = makeCurve(26);
+    std::vector<double> offbins{-0.25,3.25};
+    auto offset = makeCurve(14+itest%20);
+
+    auto halfvpTable = LocalLinearTable::interpolation(edep.front(),(edep.back()-edep.front())/(edep.size()-1),halfvp);
+    auto llrmsTable = LocalLinearTable::interpolation(llbins[0],(llbins[1]-llbins[0])/llrms.size(),llrms);
+    auto offsetTable = LocalLinearTable::localFit(offbins[0],(offbins[1]-offbins[0])/offset.size(),offset,2);
+
+    std::vector<double> xe(npoints), xd(npoints);
+    for(unsigned ip=0;ip<npoints;++ip){
+      xe[ip] = -0.5 + 7.0*flat(rng);
+      xd[ip] = -0.5 + 4.0*flat(rng);
+    }
+
+    auto t0 = std::chrono::steady_clock::now();
+    std::vector<double> ref(4*npoints);
+    for(unsigned ip=0;ip<npoints;++ip){
+      ref[4*ip] = PieceLine(edep,halfvp,xe[ip]);
+      ref[4*ip+1] = PieceLineDrift(llbins,llrms,xd[ip]);
+      interpolateCalib(offbins,offset,xd[ip],2,ref[4*ip+2],ref[4*ip+3]);
+    }
+    auto t1 = std::chrono::steady_clock::now();
+    std::vector<double> tab(4*npoints);
+    for(unsigned ip=0;ip<npoints;++ip){
+      tab[4*ip] = halfvpTable.value(xe[ip]);
+      tab[4*ip+1] = llrmsTable.value(xd[ip]);
+      offsetTable.value(xd[ip],tab[4*ip+2],tab[4*ip+3]);
+    }
+    auto t2 = std::chrono::steady_clock::now();
+    tref += std::chrono::duration<double,std::nano>(t1-t0).count();
+    ttab += std::chrono::duration<double,std::nano>(t2-t1).count();
+    ncalls += npoints;
+
+    for(size_t i=0;i<ref.size();++i){
+      maxdiff = std::max(maxdiff,relDiff(tab[i],ref[i]));
+      sum += tab[i];
+    }
+  }
+
+  printf("LocalLinearTableTest: %lu evaluations, max relative difference %g (tolerance %g)\n",ncalls,maxdiff,tolerance);
+  printf("  per point (2 interpolations + 1 local fit): reference %.1f ns, tables %.1f ns (checksum %g)\n",tref/ncalls,ttab/ncalls,sum);
+
+  // the same through StrawResponse, with the binnings of the default configuration
+  auto drift = makeDrift(0.0625);
+  double srmaxdiff(0);
+  unsigned long nsrcalls(0);
+  for(unsigned itest=0;itest<ntests;++itest){
+    std::vector<double> edep;
+    for(int i=0;i<59;++i) edep.push_back(0.1*i);
+    auto halfvpscale = makeCurve(edep.size());
+    auto centres = makeCurve(edep.size());
+    auto resslope = makeCurve(edep.size());
+    double central = 65.0*flat(rng);
+    bool rmsLongErrors = itest%2 == 0;
+    std::vector<double> llOffBins{0,2.5}, llRMSBins{0,2.5}, driftOffBins{-0.25,3.25}, driftRMSBins{0,2.5};
+    auto llOffset = makeCurve(26);
+    auto llRMS = makeCurve(26);
+    auto driftOffset = makeCurve(140);
+    for(auto& off : driftOffset) off = 0.02*off - 0.1;
+    auto signedRMS = makeCurve(25+itest%10);
+    auto unsignedRMS = makeCurve(25+itest%10);
+    double dRdTScale = 0.9+0.2*flat(rng);
+    std::array<double,mu2e::StrawId::_nustraws> halfvp, pmpEnergyScale;
+    for(auto& hvp : halfvp) hvp = 150.0+20.0*flat(rng);
+    pmpEnergyScale.fill(1.0);
+    std::array<double,mu2e::StrawElectronics::npaths> analognoise{}, dVdI{};
+
+    mu2e::StrawResponse sresp(drift,nullptr,nullptr,
+        edep.size(),0.1,edep,halfvpscale,central,centres,resslope,true,rmsLongErrors,
+        1,1.0,1,1.0,std::vector<double>(1,0.0),std::vector<double>(1,0.0),
+        llOffBins,llOffset,llRMSBins,llRMS,driftOffBins,driftOffset,
+        driftRMSBins,signedRMS,unsignedRMS,dRdTScale,
+        1.0,1.0,1.0,true,0.0625,pmpEnergyScale,0.0,1.0,analognoise,dVdI,1.0,0.0,1.0,halfvp,false);
+
+    for(unsigned ip=0;ip<npoints;++ip){
+      mu2e::StrawId sid(uint16_t(ip%mu2e::StrawId::_nustraws));
+      // driftInfo, as before the tables
+      double dtime = -5.0 + 50.0*flat(rng);
+      double phi = M_PI*(2.0*flat(rng)-1.0);
+      auto dinfo = sresp.driftInfo(sid,dtime,phi);
+      double cdrift = drift->T2D(dtime,phi,false);
+      double dcorr, dcorrslope, serr, uerr, errslope;
+      interpolateCalib(driftOffBins,driftOffset,cdrift,2,dcorr,dcorrslope);
+      double rdrift = cdrift - dcorr;
+      double vdrift = drift->GetInstantSpeedFromD(cdrift)*(1.0 - dcorrslope)*dRdTScale;
+      interpolateCalib(driftRMSBins,signedRMS,rdrift,2,serr,errslope);
+      interpolateCalib(driftRMSBins,unsignedRMS,rdrift,2,uerr,errslope);
+      srmaxdiff = std::max({srmaxdiff,relDiff(dinfo.cDrift_,cdrift),relDiff(dinfo.rDrift_,rdrift),
+          relDiff(dinfo.driftVelocity_,vdrift),relDiff(dinfo.signedDriftError_,serr),relDiff(dinfo.unsignedDriftError_,uerr)});
+      // edep calibrations
+      double kedep = -0.5 + 7.0*flat(rng);
+      double wlen = 600.0*flat(rng);
+      srmaxdiff = std::max(srmaxdiff,relDiff(sresp.halfPropV(sid,kedep),PieceLine(edep,halfvpscale,kedep)*halfvp[sid.uniqueStraw()]));
+      srmaxdiff = std::max(srmaxdiff,relDiff(sresp.wpRes(kedep,wlen),wpRes(edep,centres,resslope,central,rmsLongErrors,kedep,wlen)));
+      // drift time calibrations
+      double ddist = -0.5 + 4.0*flat(rng);
+      srmaxdiff = std::max(srmaxdiff,relDiff(sresp.driftTimeOffset(sid,ddist,phi),PieceLineDrift(llOffBins,llOffset,ddist)));
+      double cdist = std::max(0.0,std::min(2.5,ddist));
+      srmaxdiff = std::max(srmaxdiff,relDiff(sresp.driftTimeError(sid,ddist,phi),PieceLineDrift(llRMSBins,llRMS,cdist)));
+      ++nsrcalls;
+    }
+  }
+  printf("  StrawResponse: %lu points, max relative difference %g\n",nsrcalls,srmaxdiff);
+  maxdiff = std::max(maxdiff,srmaxdiff);
+
+  if(maxdiff > tolerance){
+    printf("LocalLinearTableTest FAILED\n");
+    return 1;
+  }
+  return 0;
+}
@@ -45,67 +45,43 @@ namespace mu2e {
     return _instantSpeed_dbins[lowerIndex] + (time - _times_dbins[lowerIndex*_phiBins])/(_times_dbins[(lowerIndex+1)*_phiBins]-_times_dbins[lowerIndex*_phiBins]) * (_instantSpeed_dbins[lowerIndex+1]-_instantSpeed_dbins[lowerIndex]);
   }
 
-  //D2T for sims
-  double StrawDrift::D2T(double distance, double phi) const {
-    //For the purposes of lorentz corrections, the phi values can be contracted to between 0-90
-    float fphi = foldPhi(phi);
-    size_t phirange[2];
-    phiRange(fphi,phirange);
-    auto dindex = distIndex(distance);
-    double lowerTime = _times_dbins[dindex*_phiBins+phirange[0]] + (distance - _distances_dbins[dindex])/(_deltaD) * (_times_dbins[(dindex+1)*_phiBins+phirange[0]] - _times_dbins[dindex*_phiBins+phirange[0]]);
-    double upperTime = _times_dbins[dindex*_phiBins+phirange[1]] + (distance - _distances_dbins[dindex])/(_deltaD) * (_times_dbins[(dindex+1)*_phiBins+phirange[1]] - _times_dbins[dindex*_phiBins+phirange[1]]);
-    if (phi == 0) return lowerTime;
-    double lowerPhi = phirange[0] * _deltaPhi;
-    return lowerTime + (fphi - lowerPhi)/_deltaPhi * (upperTime - lowerTime);
-  }
-
-  //T2D for reco
-  double StrawDrift::T2D(double time, double phi, bool nonnegative) const {
-    if (time < 0 && nonnegative) return 0;
-    double fphi = foldPhi(phi);
-    size_t phirange[2];
-    phiRange(fphi,phirange);
-    size_t tindex = timeIndex(time);
-    size_t lowrange[2];
-    lowrange[0] = tindex*_phiBins+phirange[0];
-    lowrange[1] = (tindex+1)*_phiBins+phirange[0];
-    double lowerDist = _distances_tbins[lowrange[0]] + (time - _times_tbins[tindex])/(_deltaT) * (_distances_tbins[lowrange[1]] - _distances_tbins[lowrange[0]]);
-    if (fphi == 0) return lowerDist;
-    size_t uprange[2];
-    uprange[0] = tindex*_phiBins+phirange[1];
-    uprange[1] = (tindex+1)*_phiBins+phirange[1];
-    double upperDist = _distances_tbins[uprange[0]] + (time - _times_tbins[tindex])/(_deltaT) * (_distances_tbins[uprange[1]] - _distances_tbins[uprange[0]]);
-    double lowerPhi = phirange[0] * _deltaPhi;
-    return lowerDist + (fphi - lowerPhi)/_deltaPhi * (upperDist - lowerDist);
+  void StrawDrift::fillTables() {
+    if(_phiBins < 2 || _distances_dbins.size() < 2 || _times_tbins.size() < 2
+        || _times_dbins.size() != _distances_dbins.size()*_phiBins || _distances_tbins.size() != _times_tbins.size()*_phiBins)
+      throw cet::exception("BADCONFIG") << "mu2e::StrawDrift: inconsistent drift model binning" << endl;
+    // the distance and time nodes are uniform from 0: the tables only need the 2d arrays
+    _d2tTable.assign(_times_dbins.begin(),_times_dbins.end());
+    _t2dTable.assign(_distances_tbins.begin(),_distances_tbins.end());
+    _invDeltaPhi = 1.0/_deltaPhi;
+    _invDeltaD = 1.0/_deltaD;
+    _invDeltaT = 1.0/_deltaT;
+    _maxDBin = int(_distances_dbins.size())-2;
+    _maxTBin = int(_times_tbins.size())-2;
   }
 
-  double StrawDrift::foldPhi(double phi) const {
-    // fold phi onto [0,pi/2]
-    phi = fabs(fmod(phi,M_PI));
-    if (phi > M_PI_2) phi = M_PI-phi;
-    return phi;
-  }
-
-  void StrawDrift::phiRange(double phi, size_t prange[2]) const {
-    //for interpolation, define a high and a low index
-    prange[0] = static_cast<size_t>(std::max(0,static_cast<int>(floor(phi/_deltaPhi))));
-    prange[1] = static_cast<size_t>(std::min(static_cast<int>(_phiBins)-1,static_cast<int>(ceil(phi/_deltaPhi))));
-  }
-
-  size_t StrawDrift::timeIndex(double time) const {
-    return static_cast<size_t>( std::min(static_cast<int>(_times_tbins.size())-2,std::max(0,static_cast<int>(floor(time/_deltaT)))));
-  }
-
-  size_t StrawDrift::distIndex(double dist) const {
-    return static_cast<size_t>(std::min(static_cast<int>(_distances_dbins.size())-2,std::max(0,static_cast<int>(floor(dist/_deltaD)))));
+  //D2T for sims
+  void StrawDrift::D2T(std::span<const double> dist, std::span<const double> phi, std::span<double> times) const {
+    size_t n = times.size();
+    if(dist.size() != n || phi.size() != n)
+      throw cet::exception("RECO") << "mu2e::StrawDrift: D2T span size mismatch" << endl;
+    const auto table = d2tTable();
+    for(size_t i=0; i < n; ++i)
+      times[i] = table.interpolate(dist[i],phi[i]);
   }
 
-  void StrawDrift::indexRange(double time, double phi, size_t irange[2]) const {
-    size_t phirange[2];
-    phiRange(phi,phirange);
-    size_t tindex = timeIndex(time);
-    irange[0] = tindex*_phiBins+phirange[0];
-    irange[1] = (tindex+1)*_phiBins+phirange[0];
+  //T2D for reco
+  void StrawDrift::T2D(std::span<const double> time, std::span<const double> phi, std::span<double> dists, bool nonnegative) const {
+    size_t n = dists.size();
+    if(time.size() != n || phi.size() != n)
+      throw cet::exception("RECO") << "mu2e::StrawDrift: T2D span size mismatch" << endl;
+    const auto table = t2dTable();
+    for(size_t i=0; i < n; ++i)
+      dists[i] = table.interpolate(time[i],phi[i]);
+    // separate pass, so that the interpolation loop has no conditional
+    if(nonnegative){
+      for(size_t i=0; i < n; ++i)
+        if(time[i] < 0) dists[i] = 0;
+    }
   }
 
   void StrawDrift::print(std::ostream& os) const {
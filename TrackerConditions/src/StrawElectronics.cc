@@ -68,43 +68,58 @@ namespace mu2e {
   }
 
   double StrawElectronics::linearResponse(Straw const& straw, Path ipath, double time, double charge, double distance, bool forsaturation) const {
+    return linearResponse(straw.id(),ipath,time,clusterResponse(straw,charge,distance),forsaturation);
+  }
+
+  StrawElectronics::ClusterResponse StrawElectronics::clusterResponse(Straw const& straw, double charge, double distance) const {
+    ClusterResponse cresp;
+    cresp.charge = charge;
+    double straw_length = 2*straw.halfLength();
+    cresp.reflectionTime = _reflectionTimeShift + (2*straw_length-2*distance)/_reflectionVelocity;
+    cresp.reflectionScale = _reflectionFrac * exp(-(2*straw_length-2*distance)/_reflectionALength);
+
+    int  distIndex = 0;
+    for (size_t i=1;i<_wPoints.size()-1;i++){
+      if (distance < _wPoints[i]._distance)
+        break;
+      distIndex = i;
+    }
+    cresp.distIndex = distIndex;
+    cresp.distFrac = 1 - (distance - _wPoints[distIndex]._distance)/(_wPoints[distIndex+1]._distance - _wPoints[distIndex]._distance);
+    return cresp;
+  }
+
+  double StrawElectronics::linearResponse(StrawId sid, Path ipath, double time, ClusterResponse const& cresp, bool forsaturation) const {
     int index = time*_sampleRate + _responseBins/2.;
     if ( index >= _responseBins)
       index = _responseBins-1;
     if (index < 0)
       index = 0;
 
-    double straw_length = 2*straw.halfLength();
-    double reflection_time = _reflectionTimeShift + (2*straw_length-2*distance)/_reflectionVelocity;
-    int index_refl = (time - reflection_time)*_sampleRate + _responseBins/2.;
+    int index_refl = (time - cresp.reflectionTime)*_sampleRate + _responseBins/2.;
     if (index_refl >= _responseBins)
       index_refl = _responseBins-1;
     if (index_refl < 0)
       index_refl = 0;
 
-    double reflection_scale = _reflectionFrac * exp(-(2*straw_length-2*distance)/_reflectionALength);
-
-    int  distIndex = 0;
-    for (size_t i=1;i<_wPoints.size()-1;i++){
-      if (distance < _wPoints[i]._distance)
-        break;
-      distIndex = i;
-    }
-    double distFrac = 1 - (distance - _wPoints[distIndex]._distance)/(_wPoints[distIndex+1]._distance - _wPoints[distIndex]._distance);
+    double reflection_scale = cresp.reflectionScale;
+    double distFrac = cresp.distFrac;
+    auto const& wp0 = _wPoints[cresp.distIndex];
+    auto const& wp1 = _wPoints[cresp.distIndex + 1];
     double p0, p1;
     if (ipath == thresh){
       if (forsaturation){
-        p0 = _wPoints[distIndex]._preampToAdc1Response[index]      + _wPoints[distIndex]._preampToAdc1Response[index_refl]*reflection_scale;
-        p1 = _wPoints[distIndex + 1]._preampToAdc1Response[index]  + _wPoints[distIndex + 1]._preampToAdc1Response[index_refl]*reflection_scale;
+        p0 = wp0._preampToAdc1Response[index]  + wp0._preampToAdc1Response[index_refl]*reflection_scale;
+        p1 = wp1._preampToAdc1Response[index]  + wp1._preampToAdc1Response[index_refl]*reflection_scale;
       }else{
-        p0 = _wPoints[distIndex]._preampResponse[index]      + _wPoints[distIndex]._preampResponse[index_refl]*reflection_scale;
-        p1 = _wPoints[distIndex + 1]._preampResponse[index]  + _wPoints[distIndex + 1]._preampResponse[index_refl]*reflection_scale;
+        p0 = wp0._preampResponse[index]  + wp0._preampResponse[index_refl]*reflection_scale;
+        p1 = wp1._preampResponse[index]  + wp1._preampResponse[index_refl]*reflection_scale;
       }
     }else{
-      p0 = _wPoints[distIndex]._adcResponse[index]      + _wPoints[distIndex]._adcResponse[index_refl]*reflection_scale;
-      p1 = _wPoints[distIndex + 1]._adcResponse[index]  + _wPoints[distIndex + 1]._adcResponse[index_refl]*reflection_scale;
+      p0 = wp0._adcResponse[index]  + wp0._adcResponse[index_refl]*reflection_scale;
+      p1 = wp1._adcResponse[index]  + wp1._adcResponse[index_refl]*reflection_scale;
     }
-    return charge * ( p0 * distFrac + p1 * (1 - distFrac)) * _dVdI[ipath][straw.id().uniqueStraw()];
+    return cresp.charge * ( p0 * distFrac + p1 * (1 - distFrac)) * _dVdI[ipath][sid.uniqueStraw()];
   }
 
   double StrawElectronics::adcImpulseResponse(StrawId sid, double time, double charge) const {
@@ -3,58 +3,35 @@
 #include "TMath.h"
 #include <cmath>
 #include <algorithm>
-#include "gsl/gsl_fit.h"
 
 using namespace std;
 
 namespace mu2e {
   double StrawResponse::rstraw_(2.5);  // should come from geometry, TODO
 
-  // simple line interpolation, this should be a utility function, TODO
-  // This only works if the bins are uniform, should be rewritten TODO
-  double StrawResponse::PieceLine(std::vector<double> const& xvals, std::vector<double> const& yvals, double xval){
-    int imax = int(xvals.size()-2);
-    double xbin = (xvals.back()-xvals.front())/(xvals.size()-1);
-    int ibin = min(imax,max(0,int(floor((xval-xvals.front())/xbin))));
-    double yval = yvals[ibin];
-    auto jbin = ibin+1;
-    double slope = (yvals[jbin]-yvals[ibin])/xbin;
-    yval += (xval-xvals[ibin])*slope;
-    return yval;
-  }
-
-  double StrawResponse::PieceLineDrift(std::vector<double> const& bins,std::vector<double> const& yvals, double xval){
-      int imax = yvals.size()-2;
-    double xbin = (bins[1]-bins[0])/yvals.size();
-    int ibin = min(imax,max(0,int(floor((xval-bins[0])/xbin))));
-    double yval = yvals[ibin];
-    auto jbin = ibin+1;
-    double slope = (yvals[jbin]-yvals[ibin])/xbin;
-    yval += (xval-(bins[0]+xbin*ibin))*slope;
-    return yval;
-  }
-
-  void StrawResponse::interpolateCalib(std::vector<double> const& bins,std::vector<double> const& yvals, double xval,
-      int halfrange, double& value, double& slope) {
-    int maxindex = yvals.size()-1;
-    double xbin = (bins[1]-bins[0])/yvals.size();
-    int ibin = min(maxindex,max(0,int(floor((xval-bins[0])/xbin))));
-// find a range of N bins about the central bin
-    int imin = std::max(0,ibin-halfrange);
-    int imax = std::min(maxindex,ibin+halfrange);
-    std::vector<double> xfit, yfit;
-    for(int jbin=imin;jbin<=imax;++jbin){
-      xfit.push_back(bins[0]+xbin*(jbin+0.5)); // y values are at bin center, x vaues are bin edges
-      yfit.push_back(yvals[jbin]);
-    }
-    double c0,c1;
-    double cov00, cov01, cov11, sumsq;
-    auto fitok = gsl_fit_linear(xfit.data(),1,yfit.data(),1,xfit.size(),
-        &c0, &c1, &cov00, &cov01, &cov11, &sumsq);
-// test fitok
-    if(fitok != 0)throw cet::exception("RECO")<<"mu2e::StrawResponse: calibration interpolation faiulre" << endl;
-    value = c0 + c1*xval;
-    slope = c1;
+  // The edep calibrations are given at uniform nodes, the drift calibrations as a range
+  // divided into as many bins as there are values.  The drift offset and errors are smoothed
+  // by a linear fit over the neighboring bins, which only depends on the bin: these fits are done
+  // here once, instead of for each hit
+  void StrawResponse::fillTables() {
+    if(_edep.size() < 2 || _driftOffBins.size() != 2 || _driftRMSBins.size() != 2 ||
+        _llDriftTimeOffBins.size() != 2 || _llDriftTimeRMSBins.size() != 2)
+      throw cet::exception("BADCONFIG")<<"mu2e::StrawResponse: calibration binning incorrect" << endl;
+    int halfrange(2); // should be a parameter TODO
+    double ebin = (_edep.back()-_edep.front())/(_edep.size()-1);
+    _halfvpscaleTable = LocalLinearTable::interpolation(_edep.front(),ebin,_halfvpscale);
+    _centresTable = LocalLinearTable::interpolation(_edep.front(),ebin,_centres);
+    _resslopeTable = LocalLinearTable::interpolation(_edep.front(),ebin,_resslope);
+    _llDriftTimeOffTable = LocalLinearTable::interpolation(_llDriftTimeOffBins[0],
+        (_llDriftTimeOffBins[1]-_llDriftTimeOffBins[0])/_llDriftTimeOffset.size(),_llDriftTimeOffset);
+    _llDriftTimeRMSTable = LocalLinearTable::interpolation(_llDriftTimeRMSBins[0],
+        (_llDriftTimeRMSBins[1]-_llDriftTimeRMSBins[0])/_llDriftTimeRMS.size(),_llDriftTimeRMS);
+    _driftOffTable = LocalLinearTable::localFit(_driftOffBins[0],
+        (_driftOffBins[1]-_driftOffBins[0])/_driftOffset.size(),_driftOffset,halfrange);
+    _signedDriftRMSTable = LocalLinearTable::localFit(_driftRMSBins[0],
+        (_driftRMSBins[1]-_driftRMSBins[0])/_signedDriftRMS.size(),_signedDriftRMS,halfrange);
+    _unsignedDriftRMSTable = LocalLinearTable::localFit(_driftRMSBins[0],
+        (_driftRMSBins[1]-_driftRMSBins[0])/_unsignedDriftRMS.size(),_unsignedDriftRMS,halfrange);
   }
 
   double ConstrainAngle(double phi) {
@@ -73,15 +50,14 @@ namespace mu2e {
     DriftInfo dinfo;
     dinfo.LorentzAngle_ = phi;
     dinfo.cDrift_ = _strawDrift->T2D(dtime,phi,false); // allow values outside the physical range at this point
-    int halfrange(2); // should be a parameter TODO
     double dcorr, dcorrslope;
-    interpolateCalib(_driftOffBins,_driftOffset, dinfo.cDrift_, halfrange, dcorr, dcorrslope);
+    _driftOffTable.value(dinfo.cDrift_, dcorr, dcorrslope);
     dinfo.rDrift_ = dinfo.cDrift_ -dcorr;
     // note 'Velocity' is really dR/dt (change in calibrated drift distance WRT measured time), not a true physical velocity
     dinfo.driftVelocity_ = _strawDrift->GetInstantSpeedFromD(dinfo.cDrift_)*(1.0 - dcorrslope)*_dRdTScale;
     double serrslope,uerrslope;
-    interpolateCalib(_driftRMSBins,_signedDriftRMS, dinfo.rDrift_, halfrange, dinfo.signedDriftError_, serrslope);
-    interpolateCalib(_driftRMSBins,_unsignedDriftRMS, dinfo.rDrift_, halfrange, dinfo.unsignedDriftError_ , uerrslope);
+    _signedDriftRMSTable.value(dinfo.rDrift_, dinfo.signedDriftError_, serrslope);
+    _unsignedDriftRMSTable.value(dinfo.rDrift_, dinfo.unsignedDriftError_ , uerrslope);
     return dinfo;
   }
 
@@ -96,12 +72,12 @@ namespace mu2e {
   }
 
   double StrawResponse::driftTimeOffset(StrawId strawId, double ddist, double phi) const {
-    return PieceLineDrift(_llDriftTimeOffBins,_llDriftTimeOffset, ddist);
+    return _llDriftTimeOffTable.value(ddist);
   }
 
   double StrawResponse::driftTimeError(StrawId strawId, double ddist, double phi) const {
     ddist = std::max(0.0,std::min(rstraw_,ddist));
-    return PieceLineDrift(_llDriftTimeRMSBins, _llDriftTimeRMS, ddist);
+    return _llDriftTimeRMSTable.value(ddist);
   }
 
   double StrawResponse::driftInstantSpeed(StrawId strawId, double ddist, double) const {
@@ -145,21 +121,21 @@ namespace mu2e {
 
   double StrawResponse::halfPropV(StrawId strawId, double kedep) const {
     double mean_prop_v = _strawHalfvp[strawId.uniqueStraw()];
-    return PieceLine(_edep,_halfvpscale,kedep)*mean_prop_v;
+    return _halfvpscaleTable.value(kedep)*mean_prop_v;
   }
 
   double StrawResponse::wpRes(double kedep,double wlen) const {
     // central resolution depends on edep
-    double tdres = PieceLine(_edep,_centres,kedep);
+    double tdres = _centresTable.value(kedep);
     if (_rmsLongErrors){
       if( wlen > _central){
         // outside the central region the resolution depends linearly on the distance
         // along the wire.  The slope of that also depends on edep
-        double wslope = PieceLine(_edep,_resslope,kedep);
+        double wslope = _resslopeTable.value(kedep);
         tdres += (wlen-_central)*wslope;
       }
     }else{
-      double wslope = PieceLine(_edep,_resslope,kedep);
+      double wslope = _resslopeTable.value(kedep);
       tdres += wslope*wlen*wlen;
     }
     // insure a minimum value
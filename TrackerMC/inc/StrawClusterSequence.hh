@@ -1,21 +1,22 @@
 #ifndef TrackerMC_StrawClusterSequence_hh
 #define TrackerMC_StrawClusterSequence_hh
 //
-// StrawClusterSequence is a time-ordered sequence of StrawClusters
+// StrawClusterSequence is a time-ordered sequence of StrawClusters.  The clusters are
+// stored contiguously, so that waveform sampling can search and scan them by time.
 //
 // Original author David Brown, LBNL
 //
 
 // C++ includes
 #include <iostream>
-#include <list>
+#include <vector>
 // Mu2e includes
 #include "Offline/TrackerMC/inc/StrawCluster.hh"
 #include "Offline/DataProducts/inc/StrawId.hh"
 
 namespace mu2e {
   namespace TrackerMC {
-    typedef std::list<StrawCluster> StrawClusterList;
+    typedef std::vector<StrawCluster> StrawClusterList;
     class StrawClusterSequence {
       public:
         // constructors
@@ -26,7 +27,7 @@ namespace mu2e {
         StrawClusterSequence& operator =(StrawClusterSequence const& other);
         // accessors: just hand over the list!
         StrawClusterList const& clustList() const { return _clist; }
-        // insert a new clust, in time order.
+        // insert a new clust, in time order.  This invalidates iterators to the existing clusts
         StrawClusterList::iterator insert(StrawCluster const& clust);
         StrawId const& strawId() const { return _strawId; }
         StrawEnd const& strawEnd() const { return _end; }
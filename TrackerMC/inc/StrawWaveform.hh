@@ -39,11 +39,13 @@ namespace mu2e {
     struct WFX;
     class StrawWaveform{
       public:
-        // construct from a clust sequence and response object.  Scale affects the voltage
-        StrawWaveform(Straw const& straw, StrawClusterSequence const& hseqq, XTalk const& xtalk);
+        // construct from a clust sequence and response object.  Scale affects the voltage.
+        // The electronics response factors of the clusts are computed here, so the waveform must be
+        // sampled with the same electronics
+        StrawWaveform(StrawElectronics const& strawele, Straw const& straw, StrawClusterSequence const& hseqq, XTalk const& xtalk);
         // disallow copy and assignment
         StrawWaveform() = delete; // don't allow default constructor, references can't be assigned empty
-        StrawWaveform(StrawWaveform const& other);
+        StrawWaveform(StrawWaveform const& other) = default;
         StrawWaveform & operator=(StrawWaveform const& other) = delete;
         // find the next point the waveform crosses threhold.  Waveform crossing
         // is both input (determines starting point) and output
@@ -64,7 +66,21 @@ namespace mu2e {
         StrawClusterSequence const& _cseq;
         XTalk _xtalk; // X-talk applied to all voltages
         Straw const& _straw;
+        // response factors of each clust, in the (time) order of the sequence
+        std::vector<double> _ctimes; // clust times
+        std::vector<StrawElectronics::ClusterResponse> _cresps;
+        std::vector<double> _maxresps; // maximum linear threshold response, including x-talk
+        std::vector<double> _maxtimes; // relative time of the maximum threshold response
+        // Past its end time the response of a clust is constant.  Those constants are stored, so that sampling
+        // only calls the electronics response for the clusts whose response is still changing.  They are
+        // summed in clust order like the other responses, which keeps the result of the direct summation
+        enum ResponseType {threshresp=0,adcresp,satresp,nresptypes};
+        std::array<std::vector<double>,nresptypes> _endresps;
+        double _tend; // latest end time of any clust response
         // helper functions
+        size_t clustIndex(StrawClusterList::const_iterator const& iclust) const { return iclust - _cseq.clustList().begin(); }
+        // sum of the linear responses of the clusts starting at ibegin
+        double linearResponse(StrawElectronics const& strawele,StrawElectronics::Path ipath,bool forsaturation,size_t ibegin,double time) const;
         void returnCrossing(StrawElectronics const& strawele, double threshold, WFX& wfx) const;
         bool roughCrossing(StrawElectronics const& strawele, double threshold, WFX& wfx) const;
         bool fineCrossing(StrawElectronics const& strawele, double threshold, double vmax, WFX& wfx) const;
@@ -0,0 +1,72 @@
+// Copy StrawGasStep collections with all times shifted by one random offset per event, uniform over the
+// microbunch period.  Digitizing the copy together with the original steps emulates the occupancy of a
+// higher beam intensity, for digitization throughput benchmarks.
+
+#include "art/Framework/Core/EDProducer.h"
+#include "art/Framework/Principal/Event.h"
+#include "art/Framework/Principal/Handle.h"
+#include "fhiclcpp/types/Sequence.h"
+#include "Offline/GlobalConstantsService/inc/GlobalConstantsHandle.hh"
+#include "Offline/GlobalConstantsService/inc/PhysicsParams.hh"
+#include "Offline/MCDataProducts/inc/StrawGasStep.hh"
+#include "Offline/SeedService/inc/SeedService.hh"
+#include "CLHEP/Random/RandFlat.h"
+
+#include <string>
+
+using namespace std;
+
+namespace mu2e{
+
+  class ShiftStrawGasSteps : public art::EDProducer {
+  public:
+    using Name=fhicl::Name;
+    using Comment=fhicl::Comment;
+
+    struct Config {
+      fhicl::Sequence<art::InputTag> stepstags { Name("StrawGasStepTags"), Comment("StrawGasStep collections to copy")};
+    };
+    using Parameters = art::EDProducer::Table<Config>;
+    explicit ShiftStrawGasSteps(const Parameters& config);
+    void beginRun(art::Run& run) override;
+    void produce(art::Event& e) override;
+
+  private:
+    art::RandomNumberGenerator::base_engine_t& _engine;
+    CLHEP::RandFlat _randflat;
+
+    std::vector<art::InputTag> _stepsTags;
+    double _mbtime;
+  };
+
+  ShiftStrawGasSteps::ShiftStrawGasSteps(const Parameters& config) :
+    art::EDProducer{config},
+    _engine(createEngine( art::ServiceHandle<SeedService>()->getSeed())),
+    _randflat( _engine ),
+    _stepsTags(config().stepstags()),
+    _mbtime(0.0)
+    {
+      for(auto const& tag : _stepsTags)
+        consumes<StrawGasStepCollection>(tag);
+      produces<StrawGasStepCollection>();
+    }
+
+  void ShiftStrawGasSteps::beginRun(art::Run& run) {
+    _mbtime = GlobalConstantsHandle<PhysicsParams>()->getNominalDRPeriod();
+  }
+
+  void ShiftStrawGasSteps::produce(art::Event& event)  {
+    unique_ptr<StrawGasStepCollection> outsteps(new StrawGasStepCollection);
+    double tshift = _randflat.fire(_mbtime);
+    for(auto const& tag : _stepsTags){
+      auto const& stepcol = *event.getValidHandle<StrawGasStepCollection>(tag);
+      for (auto const& step: stepcol){
+        outsteps->push_back(step);
+        outsteps->back().time() += tshift;
+      }
+    }
+    event.put(move(outsteps));
+  }
+}
+
+DEFINE_ART_MODULE(mu2e::ShiftStrawGasSteps)
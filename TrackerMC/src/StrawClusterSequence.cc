@@ -6,6 +6,7 @@
 // mu2e includes
 #include "Offline/TrackerMC/inc/StrawClusterSequence.hh"
 #include "cetlib_except/exception.h"
+#include <algorithm>
 
 using namespace std;
 
@@ -53,15 +54,14 @@ namespace mu2e {
         return retval;
       }
       if(_clist.empty()){
-        _clist.push_front(clust);
+        _clist.push_back(clust);
         _strawId = clust.strawId();
         _end = clust.strawEnd();
         retval = _clist.begin();
       } else {
-        // loop over the contents and insert in the correct place
-        StrawClusterList::iterator ibefore = _clist.begin();
-        while(ibefore != _clist.end() && ibefore->time() < clust.time())
-          ++ibefore;
+        // insert before the first clust that is not earlier
+        auto ibefore = std::lower_bound(_clist.begin(),_clist.end(),clust.time(),
+            [](StrawCluster const& other, double time){ return other.time() < time; });
         retval = _clist.insert(ibefore,clust);
       }
       return retval;
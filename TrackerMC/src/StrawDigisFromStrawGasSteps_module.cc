@@ -50,6 +50,7 @@
 #include "CLHEP/Random/RandFlat.h"
 #include "CLHEP/Random/RandExponential.h"
 #include "CLHEP/Random/RandPoisson.h"
+#include "CLHEP/Random/MixMaxRng.h"
 #include "CLHEP/Vector/LorentzVector.h"
 // root
 #include "TMath.h"
@@ -58,6 +59,9 @@
 #include "TGraph.h"
 #include "TMarker.h"
 #include "TTree.h"
+// TBB
+#include "tbb/parallel_for.h"
+#include "tbb/task_arena.h"
 // C++
 #include <map>
 #include <algorithm>
@@ -121,6 +125,7 @@ namespace mu2e {
           fhicl::Atom<art::InputTag> mixedDigisTag { Name("MixedDigisTag"), Comment("Source of digis to overlay event onto"), ""};
           fhicl::Atom<bool> mixDigiMCs { Name("MixDigiMCs"), Comment("Propagate mixed StrawDigiMCs through module"), false};
           fhicl::Atom<bool> allowEmptySteps { Name("AllowEmptyStrawGasSteps"), Comment("Allow digitization to proceed even without any valid straw gas step collections"), false};
+          fhicl::Atom<unsigned> nthreads { Name("DigitizationThreads"), Comment("Number of threads digitizing straws in parallel, each straw with its own random stream.  0 digitizes serially with the module engine"), 0};
         };
 
         typedef art::Ptr<StrawGasStep> SGSPtr;
@@ -181,6 +186,9 @@ namespace mu2e {
         const art::InputTag _mixedDigisTag;
         const bool _mixDigiMCs;
         const bool _allowEmptySteps;
+        // parallel digitization
+        const unsigned _nthreads;
+        std::unique_ptr<tbb::task_arena> _arena;
         // Proditions
         ProditionsHandle<StrawPhysics> _strawphys_h;
         ProditionsHandle<StrawElectronics> _strawele_h;
@@ -251,18 +259,30 @@ namespace mu2e {
         double microbunchTime(StrawElectronics const& strawele, double globaltime) const;
         void addGhosts(StrawElectronics const& strawele, StrawCluster const& clust,StrawClusterSequence& shs);
         void addNoise(StrawClusterMap& hmap);
-        void findThresholdCrossings(StrawElectronics const& strawele, SWFP const& swfp, WFXPList& xings);
+        void findThresholdCrossings(StrawElectronics const& strawele, SWFP const& swfp, CLHEP::RandGaussQ& randgauss, WFXPList& xings);
+        void digitizeStraw(StrawPhysics const& strawphys,
+            StrawElectronics const& strawele,
+            StrawClusterSequencePair const& hsp,
+            CLHEP::RandGaussQ& randgauss,
+            StrawDigiCollection* digis, StrawDigiADCWaveformCollection* digiadcs, StrawDigiMCCollection* mcdigis);
+        void digitizeStrawsParallel(StrawPhysics const& strawphys,
+            StrawElectronics const& strawele,
+            StrawClusterMap const& hmap,
+            StrawDigiCollection* digis, StrawDigiADCWaveformCollection* digiadcs, StrawDigiMCCollection* mcdigis);
         void createDigis(StrawPhysics const& strawphys,
             StrawElectronics const& strawele,
             Straw const& straw,
             StrawClusterSequencePair const& hsp,
             XTalk const& xtalk,
+            CLHEP::RandGaussQ& randgauss,
             StrawDigiCollection* digis, StrawDigiADCWaveformCollection* digiadcs, StrawDigiMCCollection* mcdigis);
         void fillDigis(StrawPhysics const& strawphys,
             StrawElectronics const& strawele,
             WFXPList const& xings,SWFP const& swfp , StrawId sid,
+            CLHEP::RandGaussQ& randgauss,
             StrawDigiCollection* digis, StrawDigiADCWaveformCollection* digiadcs, StrawDigiMCCollection* mcdigis);
-        bool createDigi(StrawElectronics const& strawele,WFXP const& xpair, SWFP const& wf, StrawId sid, StrawDigiCollection* digis,
+        bool createDigi(StrawElectronics const& strawele,WFXP const& xpair, SWFP const& wf, StrawId sid,
+            CLHEP::RandGaussQ& randgauss, StrawDigiCollection* digis,
             StrawDigiADCWaveformCollection* digiadcs, double &digitization_ready_time);
         void findCrossTalkStraws(Straw const& straw,vector<XTalk>& xtalk);
         void fillClusterNe(StrawPhysics const& strawphys,std::vector<unsigned>& me);
@@ -319,6 +339,7 @@ namespace mu2e {
       _mixedDigisTag(config().mixedDigisTag()),
       _mixDigiMCs(config().mixDigiMCs()),
       _allowEmptySteps(config().allowEmptySteps()),
+      _nthreads(config().nthreads()),
       // This selector will select only data products with the given instance name.
       _selector{ art::ProductInstanceNameSelector(config().spinstance())}
       {
@@ -336,6 +357,11 @@ namespace mu2e {
         produces<StrawDigiCollection>();
         produces<StrawDigiADCWaveformCollection>();
         produces<StrawDigiMCCollection>();
+        if(_nthreads > 0){
+          // waveform diagnostics fill shared trees
+          if(_diag > 1)throw cet::exception("BADCONFIG")<<"mu2e::StrawDigisFromStrawGasSteps: diagLevel > 1 requires serial digitization (DigitizationThreads 0)" << endl;
+          _arena = std::make_unique<tbb::task_arena>(static_cast<int>(_nthreads));
+        }
       }
 
     void StrawDigisFromStrawGasSteps::beginJob(){
@@ -529,26 +555,11 @@ namespace mu2e {
       // add noise clusts
       if(_addNoise)addNoise(hmap);
       // loop over the clust sequences (i.e. loop over straws, and for each get their list of clusters)
-      for(auto ihsp=hmap.begin();ihsp!= hmap.end();++ihsp){
-        StrawClusterSequencePair const& hsp = ihsp->second;
-        Straw const& straw = _tracker->getStraw(hsp.strawId());
-        // create primary digis from this clust sequence
-        XTalk self(hsp.strawId()); // this object represents the straws coupling to itself, ie 100%
-        createDigis(strawphys,strawele,straw,hsp,self,digis.get(),digiadcs.get(),mcdigis.get());
-        // if we're applying x-talk, look for nearby coupled straws
-        if(_addXtalk) {
-          // only apply if the charge is above a threshold
-          double totalCharge = 0;
-          for(auto ih=hsp.clustSequence(StrawEnd::cal).clustList().begin();ih!= hsp.clustSequence(StrawEnd::cal).clustList().end();++ih){
-            totalCharge += ih->charge();
-          }
-          if( totalCharge > _ctMinCharge){
-            vector<XTalk> xtalk;
-            findCrossTalkStraws(straw,xtalk);
-            for(auto ixtalk=xtalk.begin();ixtalk!=xtalk.end();++ixtalk){
-              createDigis(strawphys,strawele,straw,hsp,*ixtalk,digis.get(),digiadcs.get(),mcdigis.get());
-            }
-          }
+      if(_nthreads > 0){
+        digitizeStrawsParallel(strawphys,strawele,hmap,digis.get(),digiadcs.get(),mcdigis.get());
+      } else {
+        for(auto ihsp=hmap.begin();ihsp!= hmap.end();++ihsp){
+          digitizeStraw(strawphys,strawele,ihsp->second,_randgauss,digis.get(),digiadcs.get(),mcdigis.get());
         }
       }
       // bundle up new digis in global collection
@@ -572,23 +583,91 @@ namespace mu2e {
 
     } // end produce
 
+    void StrawDigisFromStrawGasSteps::digitizeStraw(
+        StrawPhysics const& strawphys,
+        StrawElectronics const& strawele,
+        StrawClusterSequencePair const& hsp,
+        CLHEP::RandGaussQ& randgauss,
+        StrawDigiCollection* digis, StrawDigiADCWaveformCollection* digiadcs,
+        StrawDigiMCCollection* mcdigis) {
+      Straw const& straw = _tracker->getStraw(hsp.strawId());
+      // create primary digis from this clust sequence
+      XTalk self(hsp.strawId()); // this object represents the straws coupling to itself, ie 100%
+      createDigis(strawphys,strawele,straw,hsp,self,randgauss,digis,digiadcs,mcdigis);
+      // if we're applying x-talk, look for nearby coupled straws
+      if(_addXtalk) {
+        // only apply if the charge is above a threshold
+        double totalCharge = 0;
+        for(auto ih=hsp.clustSequence(StrawEnd::cal).clustList().begin();ih!= hsp.clustSequence(StrawEnd::cal).clustList().end();++ih){
+          totalCharge += ih->charge();
+        }
+        if( totalCharge > _ctMinCharge){
+          vector<XTalk> xtalk;
+          findCrossTalkStraws(straw,xtalk);
+          for(auto ixtalk=xtalk.begin();ixtalk!=xtalk.end();++ixtalk){
+            createDigis(strawphys,strawele,straw,hsp,*ixtalk,randgauss,digis,digiadcs,mcdigis);
+          }
+        }
+      }
+    }
+
+    void StrawDigisFromStrawGasSteps::digitizeStrawsParallel(
+        StrawPhysics const& strawphys,
+        StrawElectronics const& strawele,
+        StrawClusterMap const& hmap,
+        StrawDigiCollection* digis, StrawDigiADCWaveformCollection* digiadcs,
+        StrawDigiMCCollection* mcdigis) {
+      // straws are independent once their cluster sequences are filled; cross-talk digis are made from
+      // the source straw.  Each straw is digitized with its own random stream, seeded from the module
+      // engine (once per event) and the straw Id, so the result does not depend on the number of threads
+      // or on the scheduling.
+      long evtseeds[2] = {_randflat.fireInt(std::numeric_limits<int>::max()),
+        _randflat.fireInt(std::numeric_limits<int>::max())};
+      std::vector<StrawClusterSequencePair const*> hsps;
+      hsps.reserve(hmap.size());
+      for(auto const& ihsp : hmap) hsps.push_back(&ihsp.second);
+      struct StrawDigis {
+        StrawDigiCollection digis;
+        StrawDigiADCWaveformCollection digiadcs;
+        StrawDigiMCCollection mcdigis;
+      };
+      std::vector<StrawDigis> sdigis(hsps.size());
+      _arena->execute([&]{
+          tbb::parallel_for(size_t(0),hsps.size(),[&](size_t ihsp){
+              long seeds[4] = {evtseeds[0],evtseeds[1],static_cast<long>(hsps[ihsp]->strawId().asUint16()),0};
+              CLHEP::MixMaxRng engine;
+              engine.setSeeds(seeds,4);
+              CLHEP::RandGaussQ randgauss(engine);
+              auto& sd = sdigis[ihsp];
+              digitizeStraw(strawphys,strawele,*hsps[ihsp],randgauss,&sd.digis,&sd.digiadcs,&sd.mcdigis);
+              });
+          });
+      // merge in StrawId order, as the serial loop
+      for(auto& sd : sdigis){
+        digis->insert(digis->end(),sd.digis.begin(),sd.digis.end());
+        digiadcs->insert(digiadcs->end(),sd.digiadcs.begin(),sd.digiadcs.end());
+        mcdigis->insert(mcdigis->end(),sd.mcdigis.begin(),sd.mcdigis.end());
+      }
+    }
+
     void StrawDigisFromStrawGasSteps::createDigis(
         StrawPhysics const& strawphys,
         StrawElectronics const& strawele,
         Straw const& straw,
         StrawClusterSequencePair const& hsp,
         XTalk const& xtalk,
+        CLHEP::RandGaussQ& randgauss,
         StrawDigiCollection* digis, StrawDigiADCWaveformCollection* digiadcs,
         StrawDigiMCCollection* mcdigis) {
       // instantiate waveforms for both ends of this straw
-      SWFP waveforms  ={ StrawWaveform(straw,hsp.clustSequence(StrawEnd::cal),xtalk),
-        StrawWaveform(straw,hsp.clustSequence(StrawEnd::hv),xtalk) };
+      SWFP waveforms  ={ StrawWaveform(strawele,straw,hsp.clustSequence(StrawEnd::cal),xtalk),
+        StrawWaveform(strawele,straw,hsp.clustSequence(StrawEnd::hv),xtalk) };
       // find the threshold crossing points for these waveforms
       WFXPList xings;
       // find the threshold crossings
-      findThresholdCrossings(strawele,waveforms,xings);
+      findThresholdCrossings(strawele,waveforms,randgauss,xings);
       // convert the crossing points into digis, and add them to the event data
-      fillDigis(strawphys,strawele,xings,waveforms,xtalk._dest,digis,digiadcs,mcdigis);
+      fillDigis(strawphys,strawele,xings,waveforms,xtalk._dest,randgauss,digis,digiadcs,mcdigis);
     }
 
     void StrawDigisFromStrawGasSteps::fillClusterMap(StrawPhysics const& strawphys,
@@ -795,14 +874,14 @@ namespace mu2e {
       if(clust.time() > _mbtime - _mbbuffer) shs.insert(StrawCluster(clust,-_mbtime));
     }
 
-    void StrawDigisFromStrawGasSteps::findThresholdCrossings(StrawElectronics const& strawele, SWFP const& swfp, WFXPList& xings){
+    void StrawDigisFromStrawGasSteps::findThresholdCrossings(StrawElectronics const& strawele, SWFP const& swfp, CLHEP::RandGaussQ& randgauss, WFXPList& xings){
       //randomize the threshold to account for electronics noise; this includes parts that are coherent
       // for both ends (coming from the straw itself)
       // Keep track of crossings on each end to keep them in sequence
-      double strawnoise = _randgauss.fire(0,strawele.strawNoise());
+      double strawnoise = randgauss.fire(0,strawele.strawNoise());
       // add specifics for each end
-      double thresh[2] = {_randgauss.fire(strawele.threshold(swfp[0].straw().id(),static_cast<StrawEnd::End>(0))+strawnoise,strawele.analogNoise(StrawElectronics::thresh)),
-        _randgauss.fire(strawele.threshold(swfp[0].straw().id(),static_cast<StrawEnd::End>(1))+strawnoise,strawele.analogNoise(StrawElectronics::thresh))};
+      double thresh[2] = {randgauss.fire(strawele.threshold(swfp[0].straw().id(),static_cast<StrawEnd::End>(0))+strawnoise,strawele.analogNoise(StrawElectronics::thresh)),
+        randgauss.fire(strawele.threshold(swfp[0].straw().id(),static_cast<StrawEnd::End>(1))+strawnoise,strawele.analogNoise(StrawElectronics::thresh))};
       // Initialize search when the electronics becomes enabled:
       double tstart =strawele.digitizationStartFromMarker() - _flashbuffer;
       // for reading all hits, make sure we start looking for clusters at the minimum possible cluster time
@@ -825,14 +904,14 @@ namespace mu2e {
           if(std::min(wfx[0]._time,wfx[1]._time) > 0.0 )xings.push_back(wfx);
           // search for next crossing:
           // update threshold for straw noise
-          strawnoise = _randgauss.fire(0,strawele.strawNoise());
+          strawnoise = randgauss.fire(0,strawele.strawNoise());
           for(unsigned iend=0;iend<2;++iend){
             // insure a minimum time buffer between crossings
             wfx[iend]._time += strawele.deadTimeAnalog();
             // skip to the next clust
             ++(wfx[iend]._iclust);
             // update threshold for incoherent noise
-            thresh[iend] = _randgauss.fire(strawele.threshold(swfp[0].straw().id(),static_cast<StrawEnd::End>(iend)),strawele.analogNoise(StrawElectronics::thresh));
+            thresh[iend] = randgauss.fire(strawele.threshold(swfp[0].straw().id(),static_cast<StrawEnd::End>(iend)),strawele.analogNoise(StrawElectronics::thresh));
             // find next crossing
             crosses[iend] = swfp[iend].crossesThreshold(strawele,thresh[iend],wfx[iend]);
           }
@@ -850,6 +929,7 @@ namespace mu2e {
         StrawElectronics const& strawele,
         WFXPList const& xings, SWFP const& wf,
         StrawId sid,
+        CLHEP::RandGaussQ& randgauss,
         StrawDigiCollection* digis, StrawDigiADCWaveformCollection* digiadcs,
         StrawDigiMCCollection* mcdigis ) {
       //
@@ -859,7 +939,7 @@ namespace mu2e {
       for(auto xpair : xings) {
         // create a digi from this pair.  This also performs a finial test
         // on whether the pair should make a digi
-        if(createDigi(strawele,xpair,wf,sid,digis,digiadcs,digitization_ready_time)){
+        if(createDigi(strawele,xpair,wf,sid,randgauss,digis,digiadcs,digitization_ready_time)){
           // fill associated MC truth matching. Only count the same step once
           StrawDigiMC::SGSPA sgspa;
           StrawDigiMC::PA cpos;
@@ -894,7 +974,7 @@ namespace mu2e {
     }
 
     bool StrawDigisFromStrawGasSteps::createDigi(StrawElectronics const& strawele, WFXP const& xpair, SWFP const& waveform,
-        StrawId sid, StrawDigiCollection* digis, StrawDigiADCWaveformCollection* digiadcs, double &digitization_ready_time){
+        StrawId sid, CLHEP::RandGaussQ& randgauss, StrawDigiCollection* digis, StrawDigiADCWaveformCollection* digiadcs, double &digitization_ready_time){
       // initialize the float variables that we later digitize
       TDCTimes xtimes = {0.0,0.0};
       TrkTypes::TOTValues tot;
@@ -911,10 +991,10 @@ namespace mu2e {
         WFX const& wfx = xpair[iend];
         // record the crossing time for this end, including clock jitter  These already include noise effects
         // add noise for TDC on each side
-        double tdc_jitter = _randgauss.fire(0.0,strawele.TDCResolution());
+        double tdc_jitter = randgauss.fire(0.0,strawele.TDCResolution());
         xtimes[iend] = wfx._time+dt+tdc_jitter;
         // randomize threshold using the incoherent noise
-        double threshold = _randgauss.fire(wfx._vcross,strawele.analogNoise(StrawElectronics::thresh));
+        double threshold = randgauss.fire(wfx._vcross,strawele.analogNoise(StrawElectronics::thresh));
         // find TOT
         tot[iend] = waveform[iend].digitizeTOT(strawele,threshold,wfx._time + dt);
         // sample ADC
@@ -929,7 +1009,7 @@ namespace mu2e {
       // add ends and add noise
       ADCVoltages wfsum; wfsum.reserve(adctimes.size());
       for(unsigned isamp=0;isamp<adctimes.size();++isamp){
-        wfsum.push_back(wf[0][isamp]+wf[1][isamp]+_randgauss.fire(0.0,strawele.analogNoise(StrawElectronics::adc)));
+        wfsum.push_back(wf[0][isamp]+wf[1][isamp]+randgauss.fire(0.0,strawele.analogNoise(StrawElectronics::adc)));
       }
       // digitize, and make final test.  This call includes the clock error WRT the proton pulse
       TrkTypes::TDCValues tdcs;
@@ -6,6 +6,7 @@
 // Original author David Brown, LBNL
 //
 #include "Offline/TrackerMC/inc/StrawWaveform.hh"
+#include <algorithm>
 #include <cmath>
 #include <boost/math/special_functions/binomial.hpp>
 
@@ -13,13 +14,33 @@ using namespace std;
 namespace mu2e {
   using namespace TrkTypes;
   namespace TrackerMC {
-    StrawWaveform::StrawWaveform(Straw const& straw, StrawClusterSequence const& hseq, XTalk const& xtalk) :
-      _cseq(hseq), _xtalk(xtalk), _straw(straw)
-    {}
-
-    StrawWaveform::StrawWaveform(StrawWaveform const& other) : _cseq(other._cseq),
-    _xtalk(other._xtalk), _straw(other._straw)
-    {}
+    StrawWaveform::StrawWaveform(StrawElectronics const& strawele, Straw const& straw, StrawClusterSequence const& hseq, XTalk const& xtalk) :
+      _cseq(hseq), _xtalk(xtalk), _straw(straw), _tend(0.0)
+    {
+      StrawClusterList const& hlist = _cseq.clustList();
+      size_t nclust = hlist.size();
+      _ctimes.reserve(nclust);
+      _cresps.reserve(nclust);
+      _maxresps.reserve(nclust);
+      _maxtimes.reserve(nclust);
+      for(auto const& clust : hlist){
+        _ctimes.push_back(clust.time());
+        _cresps.push_back(strawele.clusterResponse(_straw,clust.charge(),clust.wireDistance()));
+        // ignore saturation effects
+        double linresp = strawele.maxLinearResponse(_straw.id(),StrawElectronics::thresh,clust.wireDistance(),clust.charge());
+        linresp *= (_xtalk._preamp + _xtalk._postamp);
+        _maxresps.push_back(linresp);
+        _maxtimes.push_back(strawele.maxResponseTime(_straw.id(),StrawElectronics::thresh,clust.wireDistance()));
+        _tend = std::max(_tend,strawele.linearResponseEndTime(_cresps.back()));
+      }
+      for(auto& endresp : _endresps)
+        endresp.resize(nclust);
+      for(size_t ic=0;ic<nclust;++ic){
+        _endresps[threshresp][ic] = strawele.linearResponse(_straw.id(),StrawElectronics::thresh,_tend,_cresps[ic]);
+        _endresps[adcresp][ic] = strawele.linearResponse(_straw.id(),StrawElectronics::adc,_tend,_cresps[ic]);
+        _endresps[satresp][ic] = strawele.linearResponse(_straw.id(),StrawElectronics::thresh,_tend,_cresps[ic],true);
+      }
+    }
 
     bool StrawWaveform::crossesThreshold(StrawElectronics const& strawele,double threshold,WFX& wfx) const {
       bool retval(false);
@@ -43,7 +64,7 @@ namespace mu2e {
             //// check if this clust could cross threshold
             //if(wfx._vstart + maxLinearResponse(wfx._iclust) > threshold){
             // check the actual response
-            double maxtime = wfx._iclust->time()+strawele.maxResponseTime(_straw.id(),StrawElectronics::thresh,wfx._iclust->wireDistance());
+            double maxtime = wfx._iclust->time()+_maxtimes[clustIndex(wfx._iclust)];
             double maxresp = sampleWaveform(strawele,StrawElectronics::thresh,maxtime);
             if(maxresp > threshold){
               // interpolate to find the precise crossing
@@ -64,7 +85,7 @@ namespace mu2e {
     void StrawWaveform::returnCrossing(StrawElectronics const& strawele, double threshold, WFX& wfx) const {
       while(wfx._iclust != _cseq.clustList().end() && wfx._vstart > threshold) {
         // move forward in time at least as twice the time to the maxium for this clust
-        double time = wfx._iclust->time()+strawele.clusterLookbackTime() + 2*strawele.maxResponseTime(_straw.id(),StrawElectronics::thresh,wfx._iclust->wireDistance());
+        double time = wfx._iclust->time()+strawele.clusterLookbackTime() + 2*_maxtimes[clustIndex(wfx._iclust)];
         while(wfx._iclust != _cseq.clustList().end() &&
             wfx._iclust->time()-strawele.clusterLookbackTime() < time){
           ++(wfx._iclust);
@@ -95,7 +116,7 @@ namespace mu2e {
     bool StrawWaveform::fineCrossing(StrawElectronics const& strawele, double threshold,double maxresp, WFX& wfx) const {
       static double timestep(0.020); // interpolation minimum to use linear threshold crossing calculation
       double pretime = wfx._iclust->time()-strawele.clusterLookbackTime();
-      double posttime = pretime + strawele.clusterLookbackTime() + strawele.maxResponseTime(_straw.id(),StrawElectronics::thresh,wfx._iclust->wireDistance());
+      double posttime = pretime + strawele.clusterLookbackTime() + _maxtimes[clustIndex(wfx._iclust)];
       double presample = wfx._vstart;
       double postsample = maxresp;
       static const unsigned maxstep(10); // 10 steps max
@@ -140,23 +161,12 @@ namespace mu2e {
     }
 
     double StrawWaveform::maxLinearResponse(StrawElectronics const& strawele,StrawClusterList::const_iterator const& iclust) const {
-      // ignore saturation effects
-      double linresp = strawele.maxLinearResponse(_straw.id(),StrawElectronics::thresh,iclust->wireDistance(),iclust->charge());
-      linresp *= (_xtalk._preamp + _xtalk._postamp);
-      return linresp;
+      return _maxresps[clustIndex(iclust)];
     }
 
     double StrawWaveform::sampleWaveform(StrawElectronics const& strawele,StrawElectronics::Path ipath,double time) const {
-      // loop over all clusts and add their response at this time
-      StrawClusterList const& hlist = _cseq.clustList();
-      double linresp(0.0);
-      auto iclust = hlist.begin();
-      while(iclust != hlist.end() && iclust->time()-strawele.clusterLookbackTime() < time){
-        // compute the linear straw electronics response to this charge.  This is pre-saturation
-        linresp += strawele.linearResponse(_straw,ipath,time-iclust->time(),iclust->charge(),iclust->wireDistance());
-        // move to next clust
-        ++iclust;
-      }
+      // add the response of all clusts at this time
+      double linresp = linearResponse(strawele,ipath,false,0,time);
       double totresp = linresp * _xtalk._postamp;
       if(_xtalk._preamp>0.0)
         totresp += _xtalk._preamp*linresp;
@@ -176,8 +186,8 @@ namespace mu2e {
 
       // check if going to be saturated
       double max_possible_voltage = 0;
-      for (auto iclust = _cseq.clustList().begin();iclust != _cseq.clustList().end();++iclust){
-        max_possible_voltage += maxLinearResponse(strawele,iclust);
+      for (auto maxresp : _maxresps){
+        max_possible_voltage += maxresp;
       }
       if (max_possible_voltage > strawele.saturationVoltage()){
         // create waveform of threshold circuit output
@@ -204,12 +214,7 @@ namespace mu2e {
         for (int i=0;i<num_steps;i++){
           double time = iclust->time()-strawele.clusterLookbackTime() + i*strawele.saturationTimeStep();
           // sum up the preamp response at this step
-          double response = 0;
-          auto jclust = iclust;
-          while(jclust != _cseq.clustList().end() && jclust->time()-strawele.clusterLookbackTime() < time){
-            response += strawele.linearResponse(_straw,StrawElectronics::thresh,time-jclust->time(),jclust->charge(),jclust->wireDistance(),true);
-            ++jclust;
-          }
+          double response = linearResponse(strawele,StrawElectronics::thresh,true,clustIndex(iclust),time);
           // now saturate it
           double sat_response = strawele.saturatedResponse(response);
           // then calculate the impulse response at each of the adctimes and add it to that
@@ -225,6 +230,27 @@ namespace mu2e {
       }
     }
 
+    double StrawWaveform::linearResponse(StrawElectronics const& strawele,StrawElectronics::Path ipath,bool forsaturation,size_t ibegin,double time) const {
+      // clusts contribute from the lookback time before their arrival
+      auto ifirst = _ctimes.begin() + ibegin;
+      auto ilast = std::partition_point(ifirst,_ctimes.end(),
+          [&strawele,time](double ctime){ return ctime-strawele.clusterLookbackTime() < time; });
+      // the clusts whose response has ended contribute a constant
+      auto iactive = std::partition_point(ifirst,ilast,
+          [this,time](double ctime){ return time-ctime > _tend; });
+      size_t nactive = iactive - _ctimes.begin();
+      size_t nlast = ilast - _ctimes.begin();
+      auto const& endresp = _endresps[forsaturation ? satresp : (ipath == StrawElectronics::thresh ? threshresp : adcresp)];
+      double linresp(0.0);
+      for(size_t ic=ibegin;ic<nactive;++ic)
+        linresp += endresp[ic];
+      for(size_t ic=nactive;ic<nlast;++ic){
+        // compute the linear straw electronics response to this charge.  This is pre-saturation
+        linresp += strawele.linearResponse(_straw.id(),ipath,time-_ctimes[ic],_cresps[ic],forsaturation);
+      }
+      return linresp;
+    }
+
     unsigned short StrawWaveform::digitizeTOT(StrawElectronics const& strawele, double threshold, double time) const {
       for (size_t i=1;i<strawele.maxTOT();i++){
         if (sampleWaveform(strawele,StrawElectronics::thresh,time + i*strawele.totLSB()) < threshold - strawele.triggerHysteresis())
@@ -0,0 +1,118 @@
+//
+// Compare the batched evaluation of an MVATools network to the single candidate
+// evaluation of each feature vector: the scores must be bitwise identical, and the
+// time per candidate is printed.
+// The feature vectors are drawn uniformly inside the normalization range of each
+// input variable of the network, or in [-1,1] if the network does not normalize its inputs.
+//
+// The work is done in the beginJob member function; no event data are needed.
+//
+
+#include "Offline/Mu2eUtilities/inc/MVATools.hh"
+#include "Offline/SeedService/inc/SeedService.hh"
+
+#include "art/Framework/Core/EDAnalyzer.h"
+#include "art/Framework/Principal/Event.h"
+#include "cetlib_except/exception.h"
+#include "fhiclcpp/types/Atom.h"
+#include "fhiclcpp/types/Table.h"
+
+#include "CLHEP/Random/RandFlat.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <span>
+#include <vector>
+
+namespace mu2e {
+
+  class MVAToolsBenchmark : public art::EDAnalyzer {
+    public:
+      struct Config {
+        using Name = fhicl::Name;
+        using Comment = fhicl::Comment;
+        fhicl::Table<MVATools::Config> mva{ Name("MVA"), Comment("Network to evaluate") };
+        fhicl::Atom<unsigned> nCandidates{ Name("NCandidates"), Comment("Number of feature vectors to score") };
+        fhicl::Atom<unsigned> nRepeat{ Name("NRepeat"), Comment("Number of times each method is timed; the fastest is reported"), 5 };
+      };
+      using Parameters = art::EDAnalyzer::Table<Config>;
+
+      explicit MVAToolsBenchmark(const Parameters& conf);
+      void beginJob() override;
+      void analyze(const art::Event&) override {}
+
+    private:
+      MVATools mva_;
+      unsigned ncand_;
+      unsigned nrepeat_;
+      CLHEP::RandFlat flat_;
+  };
+
+  MVAToolsBenchmark::MVAToolsBenchmark(const Parameters& conf) :
+    art::EDAnalyzer(conf),
+    mva_(conf().mva()),
+    ncand_(conf().nCandidates()),
+    nrepeat_(conf().nRepeat()),
+    flat_(createEngine(art::ServiceHandle<SeedService>()->getSeed()))
+  {}
+
+  void MVAToolsBenchmark::beginJob() {
+    mva_.initMVA();
+    const unsigned nvars = mva_.labels().size();
+
+    std::vector<float> features;
+    features.reserve(size_t(ncand_)*nvars);
+    for (unsigned icand=0; icand < ncand_; ++icand) {
+      for (unsigned ivar=0; ivar < nvars; ++ivar) {
+        auto range = mva_.isNormalized() ? mva_.range(ivar) : std::make_pair(-1.0f,1.0f);
+        features.push_back(flat_.fire(range.first,range.second));
+      }
+    }
+
+    // the vector evaluation is the reference; the span evaluation avoids the copy into a vector
+    std::vector<float> reference(ncand_), single(ncand_), batch(ncand_);
+    double nsReference(0.0), nsSingle(0.0), nsBatch(0.0);
+    std::vector<float> fv(nvars);
+    for (unsigned irep=0; irep < nrepeat_; ++irep) {
+      auto tr = std::chrono::steady_clock::now();
+      for (unsigned icand=0; icand < ncand_; ++icand) {
+        std::copy_n(features.begin()+size_t(icand)*nvars,nvars,fv.begin());
+        reference[icand] = mva_.evalMVA(fv);
+      }
+      auto t0 = std::chrono::steady_clock::now();
+      for (unsigned icand=0; icand < ncand_; ++icand)
+        single[icand] = mva_.evalMVA(std::span<const float>(features).subspan(size_t(icand)*nvars,nvars));
+      auto t1 = std::chrono::steady_clock::now();
+      mva_.evalMVA(std::span<const float>(features),nvars,std::span<float>(batch));
+      auto t2 = std::chrono::steady_clock::now();
+      double ns0 = std::chrono::duration<double, std::nano>(t0 - tr).count()/ncand_;
+      double ns1 = std::chrono::duration<double, std::nano>(t1 - t0).count()/ncand_;
+      double ns2 = std::chrono::duration<double, std::nano>(t2 - t1).count()/ncand_;
+      if (irep == 0 || ns0 < nsReference) nsReference = ns0;
+      if (irep == 0 || ns1 < nsSingle) nsSingle = ns1;
+      if (irep == 0 || ns2 < nsBatch) nsBatch = ns2;
+    }
+
+    unsigned nsdiff(0), nbdiff(0);
+    for (unsigned icand=0; icand < ncand_; ++icand) {
+      if (std::memcmp(&reference[icand],&single[icand],sizeof(float)) != 0) ++nsdiff;
+      if (std::memcmp(&reference[icand],&batch[icand],sizeof(float)) != 0) ++nbdiff;
+    }
+
+    std::cout << "MVAToolsBenchmark: " << ncand_ << " candidates, " << nvars << " variables" << std::endl
+      << std::fixed << std::setprecision(1)
+      << "  vector  " << std::setw(10) << nsReference << " ns/candidate" << std::endl
+      << "  span    " << std::setw(10) << nsSingle << " ns/candidate" << std::endl
+      << "  batched " << std::setw(10) << nsBatch  << " ns/candidate (" << MVATools::kBatch << " per block)" << std::endl
+      << "  scores that differ from the vector evaluation: span " << nsdiff << ", batched " << nbdiff << std::defaultfloat << std::endl;
+
+    if (nsdiff > 0 || nbdiff > 0)
+      throw cet::exception("MVATools") << "MVAToolsBenchmark: " << nsdiff << " span and " << nbdiff
+        << " batched scores differ from the vector evaluation" << std::endl;
+  }
+}
+
+DEFINE_ART_MODULE(mu2e::MVAToolsBenchmark)
@@ -0,0 +1,88 @@
+//
+// Index of background clusters on a time x (x,y) grid, used by the clusterers to restrict
+// hit-cluster and cluster-cluster comparisons to the neighbouring cells.
+//
+// The time cells are the time buckets of the clusterer; the spatial cells are square.
+// Each cell holds a doubly linked list of cluster indices, so a cluster whose centroid
+// moved is relinked in constant time; call move() after each centroid update.
+// Positions outside the grid are put in the nearest border cell: this is safe for a
+// neighbour search, as clamping never increases the cell distance of two points.
+//
+#ifndef BkgClusterGrid_HH
+#define BkgClusterGrid_HH
+
+#include "Offline/RecoDataProducts/inc/BkgCluster.hh"
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+
+namespace mu2e {
+
+  class BkgClusterGrid
+  {
+    public:
+      // empty the grid and set its binning; the spatial cell size is at least minCellSize
+      void reset(int ntime, float tbin, float xmin, float xmax, float ymin, float ymax, float minCellSize);
+
+      int  timeCell(float time) const { return clamp(int(time/tbin_), ntime_); }
+      int  xCell   (float x)    const { return clamp(int((x-xmin_)/cellSize_), nx_); }
+      int  yCell   (float y)    const { return clamp(int((y-ymin_)/cellSize_), ny_); }
+      // number of spatial cells to search on each side for points within distance
+      int  nSpaceCells(float distance) const { return std::max(int(std::ceil(distance/cellSize_)),1); }
+
+      // add cluster ic at the current position of the cluster
+      void insert(unsigned ic, const BkgCluster& cluster);
+      // relink cluster ic if it changed cell
+      void move  (unsigned ic, const BkgCluster& cluster);
+      // time cell the cluster is currently linked in
+      int  timeCellOf(unsigned ic) const { return entries_[ic].cell/(nx_*ny_); }
+
+      // call func(ic) for all the clusters in time cells [itmin,itmax) within dxy cells of (x,y)
+      template <class FUNC> void forEach(int itmin, int itmax, float x, float y, int dxy, FUNC&& func) const;
+
+
+    private:
+      struct Entry
+      {
+        int cell = -1;
+        int prev = -1;
+        int next = -1;
+      };
+
+      static int clamp(int i, int n) { return std::min(std::max(i,0),n-1); }
+      int  cellOf(const BkgCluster& cluster) const;
+      void link  (unsigned ic, int cell);
+      void unlink(unsigned ic);
+
+      int                ntime_    = 1;
+      int                nx_       = 1;
+      int                ny_       = 1;
+      float              tbin_     = 1.0f;
+      float              xmin_     = 0.0f;
+      float              ymin_     = 0.0f;
+      float              cellSize_ = 1.0f;
+      std::vector<int>   head_;
+      std::vector<Entry> entries_;
+  };
+
+
+  template <class FUNC> void BkgClusterGrid::forEach(int itmin, int itmax, float x, float y, int dxy, FUNC&& func) const
+  {
+    itmin = std::max(itmin,0);
+    itmax = std::min(itmax,ntime_);
+    const int ix = xCell(x), iy = yCell(y);
+    const int ixmin = std::max(ix-dxy,0), ixmax = std::min(ix+dxy,nx_-1);
+    const int iymin = std::max(iy-dxy,0), iymax = std::min(iy+dxy,ny_-1);
+    for (int it=itmin;it<itmax;++it) {
+      for (int jx=ixmin;jx<=ixmax;++jx) {
+        const int* row = head_.data() + (it*nx_ + jx)*ny_;
+        for (int jy=iymin;jy<=iymax;++jy) {
+          for (int ic=row[jy];ic!=-1;ic=entries_[ic].next) func(unsigned(ic));
+        }
+      }
+    }
+  }
+}
+#endif
@@ -0,0 +1,73 @@
+//
+// Background cluster classification shared by the clusterers: the cluster features used
+// by the keras (SOFIE) models, and a batched evaluation of those models.
+//
+// The SOFIE sessions evaluate one cluster per call and return a new vector each time.
+// Here the weights of the session are used in place, and all the clusters of an event
+// go through each dense layer with a single sgemm call, into preallocated buffers.
+// The session must outlive the BkgClusterMVA that uses its weights.
+//
+#ifndef BkgClusterMVA_HH
+#define BkgClusterMVA_HH
+
+#include "Offline/RecoDataProducts/inc/BkgCluster.hh"
+#include "Offline/RecoDataProducts/inc/ComboHit.hh"
+
+#include <array>
+#include <vector>
+
+
+namespace mu2e {
+
+  class BkgClusterMVA
+  {
+    public:
+      static constexpr unsigned nFeatures = 12;
+      using Features = std::array<float,nFeatures>;
+
+      // Fill the features of a cluster; false if it fails the active hit or plane cut,
+      // in which case it is not classified
+      static bool fillFeatures(const BkgCluster& cluster, const ComboHitCollection& chcol,
+                               unsigned minnhits, unsigned minnp, Features& features);
+
+      // Use the weights of a SOFIE session made of 4 dense layers (relu, relu, relu, sigmoid).
+      // The model may use fewer inputs than nFeatures: it then sees the first ones only.
+      template <class SESSION> void setWeights(const SESSION& session);
+
+      // Score the clusters passing the cuts with one batched inference, and set their KerasQ
+      void classify(BkgClusterCollection& clusters, const ComboHitCollection& chcol,
+                    unsigned minnhits, unsigned minnp, int diag = 0);
+
+      // Score a set of feature vectors
+      void infer(const std::vector<Features>& features, std::vector<float>& scores);
+
+
+    private:
+      struct Layer
+      {
+        const float* kernel = nullptr;
+        const float* bias   = nullptr;
+        int          nin    = 0;
+        int          nout   = 0;
+      };
+      static constexpr unsigned nLayers_ = 4;
+
+      void setLayer(unsigned ilayer, const std::vector<float>& kernel, const std::vector<float>& bias);
+
+      std::array<Layer,nLayers_> layers_;
+      std::vector<Features>      features_;
+      std::vector<unsigned>      candidates_;
+      std::vector<float>         scores_;
+      std::vector<float>         work_;
+  };
+
+
+  template <class SESSION> void BkgClusterMVA::setWeights(const SESSION& session)
+  {
+    setLayer(0, session.fTensor_densekernel0,  session.fTensor_densebias0bcast);
+    setLayer(1, session.fTensor_dense1kernel0, session.fTensor_dense1bias0bcast);
+    setLayer(2, session.fTensor_dense2kernel0, session.fTensor_dense2bias0bcast);
+    setLayer(3, session.fTensor_dense3kernel0, session.fTensor_dense3bias0bcast);
+  }
+}
+#endif
@@ -13,6 +13,11 @@ namespace mu2e
       virtual void  init        () = 0;
       virtual void  findClusters(BkgClusterCollection& clusters, const ComboHitCollection& shcol) = 0;
       virtual void  classifyCluster(BkgCluster& clusters, const ComboHitCollection& shcol) = 0;
+      // classify all the clusters of an event; clusterers with an MVA override this to batch the inference
+      virtual void  classifyClusters(BkgClusterCollection& clusters, const ComboHitCollection& shcol)
+      {
+        for (auto& cluster : clusters) classifyCluster(cluster, shcol);
+      }
 
       virtual float distance    (const BkgCluster& cluster, const ComboHit& hit) const = 0;
 
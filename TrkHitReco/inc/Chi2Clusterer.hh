@@ -9,6 +9,7 @@
 
 #include "Offline/GeneralUtilities/inc/CombineTwoDPoints.hh"
 #include "Offline/RecoDataProducts/inc/StrawDigi.hh"
+#include "Offline/TrkHitReco/inc/BkgClusterMVA.hh"
 #include "Offline/TrkHitReco/inc/BkgClusterer.hh"
 #include "Offline/TrkHitReco/inc/TrainBkgDiag.hxx"
 #include "Offline/TrkHitReco/inc/TrainBkgDiagStationChi2SLine.hxx"
@@ -63,6 +64,7 @@ namespace mu2e {
       void init();
       virtual void  findClusters   (BkgClusterCollection& clusters, const ComboHitCollection& shcol);
       virtual void  classifyCluster(BkgCluster& cluster,            const ComboHitCollection& chcol);
+      virtual void  classifyClusters(BkgClusterCollection& clusters, const ComboHitCollection& chcol);
       virtual float distance       (const BkgCluster& cluster,      const ComboHit& hit) const;
 
 
@@ -96,6 +98,7 @@ namespace mu2e {
 
       std::shared_ptr<TMVA_SOFIE_TrainBkgDiag::Session>                 sofiePtr1_;
       std::shared_ptr<TMVA_SOFIE_TrainBkgDiagStationChi2SLine::Session> sofiePtr2_;
+      BkgClusterMVA                                                     mva_;
   };
 }
 #endif
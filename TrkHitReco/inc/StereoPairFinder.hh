@@ -0,0 +1,81 @@
+//
+// Candidate search for stereo hit pairing.  The selected hits are stored by unique panel and
+// sorted by corrected time, in structure-of-arrays form.  For a given hit, the candidates of a
+// panel are found by a binary search of the time window followed by a branch-free transverse
+// distance test over the whole window, which the compiler vectorizes.
+//
+// This is a prefilter: it returns a superset of the hits passing the MakeStereoHits time and
+// transverse distance cuts, in increasing hit index order, so the final (order dependent)
+// combination gives the same result as looping over all the hits of the panel.
+//
+#ifndef TrkHitReco_StereoPairFinder_hh
+#define TrkHitReco_StereoPairFinder_hh
+
+#include "Offline/DataProducts/inc/StrawId.hh"
+#include "Offline/RecoDataProducts/inc/ComboHit.hh"
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+
+namespace mu2e {
+
+  class StereoPairFinder
+  {
+    public:
+      StereoPairFinder(float maxDt, float maxDPerp);
+
+      // store the hits passing the selection, SEL is called as select(const ComboHit&)
+      template <class SEL> void fill(const ComboHitCollection& chcol, SEL&& select);
+      // number of stored hits in a unique panel
+      size_t nHits(uint16_t upanel) const { return offsets_[upanel+1]-offsets_[upanel]; }
+      // append to cands the indices of the candidate partners of ch in a unique panel
+      void candidates(const ComboHit& ch, uint16_t upanel, std::vector<uint32_t>& cands);
+
+
+    private:
+      void sortPanels(const ComboHitCollection& chcol);
+
+      float                                  maxDt_;
+      float                                  maxDPerp2_; // slightly enlarged square of the maximum transverse distance
+      std::array<uint32_t,StrawId::_nupanels+1> offsets_;
+      std::vector<uint32_t>                  index_;     // hit index, by panel and time
+      std::vector<float>                     time_;
+      std::vector<float>                     x_;
+      std::vector<float>                     y_;
+      std::vector<uint8_t>                   pass_;      // work buffer
+  };
+
+
+  template <class SEL> void StereoPairFinder::fill(const ComboHitCollection& chcol, SEL&& select)
+  {
+    offsets_.fill(0);
+    index_.clear();
+    if (chcol.hasPanelIndex()) {
+      // the hits of each panel are already contiguous, in hit index order
+      index_.reserve(chcol.size());
+      for (uint16_t upanel=0;upanel<StrawId::_nupanels;++upanel) {
+        auto range = chcol.panelRange(upanel);
+        for (size_t ich=range.first;ich<range.second;++ich) {
+          if (select(chcol[ich])) index_.push_back(ich);
+        }
+        offsets_[upanel+1] = index_.size();
+      }
+      sortPanels(chcol);
+      return;
+    }
+    // counting sort by panel, keeping the hit index order
+    for (size_t ich=0;ich<chcol.size();++ich) {
+      if (select(chcol[ich])) ++offsets_[chcol[ich].strawId().uniquePanel()+1];
+    }
+    for (size_t ipanel=0;ipanel<StrawId::_nupanels;++ipanel) offsets_[ipanel+1] += offsets_[ipanel];
+    index_.resize(offsets_.back());
+    auto next = offsets_;
+    for (size_t ich=0;ich<chcol.size();++ich) {
+      if (select(chcol[ich])) index_[next[chcol[ich].strawId().uniquePanel()]++] = ich;
+    }
+    sortPanels(chcol);
+  }
+}
+#endif
@@ -10,6 +10,8 @@
 #include "fhiclcpp/types/Atom.h"
 #include "fhiclcpp/types/Sequence.h"
 #include "Offline/RecoDataProducts/inc/StrawDigi.hh"
+#include "Offline/TrkHitReco/inc/BkgClusterGrid.hh"
+#include "Offline/TrkHitReco/inc/BkgClusterMVA.hh"
 #include "Offline/TrkHitReco/inc/BkgClusterer.hh"
 #include "Offline/TrkHitReco/inc/TrainBkgDiag.hxx"
 
@@ -71,6 +73,7 @@ namespace mu2e {
       void          init        ();
       virtual void  findClusters   (BkgClusterCollection& clusters, const ComboHitCollection& shcol);
       virtual void  classifyCluster(BkgCluster& cluster,            const ComboHitCollection& chcol);
+      virtual void  classifyClusters(BkgClusterCollection& clusters, const ComboHitCollection& chcol);
       virtual float distance       (const BkgCluster& cluster,      const ComboHit& hit) const;
 
 
@@ -109,8 +112,10 @@ namespace mu2e {
       std::string             kerasW_;
       int                     diag_;
       BkgCluster::distMethod  distMethodFlag_;
+      BkgClusterGrid          grid_;
 
       std::shared_ptr<TMVA_SOFIE_TrainBkgDiag::Session> sofiePtr_;
+      BkgClusterMVA                                     mva_;
   };
 }
 #endif
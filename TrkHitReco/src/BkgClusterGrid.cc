@@ -0,0 +1,73 @@
+#include "Offline/TrkHitReco/inc/BkgClusterGrid.hh"
+
+#include <cmath>
+
+
+namespace mu2e
+{
+  namespace {
+    // limit on the number of spatial cells along each axis
+    constexpr int maxSpaceCells = 64;
+  }
+
+
+  //---------------------------------------------------------------------------------------
+  void BkgClusterGrid::reset(int ntime, float tbin, float xmin, float xmax, float ymin, float ymax, float minCellSize)
+  {
+    float extent = std::max(std::max(xmax-xmin,ymax-ymin),0.0f);
+    ntime_    = std::max(ntime,1);
+    tbin_     = tbin;
+    xmin_     = xmin;
+    ymin_     = ymin;
+    cellSize_ = std::max(minCellSize,extent/float(maxSpaceCells-1));
+    if (!(cellSize_ > 0.0f)) cellSize_ = 1.0f;
+    nx_       = std::min(int((xmax-xmin)/cellSize_)+1,maxSpaceCells);
+    ny_       = std::min(int((ymax-ymin)/cellSize_)+1,maxSpaceCells);
+
+    head_.assign(size_t(ntime_)*nx_*ny_,-1);
+    entries_.clear();
+  }
+
+
+  //---------------------------------------------------------------------------------------
+  int BkgClusterGrid::cellOf(const BkgCluster& cluster) const
+  {
+    return (timeCell(cluster.time())*nx_ + xCell(cluster.pos().x()))*ny_ + yCell(cluster.pos().y());
+  }
+
+  void BkgClusterGrid::link(unsigned ic, int cell)
+  {
+    Entry& entry = entries_[ic];
+    entry.cell = cell;
+    entry.prev = -1;
+    entry.next = head_[cell];
+    if (entry.next != -1) entries_[entry.next].prev = ic;
+    head_[cell] = ic;
+  }
+
+  void BkgClusterGrid::unlink(unsigned ic)
+  {
+    Entry& entry = entries_[ic];
+    if (entry.prev != -1) entries_[entry.prev].next = entry.next;
+    else                  head_[entry.cell]         = entry.next;
+    if (entry.next != -1) entries_[entry.next].prev = entry.prev;
+    entry.cell = -1;
+  }
+
+
+  //---------------------------------------------------------------------------------------
+  void BkgClusterGrid::insert(unsigned ic, const BkgCluster& cluster)
+  {
+    if (ic >= entries_.size()) entries_.resize(ic+1);
+    if (entries_[ic].cell != -1) unlink(ic);
+    link(ic,cellOf(cluster));
+  }
+
+  void BkgClusterGrid::move(unsigned ic, const BkgCluster& cluster)
+  {
+    int cell = cellOf(cluster);
+    if (cell == entries_[ic].cell) return;
+    unlink(ic);
+    link(ic,cell);
+  }
+}
@@ -0,0 +1,199 @@
+#include "Offline/TrkHitReco/inc/BkgClusterMVA.hh"
+#include "Offline/DataProducts/inc/StrawId.hh"
+#include "cetlib_except/exception.h"
+
+#include "TMath.h"
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+
+
+// the BLAS routine used by the SOFIE generated code
+extern "C" void sgemm_(const char * transa, const char * transb, const int * m, const int * n, const int * k,
+                       const float * alpha, const float * A, const int * lda, const float * B, const int * ldb,
+                       const float * beta, float * C, const int * ldc);
+
+
+namespace mu2e
+{
+  // the batched inference reads the feature vectors as one contiguous matrix
+  static_assert(sizeof(BkgClusterMVA::Features) == BkgClusterMVA::nFeatures*sizeof(float));
+
+
+  //---------------------------------------------------------------------------------------
+  bool BkgClusterMVA::fillFeatures(const BkgCluster& cluster, const ComboHitCollection& chcol,
+                                   unsigned minnhits, unsigned minnp, Features& features)
+  {
+    // count hits and planes
+    std::array<int,StrawId::_nplanes> hitplanes{0};
+    for (const auto& chit : cluster.hits()) {
+    const ComboHit& ch = chcol[chit];
+    hitplanes[ch.strawId().plane()] += ch.nStrawHits();
+    }
+
+    unsigned npexp(0),np(0),nhits(0);
+    int ipmin(0),ipmax(StrawId::_nplanes-1);
+    while (hitplanes[ipmin]==0 && ipmin<StrawId::_nplanes) ++ipmin;
+    while (hitplanes[ipmax]==0 and ipmax>0)                --ipmax;
+    int fp(ipmin),lp(ipmin-1),pgap(0);
+    for (int ip = ipmin; ip <= ipmax; ++ip) {
+    npexp++; // should use TTracker to see if plane is physically present FIXME!
+    if (hitplanes[ip]> 0){
+      ++np;
+      if(lp > 0 && ip - lp -1 > pgap)pgap = ip - lp -1;
+      if(ip > lp)lp = ip;
+      if(ip < fp)fp = ip;
+      lp = ip;
+    }
+    nhits += hitplanes[ip];
+    }
+
+
+    if(nhits < minnhits || np < minnp) return false;
+
+    // find averages
+    double sumEdep(0.);
+    double sqrSumDeltaTime(0.);
+    double sqrSumDeltaX(0.);
+    double sqrSumDeltaY(0.);
+    double sqrSumQual(0.);
+    double sumPitch(0.);
+    double sumYaw(0.);
+    double sumwPitch(0.);
+    double sumwYaw(0.);
+    double sumEcc(0.);
+    double sumwEcc(0.);
+    unsigned nsthits(0.);
+    unsigned nchits = cluster.hits().size();
+    for (const auto& chit : cluster.hits()) {
+      sumEdep         +=  chcol[chit].energyDep()/chcol[chit].nStrawHits();
+      sqrSumDeltaX    += std::pow(chcol[chit].pos().x() - cluster.pos().x(),2);
+      sqrSumDeltaY    += std::pow(chcol[chit].pos().y() - cluster.pos().y(),2);
+      sqrSumDeltaTime += std::pow(chcol[chit].time() - cluster.time(),2);
+      auto hdir        = chcol[chit].hDir();
+      auto wecc        = chcol[chit].nStrawHits();
+      sumEcc          += std::sqrt(1-(chcol[chit].vVar()/chcol[chit].uVar()))*wecc;
+      sumwEcc         += wecc;
+      if (chcol[chit].flag().hasAllProperties(StrawHitFlag::sline)){
+
+        //quality of SLine fit
+        sqrSumQual += std::pow(chcol[chit].qual(),2);
+
+        //angle with Mu2e-Y
+        double varPitch = std::pow(TMath::ACos(std::sqrt(chcol[chit].hcostVar())),2);
+        double wPitch = 1/varPitch;
+        double signPitch = hdir.Y()/std::abs(hdir.Y());
+        sumPitch += signPitch*wPitch*hdir.theta();
+        sumwPitch += wPitch;
+
+        ROOT::Math::XYZVectorF z = {0,0,1};
+        ROOT::Math::XYZVectorF dxdz = {hdir.X(),0,hdir.Z()};
+        float magdxdz = std::sqrt(dxdz.Mag2());
+
+        //angle with Mu2e-Z
+        double varYaw = std::sqrt(chcol[chit].hphiVar() + varPitch);
+        double wYaw = 1/varYaw;
+        double signYaw = hdir.X()/std::abs(hdir.X());
+        sumYaw += signYaw*wYaw*TMath::ACos(dxdz.Dot(z)/magdxdz);
+        sumwYaw += wYaw;
+
+        // # of stereo hits with SLine
+        nsthits++;
+      }
+    }
+
+    // fill mva input variables
+    features[0]  = cluster.pos().Rho(); // cluster rho, cyl coor
+    features[1]  = fp;// first plane hit
+    features[2]  = lp;// last plane hit
+    features[3]  = pgap;// largest plane gap without hits between planes with hits
+    features[4]  = np;// # of planes hit
+    features[5]  =  static_cast<float>(np)/static_cast<float>(lp - fp);// fraction of planes hit between first and last plane
+    features[6]  = nhits;// sum of straw hits
+    features[7]  = std::sqrt((sqrSumDeltaX+sqrSumDeltaY)/nchits);  // RMS of cluster rho
+    features[8]  = std::sqrt(sqrSumDeltaTime/nchits);// RMS of cluster time
+    features[9]  = nsthits > 0 ? sumPitch/sumwPitch : 0.;
+    features[10] = nsthits > 0 ? sumYaw/sumwYaw : 0.;
+    features[11] = sumEcc/sumwEcc;
+
+    return true;
+  }
+
+
+  //---------------------------------------------------------------------------------------
+  void BkgClusterMVA::setLayer(unsigned ilayer, const std::vector<float>& kernel, const std::vector<float>& bias)
+  {
+    Layer& layer = layers_[ilayer];
+    layer.kernel = kernel.data();
+    layer.bias   = bias.data();
+    layer.nout   = bias.size();
+    layer.nin    = layer.nout > 0 ? kernel.size()/layer.nout : 0;
+
+    int nin = ilayer == 0 ? nFeatures : layers_[ilayer-1].nout;
+    if (layer.nout == 0 || kernel.size() != size_t(layer.nin*layer.nout) || (ilayer == 0 ? layer.nin > nin : layer.nin != nin) ||
+        (ilayer+1 == nLayers_ && layer.nout != 1))
+      throw cet::exception("RECO")<< "BkgClusterMVA: unexpected shape of dense layer " << ilayer << ": "
+                                  << kernel.size() << " weights, " << bias.size() << " outputs" << std::endl;
+  }
+
+
+  //---------------------------------------------------------------------------------------
+  void BkgClusterMVA::classify(BkgClusterCollection& clusters, const ComboHitCollection& chcol,
+                               unsigned minnhits, unsigned minnp, int diag)
+  {
+    // first compute the features of all the clusters, then evaluate the model once
+    features_.resize(clusters.size());
+    candidates_.clear();
+    for (size_t icl=0; icl<clusters.size(); ++icl) {
+      if (fillFeatures(clusters[icl], chcol, minnhits, minnp, features_[candidates_.size()]))
+        candidates_.push_back(icl);
+    }
+    features_.resize(candidates_.size());
+
+    infer(features_, scores_);
+
+    for (size_t icand=0; icand<candidates_.size(); ++icand) {
+      clusters[candidates_[icand]].setKerasQ(scores_[icand]);
+      if (diag>0)std::cout << "kerasout = " << scores_[icand] << std::endl;
+    }
+  }
+
+
+  //---------------------------------------------------------------------------------------
+  void BkgClusterMVA::infer(const std::vector<Features>& features, std::vector<float>& scores)
+  {
+    scores.resize(features.size());
+    if (features.empty()) return;
+    if (layers_[0].kernel == nullptr)
+      throw cet::exception("RECO")<< "BkgClusterMVA: no model weights set" << std::endl;
+
+    // column-major activations, one column per cluster, alternating between two buffers
+    const int ncand = features.size();
+    int maxout(0);
+    for (const auto& layer : layers_) maxout = std::max(maxout,layer.nout);
+    work_.resize(size_t(2*maxout)*ncand);
+
+    const char trans('n');
+    const float one(1.0f);
+    const float* input = features.front().data();
+    int ldin = nFeatures;
+    for (unsigned ilayer=0; ilayer<nLayers_; ++ilayer) {
+      const Layer& layer = layers_[ilayer];
+      float* output = work_.data() + (ilayer%2)*size_t(maxout)*ncand;
+      for (int icand=0; icand<ncand; ++icand)
+        std::copy(layer.bias, layer.bias+layer.nout, output + size_t(icand)*layer.nout);
+      sgemm_(&trans, &trans, &layer.nout, &ncand, &layer.nin, &one, layer.kernel, &layer.nout,
+             input, &ldin, &one, output, &layer.nout);
+
+      size_t nval = size_t(layer.nout)*ncand;
+      if (ilayer+1 < nLayers_) {
+        for (size_t ival=0; ival<nval; ++ival) output[ival] = (output[ival] > 0) ? output[ival] : 0;
+      } else {
+        for (size_t ival=0; ival<nval; ++ival) scores[ival] = 1 / (1 + std::exp( - output[ival]));
+      }
+      input = output;
+      ldin  = layer.nout;
+    }
+  }
+}
@@ -130,7 +130,7 @@ namespace mu2e {
     chcolNew->reserve(chcOrig.size());
     chcolNew->setParent(chcH);
 
-    if (_unsorted){
+    if (_unsorted && !chcOrig.hasPanelIndex()){
       // currently VST data is not sorted by panel number so we must sort manually
       // sort hits by panel
       ComboHitCollection chcolsort;
@@ -152,6 +152,7 @@ namespace mu2e {
     }else{
       combine(ewm, chcOrig, *chcolNew);
     }
+    chcolNew->setPanelIndex();
     event.put(std::move(chcolNew));
   }
 
@@ -44,6 +44,7 @@ namespace mu2e
         fhicl::OptionalTable<Chi2Clusterer::Config>   Chi2Clustering{       Name("Chi2Clustering"),       Comment("Chi2 Clusterer config") };
         fhicl::OptionalTable<DBSClusterer::Config>    DBSClustering{        Name("DBSClustering"),        Comment("DBS Clusterer config") };
         fhicl::Atom<float>                            kerasQuality{         Name("KerasQuality"),         Comment("Keras quality cut") };
+        fhicl::Atom<bool>                             batchClassify{        Name("BatchClassify"),        Comment("Classify all the clusters of an event with one batched inference"),true };
         fhicl::Atom<int>                              debugLevel{           Name("DebugLevel"),           Comment("Debug"),0 };
       };
 
@@ -62,6 +63,7 @@ namespace mu2e
       float                                       cperr2_;
       int const                                   debug_;
       float                                       kerasQ_;
+      bool                                        batch_;
       int                                         iev_;
 
       void classifyCluster(BkgClusterCollection& bkgccol, StrawHitFlagCollection& chfcol, const ComboHitCollection& chcol) const;
@@ -78,6 +80,7 @@ namespace mu2e
     bkgmsk_(      config().backgroundMask()),
     debug_(       config().debugLevel()),
     kerasQ_(      config().kerasQuality()),
+    batch_(       config().batchClassify()),
     iev_(0)
     {
       ConfigFileLookupPolicy configFile;
@@ -212,6 +215,7 @@ namespace mu2e
           throw cet::exception("RECO")<< "FlagBkgHits: inconsistent ComboHit output" << std::endl;
       }
     }
+    chcol_out->setPanelIndex();
     event.put(std::move(chcol_out));
 
     //produce background collection
@@ -228,8 +232,9 @@ namespace mu2e
   //------------------------------------------------------------------------------------------
   void FlagBkgHits::classifyCluster(BkgClusterCollection& bkgccol, StrawHitFlagCollection& chfcol, const ComboHitCollection& chcol) const
   {
+    if (batch_) clusterer_->classifyClusters(bkgccol,chcol);
     for (auto& cluster : bkgccol) {
-      clusterer_->classifyCluster(cluster,chcol);
+      if (!batch_) clusterer_->classifyCluster(cluster,chcol);
       StrawHitFlag flag(StrawHitFlag::bkgclust);
       if (cluster.getKerasQ()> kerasQ_) {
         flag.merge(StrawHitFlag(StrawHitFlag::bkg));
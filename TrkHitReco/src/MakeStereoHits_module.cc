@@ -20,6 +20,7 @@
 #include "Offline/RecoDataProducts/inc/ComboHit.hh"
 #include "Offline/RecoDataProducts/inc/StrawHitFlag.hh"
 #include "Offline/TrkHitReco/inc/CombineStereoPoints.hh"
+#include "Offline/TrkHitReco/inc/StereoPairFinder.hh"
 #include "Offline/DataProducts/inc/EventWindowMarker.hh"
 // boost
 //#include <boost/accumulators/accumulators.hpp>
@@ -90,6 +91,7 @@ namespace mu2e {
       bool          _sline;      // fit to a line
       unsigned      _slinendof;  // minimum NDOF to use the sline fit when producing output ComboHits
       StrawIdMask   _smask;      // mask for combining hits
+      StereoPairFinder _pairs;   // candidate search in the overlapping panels
 
       std::array<std::vector<StrawId>,StrawId::_nupanels > _panelOverlap;   // which panels overlap each other
       void genMap();
@@ -117,7 +119,8 @@ namespace mu2e {
     _filter(config().filter()),
     _sline(config().sline()),
     _slinendof(config().slinendof()),
-    _smask(config().smask())
+    _smask(config().smask()),
+    _pairs(_maxDt,_maxDPerp)
     {
       produces<ComboHitCollection>();
     }
@@ -135,25 +138,22 @@ namespace mu2e {
     auto chcol = std::make_unique<ComboHitCollection>();
     chcol->reserve(inchcol.size());
     chcol->setParent(chcH);
-    // sort hits by unique panel.  This should be built in by construction upstream TODO!!
-    std::array<std::vector<uint16_t>,StrawId::_nupanels> phits;
+    // store the selected hits by panel and time
     size_t nch = inchcol.size();
     if(_debug > 2)std::cout << "MakeStereoHits found " << nch << " Input hits" << std::endl;
     std::vector<bool> used(nch,false);
-    for(uint16_t ihit=0;ihit<nch;++ihit){
-      ComboHit const& ch = inchcol[ihit];
-      // select hits based on flag
-      if( (!_testflag) ||( ch.flag().hasAllProperties(_shsel) && (!ch.flag().hasAnyProperty(_shrej))) ){
-        phits[ch.strawId().uniquePanel()].push_back(ihit);
-      }
-    }
+    _pairs.fill(inchcol,[this](ComboHit const& ch) {
+        // select hits based on flag
+        return (!_testflag) ||( ch.flag().hasAllProperties(_shsel) && (!ch.flag().hasAnyProperty(_shrej)));
+        });
     if(_debug > 3){
       for (unsigned ipan=0; ipan < StrawId::_nupanels; ++ipan) {
-        if(phits[ipan].size() > 0 ){
-          std::cout << "Panel " << ipan << " has " << phits[ipan].size() << " hits "<< std::endl;
+        if(_pairs.nHits(ipan) > 0 ){
+          std::cout << "Panel " << ipan << " has " << _pairs.nHits(ipan) << " hits "<< std::endl;
         }
       }
     }
+    std::vector<uint32_t> cands;
     //  Loop over all hits.  Every one must appear somewhere in the output
     for (size_t ihit=0;ihit<nch;++ihit) {
       if(used[ihit])continue;
@@ -168,8 +168,10 @@ namespace mu2e {
       if( (!_testflag) ||( ch1.flag().hasAllProperties(_shsel) && (!ch1.flag().hasAnyProperty(_shrej))) ){
         // loop over the panels which overlap this hit's panel
         for (auto sid : _panelOverlap[ch1.strawId().uniquePanel()]) {
-          // loop over hits in the overlapping panel
-          for (auto jhit : phits[sid.uniquePanel()]) {
+          // loop over the hits in the overlapping panel that are close in time and space, in index order
+          cands.clear();
+          _pairs.candidates(ch1,sid.uniquePanel(),cands);
+          for (auto jhit : cands) {
             const ComboHit& ch2 = inchcol[jhit];
             if (!used[jhit] && cpts.nPoints() < ComboHit::MaxNCombo  && ( (!_testflag) ||( ch2.flag().hasAllProperties(_shsel) && (!ch2.flag().hasAnyProperty(_shrej)))) ){
               if(_debug > 3) std::cout << " comparing hits in panels " << ch1.strawId().uniquePanel() << " and " << ch2.strawId().uniquePanel() << std::endl;
@@ -232,6 +234,7 @@ namespace mu2e {
       if( (!_filter) || ( combohit.flag().hasAllProperties(_shsel) &&
             (!combohit.flag().hasAnyProperty(_shrej))) ) chcol->push_back(combohit);
     }
+    chcol->setPanelIndex();
     event.put(std::move(chcol));
   }
 
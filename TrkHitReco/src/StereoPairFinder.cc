@@ -0,0 +1,75 @@
+#include "Offline/TrkHitReco/inc/StereoPairFinder.hh"
+
+#include <algorithm>
+#include <cmath>
+
+
+namespace mu2e
+{
+  StereoPairFinder::StereoPairFinder(float maxDt, float maxDPerp) :
+    maxDt_(maxDt),
+    // margin for the rounding of the distance computed in MakeStereoHits
+    maxDPerp2_(maxDPerp*maxDPerp*(1.0f+1.0e-4f))
+  {
+    offsets_.fill(0);
+  }
+
+
+  //---------------------------------------------------------------------------------------
+  void StereoPairFinder::sortPanels(const ComboHitCollection& chcol)
+  {
+    for (size_t ipanel=0;ipanel<StrawId::_nupanels;++ipanel) {
+      std::sort(index_.begin()+offsets_[ipanel],index_.begin()+offsets_[ipanel+1],
+                [&chcol](uint32_t i1, uint32_t i2) {
+                  float t1 = chcol[i1].correctedTime(), t2 = chcol[i2].correctedTime();
+                  return t1 < t2 || (t1 == t2 && i1 < i2);
+                });
+    }
+    size_t nhits = index_.size();
+    time_.resize(nhits);
+    x_.resize(nhits);
+    y_.resize(nhits);
+    for (size_t ihit=0;ihit<nhits;++ihit) {
+      const ComboHit& ch = chcol[index_[ihit]];
+      time_[ihit] = ch.correctedTime();
+      x_[ihit]    = ch.pos().x();
+      y_[ihit]    = ch.pos().y();
+    }
+  }
+
+
+  //---------------------------------------------------------------------------------------
+  void StereoPairFinder::candidates(const ComboHit& ch, uint16_t upanel, std::vector<uint32_t>& cands)
+  {
+    const float t0 = ch.correctedTime();
+    const float x0 = ch.pos().x();
+    const float y0 = ch.pos().y();
+
+    // time window, using the same test as MakeStereoHits: |t0-t| is monotonic in t on each side
+    // of t0, so the hits passing it are contiguous
+    const float* tbeg = time_.data()+offsets_[upanel];
+    const float* tend = time_.data()+offsets_[upanel+1];
+    const float* tlo = std::partition_point(tbeg,tend,[&](float t){ return t < t0 && !(std::fabs(t0-t) < maxDt_); });
+    const float* thi = std::partition_point(tlo, tend,[&](float t){ return t <= t0 || std::fabs(t0-t) < maxDt_; });
+    const size_t ilo = tlo-time_.data(), nwin = thi-tlo;
+    if (nwin == 0) return;
+
+    // transverse distance of the whole window
+    pass_.resize(nwin);
+    const float* xw = x_.data()+ilo;
+    const float* yw = y_.data()+ilo;
+    uint8_t*     pw = pass_.data();
+    for (size_t iwin=0;iwin<nwin;++iwin) {
+      const float dx = xw[iwin]-x0;
+      const float dy = yw[iwin]-y0;
+      pw[iwin] = dx*dx+dy*dy < maxDPerp2_;
+    }
+
+    // restore the hit index order
+    const size_t nold = cands.size();
+    for (size_t iwin=0;iwin<nwin;++iwin) {
+      if (pw[iwin]) cands.push_back(index_[ilo+iwin]);
+    }
+    std::sort(cands.begin()+nold,cands.end());
+  }
+}
@@ -218,6 +218,9 @@ namespace mu2e {
         _shrUtils.flagCrossTalk(shCol, chCol);
       }
     }
+    // index the hits by panel for downstream modules; this requires the digis to be in panel order,
+    // which is the case for simulation and the DAQ, but not for some test stand data
+    chCol->setPanelIndex();
     if(_writesh)event.put(std::move(shCol));
     intInfo->setNTrackerHits(chCol->size());
     event.put(std::move(intInfo));
@@ -1,9 +1,8 @@
 #include "Offline/TrkHitReco/inc/TNTClusterer.hh"
 #include "Offline/ConfigTools/inc/ConfigFileLookupPolicy.hh"
 
-#include "TMath.h"
-
 #include <algorithm>
+#include <cmath>
 #include <vector>
 #include <queue>
 
@@ -49,6 +48,7 @@ namespace mu2e
      ConfigFileLookupPolicy configFile;
      auto kerasWgtsFile = configFile(kerasW_);
      sofiePtr_          = std::make_shared<TMVA_SOFIE_TrainBkgDiag::Session>(kerasWgtsFile);
+     mva_.setWeights(*sofiePtr_);
   }
 
 
@@ -75,13 +75,21 @@ namespace mu2e
   void TNTClusterer::initClustering(const ComboHitCollection& chcol, std::vector<BkgHit>& BkgHits)
   {
      float maxTime(0);
+     float xmin(0),xmax(0),ymin(0),ymax(0);
      for (size_t ich=0;ich<chcol.size();++ich) {
        if (testflag_ && (!chcol[ich].flag().hasAllProperties(sigmask_) || chcol[ich].flag().hasAnyProperty(bkgmask_))) continue;
+       const auto& pos = chcol[ich].pos();
+       if (BkgHits.empty()) {xmin = xmax = pos.x(); ymin = ymax = pos.y();}
+       xmin = std::min(xmin,pos.x()); xmax = std::max(xmax,pos.x());
+       ymin = std::min(ymin,pos.y()); ymax = std::max(ymax,pos.y());
        BkgHits.emplace_back(BkgHit(ich));
        maxTime = std::max(maxTime,chcol[ich].correctedTime());
      }
      tbin_ = (maxTime+1.0)/float(numBuckets_);
 
+     // hits farther than maxDistance from a cluster are never associated with it, so that is the cell size
+     grid_.reset(numBuckets_,tbin_,xmin,xmax,ymin,ymax,std::sqrt(md2_));
+
      auto resPred = [&chcol](const BkgHit& x, const BkgHit& y) {return chcol[x.chidx_].wireRes() < chcol[y.chidx_].wireRes();};
      if (comboInit_) std::sort(BkgHits.begin(),BkgHits.end(),resPred);
   }
@@ -90,6 +98,8 @@ namespace mu2e
   //----------------------------------------------------------------------------------------------------------------------
   void TNTClusterer::doClustering(const ComboHitCollection& chcol, std::vector<BkgCluster>& clusters, std::vector<BkgHit>& BkgHits)
   {
+    for (size_t ic=0;ic<clusters.size();++ic) grid_.insert(ic,clusters[ic]);
+
     unsigned niter(0);
     float odist(2.0f*maxDistSum_);
     float tdist(0.0f);
@@ -109,18 +119,15 @@ namespace mu2e
   //-------------------------------------------------------------------------------------------------------------------
   // loop over hits, re-affect them to their original cluster if they are still within the radius, otherwise look at
   // candidate clusters to check if they could be added. If not, make a new cluster.
-  // speed up: don't update clusters who haven't changed + cache cluster id in a given time window in clusterIndex (array if vectors)
+  // speed up: don't update clusters who haven't changed + look for candidate clusters in the neighbouring cells of a
+  // time x space grid, which follows the clusters as their centroids move
   //
   unsigned TNTClusterer::formClusters(const ComboHitCollection& chcol, std::vector<BkgCluster>& clusters, std::vector<BkgHit>& BkgHits)
   {
-    std::array<std::vector<int>, numBuckets_> clusterIndices;
-    for (size_t ic=0;ic<clusters.size();++ic) {
-      int itime  = int(clusters[ic].time()/tbin_);
-      clusterIndices[itime].emplace_back(ic);
-      clusters[ic].clearHits();
-    }
+    for (auto& cluster : clusters) cluster.clearHits();
 
     int ditime(int(maxHitdt_/tbin_));
+    int dxy(grid_.nSpaceCells(std::sqrt(md2_)));
     unsigned nchanged(0);
     for (size_t ihit=0;ihit<BkgHits.size();++ihit) {
 
@@ -133,19 +140,20 @@ namespace mu2e
         continue;
       }
 
-      // -- find closest cluster. restrict search to clusters close in time using the clusterIndices structure
+      // -- find closest cluster. restrict search to clusters close in time and space using the grid. Ties go to the
+      //    cluster in the earliest time bucket, then to the lowest index, as in a scan of the buckets in time order
       int minc(-1);
       float mindist(dseed_ + 1.0f);
       int itime = int(chit.correctedTime()/tbin_);
-      int imin = std::max(0,itime-ditime);
-      int imax = std::min(numBuckets_,itime+ditime+1);
-
-      for (int i=imin;i<imax;++i) {
-        for (const auto& ic : clusterIndices[i]) {
-          float dist = distance(clusters[ic],chcol[hit.chidx_]);
-          if (dist < mindist) {mindist = dist;minc = ic;}
-        }
-      }
+      int minct(0);
+      auto closest = [&](unsigned ic) {
+        float dist = distance(clusters[ic],chit);
+        if (dist > mindist) return;
+        int ict = grid_.timeCellOf(ic);
+        if (dist == mindist && (minc == -1 || ict > minct || (ict == minct && int(ic) > minc))) return;
+        mindist = dist; minc = ic; minct = ict;
+      };
+      grid_.forEach(itime-ditime,itime+ditime+1,chit.pos().x(),chit.pos().y(),dxy,closest);
 
       // -- either add hit to existing cluster, form new cluster, or do nothing if hit is "in between"
       if (mindist < dhit_) {
@@ -155,8 +163,7 @@ namespace mu2e
         minc = clusters.size();
         clusters.emplace_back(chit.pos(),chit.correctedTime(),distMethodFlag_);
         clusters[minc].addHit(ihit);
-        int itime = int(chit.correctedTime()/tbin_);
-        clusterIndices[itime].emplace_back(minc);
+        grid_.insert(minc,clusters[minc]);
       }
       else{
         BkgHits[ihit].distance_ = 10000.0f;
@@ -182,10 +189,12 @@ namespace mu2e
     }
 
     // -- update cluster and hit distance if needed
-    for (auto& cluster : clusters) {
+    for (size_t ic=0;ic<clusters.size();++ic) {
+      auto& cluster = clusters[ic];
       if (cluster._flag == BkgClusterFlag::update) {
         cluster._flag = BkgClusterFlag::unchanged;
         updateCluster(cluster, chcol, BkgHits);
+        grid_.move(ic,cluster);
         if (cluster.hits().size()==1) {BkgHits[cluster.hits().at(0)].distance_ = 0.0f;}
         else {
           for (auto& hit : cluster.hits()) BkgHits[hit].distance_ = distance(cluster,chcol[BkgHits[hit].chidx_]);
@@ -201,17 +210,34 @@ namespace mu2e
   void TNTClusterer::mergeClusters(std::vector<BkgCluster>& clusters, const ComboHitCollection& chcol,
                                    std::vector<BkgHit>& BkgHits, float dt, float dd2)
   {
+    // only pairs in neighbouring cells of the grid can be close enough
+    int ditime(int(std::ceil(dt/tbin_)));
+    int dxy(grid_.nSpaceCells(std::sqrt(dd2)));
+    std::vector<unsigned> partners;
+
     unsigned niter(0);
     while (niter < maxNiter_) {
       int nchanged(0);
-      for (auto it1 = clusters.begin();it1 != std::prev(clusters.end());++it1) {
-        if (it1->hits().empty()) continue;
-        for (auto it2 = std::next(it1);it2!=clusters.end();++it2) {
-          if (it2->hits().empty()) continue;
-          if (std::abs(it1->time() - it2->time()) > dt) continue;
-          if ((it1->pos() - it2->pos()).perp2() > dd2)  continue;
+      for (size_t ic1=0;ic1<clusters.size();++ic1) {
+        auto& clu1 = clusters[ic1];
+        if (clu1.hits().empty()) continue;
+        partners.clear();
+        auto close = [&](unsigned ic2) {
+          const auto& clu2 = clusters[ic2];
+          if (ic2 <= ic1 || clu2.hits().empty()) return;
+          if (std::abs(clu1.time() - clu2.time()) > dt) return;
+          if ((clu1.pos() - clu2.pos()).perp2() > dd2)  return;
+          partners.push_back(ic2);
+        };
+        int itime = grid_.timeCellOf(ic1);
+        grid_.forEach(itime-ditime,itime+ditime+1,clu1.pos().x(),clu1.pos().y(),dxy,close);
+
+        // merge in index order, as a scan over all the pairs would
+        std::sort(partners.begin(),partners.end());
+        for (auto ic2 : partners) {
+          for (auto hit : clusters[ic2].hits()) BkgHits[hit].clusterIdx_ = ic1;
           ++nchanged;
-          mergeTwoClusters(*it1,*it2);
+          mergeTwoClusters(clu1,clusters[ic2]);
         }
       }
 
@@ -219,8 +245,11 @@ namespace mu2e
       if (diag_>0) std::cout<<"Merge "<<niter<<" "<<nchanged<<"  "<<clusters.size()<<std::endl;
       if (nchanged==0) break;
 
-      std::remove_if(clusters.begin(),clusters.end(),[](auto& cluster) {return cluster.hits().empty();});
-      for (auto& cluster : clusters ) updateCluster(cluster, chcol, BkgHits);
+      // empty clusters are kept so that the hit to cluster indices stay valid, findClusters removes them
+      for (size_t ic=0;ic<clusters.size();++ic) {
+        updateCluster(clusters[ic], chcol, BkgHits);
+        grid_.move(ic,clusters[ic]);
+      }
     }
     return;
   }
@@ -338,98 +367,8 @@ namespace mu2e
   //---------------------------------------------------------------------------------------
   void TNTClusterer::classifyCluster(BkgCluster& cluster, const ComboHitCollection& chcol)
   {
-    // count hits and planes
-    std::array<int,StrawId::_nplanes> hitplanes{0};
-    for (const auto& chit : cluster.hits()) {
-    const ComboHit& ch = chcol[chit];
-    hitplanes[ch.strawId().plane()] += ch.nStrawHits();
-    }
-
-    unsigned npexp(0),np(0),nhits(0);
-    int ipmin(0),ipmax(StrawId::_nplanes-1);
-    while (hitplanes[ipmin]==0 && ipmin<StrawId::_nplanes) ++ipmin;
-    while (hitplanes[ipmax]==0 and ipmax>0)                --ipmax;
-    int fp(ipmin),lp(ipmin-1),pgap(0);
-    for (int ip = ipmin; ip <= ipmax; ++ip) {
-    npexp++; // should use TTracker to see if plane is physically present FIXME!
-    if (hitplanes[ip]> 0){
-      ++np;
-      if(lp > 0 && ip - lp -1 > pgap)pgap = ip - lp -1;
-      if(ip > lp)lp = ip;
-      if(ip < fp)fp = ip;
-      lp = ip;
-    }
-    nhits += hitplanes[ip];
-    }
-
-
-    if(nhits < minnhits_ || np < minnp_) return;
-
-    // find averages
-    double sumEdep(0.);
-    double sqrSumDeltaTime(0.);
-    double sqrSumDeltaX(0.);
-    double sqrSumDeltaY(0.);
-    double sqrSumQual(0.);
-    double sumPitch(0.);
-    double sumYaw(0.);
-    double sumwPitch(0.);
-    double sumwYaw(0.);
-    double sumEcc(0.);
-    double sumwEcc(0.);
-    unsigned nsthits(0.);
-    unsigned nchits = cluster.hits().size();
-    for (const auto& chit : cluster.hits()) {
-      sumEdep         +=  chcol[chit].energyDep()/chcol[chit].nStrawHits();
-      sqrSumDeltaX    += std::pow(chcol[chit].pos().x() - cluster.pos().x(),2);
-      sqrSumDeltaY    += std::pow(chcol[chit].pos().y() - cluster.pos().y(),2);
-      sqrSumDeltaTime += std::pow(chcol[chit].time() - cluster.time(),2);
-      auto hdir        = chcol[chit].hDir();
-      auto wecc        = chcol[chit].nStrawHits();
-      sumEcc          += std::sqrt(1-(chcol[chit].vVar()/chcol[chit].uVar()))*wecc;
-      sumwEcc         += wecc;
-      if (chcol[chit].flag().hasAllProperties(StrawHitFlag::sline)){
-
-        //quality of SLine fit
-        sqrSumQual += std::pow(chcol[chit].qual(),2);
-
-        //angle with Mu2e-Y
-        double varPitch = std::pow(TMath::ACos(std::sqrt(chcol[chit].hcostVar())),2);
-        double wPitch = 1/varPitch;
-        double signPitch = hdir.Y()/std::abs(hdir.Y());
-        sumPitch += signPitch*wPitch*hdir.theta();
-        sumwPitch += wPitch;
-
-        ROOT::Math::XYZVectorF z = {0,0,1};
-        ROOT::Math::XYZVectorF dxdz = {hdir.X(),0,hdir.Z()};
-        float magdxdz = std::sqrt(dxdz.Mag2());
-
-        //angle with Mu2e-Z
-        double varYaw = std::sqrt(chcol[chit].hphiVar() + varPitch);
-        double wYaw = 1/varYaw;
-        double signYaw = hdir.X()/std::abs(hdir.X());
-        sumYaw += signYaw*wYaw*TMath::ACos(dxdz.Dot(z)/magdxdz);
-        sumwYaw += wYaw;
-
-        // # of stereo hits with SLine
-        nsthits++;
-      }
-    }
-
-    // fill mva input variables
-    std::array<float,12> kerasvars;
-    kerasvars[0]  = cluster.pos().Rho(); // cluster rho, cyl coor
-    kerasvars[1]  = fp;// first plane hit
-    kerasvars[2]  = lp;// last plane hit
-    kerasvars[3]  = pgap;// largest plane gap without hits between planes with hits
-    kerasvars[4]  = np;// # of planes hit
-    kerasvars[5]  =  static_cast<float>(np)/static_cast<float>(lp - fp);// fraction of planes hit between first and last plane
-    kerasvars[6]  = nhits;// sum of straw hits
-    kerasvars[7]  = std::sqrt((sqrSumDeltaX+sqrSumDeltaY)/nchits);  // RMS of cluster rho
-    kerasvars[8]  = std::sqrt(sqrSumDeltaTime/nchits);// RMS of cluster time
-    kerasvars[9]  = nsthits > 0 ? sumPitch/sumwPitch : 0.;
-    kerasvars[10] = nsthits > 0 ? sumYaw/sumwYaw : 0.;
-    kerasvars[11] = sumEcc/sumwEcc;
+    BkgClusterMVA::Features kerasvars;
+    if (!BkgClusterMVA::fillFeatures(cluster, chcol, minnhits_, minnp_, kerasvars)) return;
 
     std::vector<float> kerasout = sofiePtr_->infer(kerasvars.data());
     cluster.setKerasQ(kerasout[0]);
@@ -438,6 +377,13 @@ namespace mu2e
   }
 
 
+  //---------------------------------------------------------------------------------------
+  void TNTClusterer::classifyClusters(BkgClusterCollection& clusters, const ComboHitCollection& chcol)
+  {
+    mva_.classify(clusters, chcol, minnhits_, minnp_, diag_);
+  }
+
+
 
   //-------------------------------------------------------------------------------------------
   void TNTClusterer::dump(const std::vector<BkgCluster>& clusters, const std::vector<BkgHit>& BkgHits)
@@ -0,0 +1,137 @@
+//
+// Scaling of the TNTClusterer with the hit multiplicity.  For a multiplicity of N, the ComboHits
+// of the current event are overlaid with those of the N-1 previous events, which approximates
+// N times the nominal pileup, and the clustering of the combined collection is timed.
+// At the end of the job, the time per event and per hit is printed for each multiplicity,
+// together with the exponent of the time versus number of hits relative to the first one
+// (1 for linear scaling).
+//
+
+#include "Offline/RecoDataProducts/inc/ComboHit.hh"
+#include "Offline/TrkHitReco/inc/TNTClusterer.hh"
+
+#include "art/Framework/Core/EDAnalyzer.h"
+#include "art/Framework/Principal/Event.h"
+#include "canvas/Utilities/InputTag.h"
+#include "cetlib_except/exception.h"
+#include "fhiclcpp/types/Atom.h"
+#include "fhiclcpp/types/Sequence.h"
+#include "fhiclcpp/types/Table.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <deque>
+#include <iomanip>
+#include <iostream>
+#include <vector>
+
+namespace mu2e {
+
+  class TNTClustererBenchmark : public art::EDAnalyzer {
+    public:
+      struct Config {
+        using Name = fhicl::Name;
+        using Comment = fhicl::Comment;
+        fhicl::Atom<art::InputTag>          comboHitCollection{ Name("ComboHitCollection"), Comment("ComboHit collection name") };
+        fhicl::Table<TNTClusterer::Config>  TNTClustering{      Name("TNTClustering"),      Comment("TNT Clusterer config") };
+        fhicl::Sequence<unsigned>           multiplicities{     Name("Multiplicities"),     Comment("Number of events overlaid in each test"), std::vector<unsigned>{1,2,4} };
+        fhicl::Atom<unsigned>               nRepeat{            Name("NRepeat"),            Comment("Number of times each clustering is timed; the fastest is used"), 1 };
+      };
+      using Parameters = art::EDAnalyzer::Table<Config>;
+
+      explicit TNTClustererBenchmark(const Parameters& conf);
+      void analyze(const art::Event& event) override;
+      void endJob() override;
+
+    private:
+      struct Result {
+        unsigned long nevents   = 0;
+        unsigned long nhits     = 0;
+        unsigned long nclusters = 0;
+        double        ms        = 0.0;
+      };
+
+      art::ProductToken<ComboHitCollection> chtoken_;
+      TNTClusterer                          clusterer_;
+      std::vector<unsigned>                 mult_;
+      unsigned                              nrepeat_;
+      std::deque<ComboHitCollection>        history_; // hits of the previous events, most recent first
+      std::vector<Result>                   results_;
+  };
+
+  TNTClustererBenchmark::TNTClustererBenchmark(const Parameters& conf) :
+    art::EDAnalyzer(conf),
+    chtoken_(consumes<ComboHitCollection>(conf().comboHitCollection())),
+    clusterer_(conf().TNTClustering()),
+    mult_(conf().multiplicities()),
+    nrepeat_(std::max(conf().nRepeat(),1u)),
+    results_(mult_.size())
+  {
+    if (mult_.empty() || *std::min_element(mult_.begin(),mult_.end()) == 0)
+      throw cet::exception("RECO")<< "TNTClustererBenchmark: Multiplicities must be positive" << std::endl;
+  }
+
+  void TNTClustererBenchmark::analyze(const art::Event& event) {
+    const auto& chcol = event.get(chtoken_);
+    const unsigned maxmult = *std::max_element(mult_.begin(),mult_.end());
+
+    ComboHitCollection overlay;
+    for (size_t imult=0; imult < mult_.size(); ++imult) {
+      if (history_.size()+1 < mult_[imult]) continue;
+      overlay.clear();
+      overlay.insert(overlay.end(),chcol.begin(),chcol.end());
+      for (unsigned iev=0; iev+1 < mult_[imult]; ++iev)
+        overlay.insert(overlay.end(),history_[iev].begin(),history_[iev].end());
+
+      double best(0.0);
+      size_t nclusters(0);
+      for (unsigned irep=0; irep < nrepeat_; ++irep) {
+        BkgClusterCollection clusters;
+        auto t0 = std::chrono::steady_clock::now();
+        clusterer_.findClusters(clusters,overlay);
+        auto t1 = std::chrono::steady_clock::now();
+        double ms = std::chrono::duration<double, std::milli>(t1 - t0).count();
+        if (irep == 0 || ms < best) best = ms;
+        nclusters = clusters.size();
+      }
+
+      auto& result = results_[imult];
+      ++result.nevents;
+      result.nhits     += overlay.size();
+      result.nclusters += nclusters;
+      result.ms        += best;
+    }
+
+    if (maxmult > 1) {
+      history_.push_front(chcol);
+      if (history_.size()+1 > maxmult) history_.pop_back();
+    }
+  }
+
+  void TNTClustererBenchmark::endJob() {
+    std::cout << "TNTClustererBenchmark: clustering time versus hit multiplicity" << std::endl
+      << std::setw(6) << "mult" << std::setw(8) << "events" << std::setw(10) << "hits/ev" << std::setw(12) << "clusters/ev"
+      << std::setw(10) << "ms/ev" << std::setw(10) << "us/hit" << std::setw(10) << "exponent" << std::endl;
+    const Result* first(nullptr);
+    for (size_t imult=0; imult < mult_.size(); ++imult) {
+      const auto& result = results_[imult];
+      if (result.nevents == 0) continue;
+      double nev = result.nevents;
+      std::cout << std::fixed << std::setprecision(2)
+        << std::setw(6) << mult_[imult] << std::setw(8) << result.nevents
+        << std::setw(10) << result.nhits/nev << std::setw(12) << result.nclusters/nev
+        << std::setw(10) << result.ms/nev << std::setw(10) << 1000.0*result.ms/result.nhits;
+      if (first == nullptr) {
+        first = &result;
+      } else if (result.nhits/nev != first->nhits/double(first->nevents)) {
+        double hitratio  = (result.nhits/nev)/(first->nhits/double(first->nevents));
+        double timeratio = (result.ms/nev)/(first->ms/first->nevents);
+        std::cout << std::setw(10) << std::log(timeratio)/std::log(hitratio);
+      }
+      std::cout << std::defaultfloat << std::endl;
+    }
+  }
+}
+
+DEFINE_ART_MODULE(mu2e::TNTClustererBenchmark)
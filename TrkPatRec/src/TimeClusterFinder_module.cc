@@ -38,28 +38,16 @@
 // C++
 #include <memory>
 #include <algorithm>
+#include <span>
 #include <utility>
+#include <vector>
 using namespace std;
 using namespace boost::accumulators;
 
 namespace {
 
-  struct TimeCluMVA
-  {
-    vector<Float_t> _pars;
-    Float_t& _dt;
-    Float_t& _dphi;
-    Float_t& _rho;
-    Float_t& _nsh;
-    Float_t& _plane;
-    Float_t& _werr;
-    Float_t& _wdist;
-
-    TimeCluMVA() : _pars(7,0.0), _dt(_pars[0]), _dphi(_pars[1]), _rho(_pars[2]), _nsh(_pars[3]),
-    _plane(_pars[4]), _werr(_pars[5]), _wdist(_pars[6]){}
-    //    TimeCluMVA() : _pars(5,0.0), _dt(_pars[0]), _nsh(_pars[1]),
-    //      _plane(_pars[2]), _werr(_pars[3]), _wdist(_pars[4]){}
-  };
+  // input variables of the cluster cleaning MVA, in the order of a row of the feature matrix
+  enum TimeCluMVAVar : unsigned { kDt=0, kDphi, kRho, kNsh, kPlane, kWerr, kWdist, kNTimeCluMVAVars };
 }
 
 namespace mu2e {
@@ -140,7 +128,12 @@ namespace mu2e {
       int                           _printfreq;
       int                           _debug;
       TH1F                          _timespec;
-      TimeCluMVA                    _pmva; // input variables to TMVA for cluster cleaning
+      // cluster cleaning MVA inputs of the hits being scored, kNTimeCluMVAVars values per hit,
+      // and their scores
+      std::vector<float>            _mvafeatures;
+      std::vector<float>            _mvascores;
+      std::vector<size_t>           _mvahits; // hit index of each row
+      std::vector<bool>             _incluster; // hits already in the cluster being recovered
 
 
       void findClusters(TimeClusterCollection& tccol);
@@ -151,6 +144,8 @@ namespace mu2e {
       void recoverHits(TimeCluster& tc);
       ISH  removeHit(TimeCluster& tc, ISH);
       void addHit(TimeCluster& tc,size_t iadd);
+      void addMVAFeatures(TimeCluster const& tc, ComboHit const& ch, float cht, float adphi);
+      void scoreHits(TimeCluster const& tc);
       void clusterMean(TimeCluster& tc);
       void refineCluster(TimeCluster& tc);
       void findPeaks(TimeClusterCollection& seeds);
@@ -340,13 +335,18 @@ namespace mu2e {
       for(int jbin = std::max(1,ibin-_npeak);jbin < std::min(nbins,ibin+_npeak+1); ++jbin)
         alreadyUsed[jbin] = true;
     }
-    // loop over spectrum to find peaks
+    // loop over spectrum to find peaks, highest bins first.  Bins of equal content are taken in time order.
+    // Most bins are blanked by earlier peaks, so the bins are kept in a heap and only taken as needed
     std::vector<BinContent> bcv;
     for (int ibin=1;ibin < nbins; ++ibin)
-      if (_timespec.GetBinContent(ibin) >= _ymin) bcv.push_back(make_pair(_timespec.GetBinContent(ibin),ibin));
-    std::sort(bcv.begin(),bcv.end(),[](const BinContent& x, const BinContent& y){return x.first > y.first;});
-
-    for (const auto& bc : bcv) {
+      if (!alreadyUsed[ibin] && _timespec.GetBinContent(ibin) >= _ymin) bcv.push_back(make_pair(_timespec.GetBinContent(ibin),ibin));
+    auto lower = [](const BinContent& x, const BinContent& y){return x.first < y.first || (x.first == y.first && x.second > y.second);};
+    std::make_heap(bcv.begin(),bcv.end(),lower);
+
+    while (!bcv.empty()) {
+      std::pop_heap(bcv.begin(),bcv.end(),lower);
+      BinContent bc = bcv.back();
+      bcv.pop_back();
       if (alreadyUsed[bc.second]) continue;
       float nsh(0.0);
       float t0(0.0);
@@ -436,40 +436,39 @@ namespace mu2e {
   }
 
   void TimeClusterFinder::recoverHits(TimeCluster& tc){
+    _incluster.assign(_chcol->size(),false);
+    for (auto ish : tc._strawHitIdxs) _incluster[ish] = true;
     bool changed(true);
     while (changed) {
       changed = false;
       float pphi = polyAtan2(tc._pos.y(), tc._pos.x());
-      for(size_t ich=0;ich < _chcol->size(); ++ich){
-        if ((!_testflag) || goodHit((*_chcol)[ich].flag())) {
-          if(std::find(tc._strawHitIdxs.begin(),tc._strawHitIdxs.end(),ich) == tc._strawHitIdxs.end()){
-            ComboHit const& ch = (*_chcol)[ich];
-            float cht = _ttcalc.comboHitTime(ch,_pitch);
-            _pmva._dt = fabs(cht - tc._t0._t0);
-            if(_pmva._dt < _maxdt+tc._t0._t0err){
-              float phi = polyAtan2(ch.pos().y(), ch.pos().x());//ch.phi();
-              float dphi = fabs(Angles::deltaPhi(phi,pphi));
-              if(dphi < _maxdPhi){
-                _pmva._dphi = dphi;
-                _pmva._rho = ch.pos().Perp2();
-                _pmva._nsh = ch.nStrawHits();
-                _pmva._plane = ch.strawId().plane();
-                _pmva._werr = ch.wireRes();
-                _pmva._wdist = fabs(ch.wireDist());
-
-                float mvaout(-1.0);
-                if (tc.hasCaloCluster())
-                  mvaout = _tcCaloMVA.evalMVA(_pmva._pars);
-                else
-                  mvaout = _tcMVA.evalMVA(_pmva._pars);
-                if (mvaout > _minaddmva) {
-                  addHit(tc,ich);
-                  changed = true;
-                }
-              }
-            }
-          }
+      // score the candidates after the last added hit against the current cluster, one MVA batch at
+      // a time, and add the first one passing the cut.  Adding a hit changes the cluster, so the
+      // candidates after it are scored again: at most one batch is scored in vain per added hit
+      size_t next(0);
+      while (next < _chcol->size()) {
+        _mvafeatures.clear();
+        _mvahits.clear();
+        for(;next < _chcol->size() && _mvahits.size() < MVATools::kBatch; ++next){
+          if (_incluster[next] || (_testflag && !goodHit((*_chcol)[next].flag()))) continue;
+          ComboHit const& ch = (*_chcol)[next];
+          float cht = _ttcalc.comboHitTime(ch,_pitch);
+          float dt = fabs(cht - tc._t0._t0);
+          if(dt >= _maxdt+tc._t0._t0err) continue;
+          float phi = polyAtan2(ch.pos().y(), ch.pos().x());//ch.phi();
+          float dphi = fabs(Angles::deltaPhi(phi,pphi));
+          if(dphi >= _maxdPhi) continue;
+          addMVAFeatures(tc,ch,cht,dphi);
+          _mvahits.push_back(next);
         }
+        scoreHits(tc);
+        auto iadd = std::find_if(_mvascores.begin(),_mvascores.end(),[this](float mvaout){return mvaout > _minaddmva;});
+        if (iadd == _mvascores.end()) continue;
+        size_t ich = _mvahits[iadd - _mvascores.begin()];
+        addHit(tc,ich);
+        _incluster[ich] = true;
+        changed = true;
+        next = ich+1;
       }
     }
   }
@@ -509,6 +508,27 @@ namespace mu2e {
     tc._strawHitIdxs.push_back(iadd);
   }
 
+  void TimeClusterFinder::addMVAFeatures(TimeCluster const& tc, ComboHit const& ch, float cht, float adphi) {
+    size_t irow = _mvafeatures.size();
+    _mvafeatures.resize(irow+kNTimeCluMVAVars);
+    float* row = _mvafeatures.data() + irow;
+    row[kDt]    = fabs(cht - tc._t0._t0);
+    row[kDphi]  = adphi;
+    row[kRho]   = ch.pos().Perp2();
+    row[kNsh]   = ch.nStrawHits();
+    row[kPlane] = ch.strawId().plane();
+    row[kWerr]  = ch.wireRes();
+    row[kWdist] = fabs(ch.wireDist());
+  }
+
+  void TimeClusterFinder::scoreHits(TimeCluster const& tc) {
+    // evaluate all the rows of the feature matrix in one call
+    _mvascores.resize(_mvafeatures.size()/kNTimeCluMVAVars);
+    if (_mvascores.empty()) return;
+    MVATools const& mva = tc.hasCaloCluster() ? _tcCaloMVA : _tcMVA;
+    mva.evalMVA(std::span<const float>(_mvafeatures),kNTimeCluMVAVars,std::span<float>(_mvascores));
+  }
+
   void TimeClusterFinder::clusterMean(TimeCluster& tc) {
     // compute properties using weighted mean
     accumulator_set<float, stats<tag::weighted_variance(lazy)>, float > terr;
@@ -545,28 +565,20 @@ namespace mu2e {
       auto iworst = tc._strawHitIdxs.end();
       float worstmva(100.0);
       float pphi = polyAtan2(tc._pos.y(), tc._pos.x());
-      for (auto ips=tc._strawHitIdxs.begin();ips != tc._strawHitIdxs.end();++ips) {
-        ComboHit const& ch = (*_chcol)[*ips];
+      // build the feature matrix of all the hits and score them at once
+      _mvafeatures.clear();
+      for (auto ish : tc._strawHitIdxs) {
+        ComboHit const& ch = (*_chcol)[ish];
         float cht = _ttcalc.comboHitTime(ch,_pitch);
-
-        _pmva._dt = fabs(cht - tc._t0._t0);
         float phi = polyAtan2(ch.pos().y(), ch.pos().x());//ch.phi();
         float dphi = Angles::deltaPhi(phi,pphi);
-        _pmva._dphi = fabs(dphi);
-        _pmva._rho = ch.pos().Perp2();
-        _pmva._nsh = ch.nStrawHits();
-        _pmva._plane = ch.strawId().plane();
-        _pmva._werr = ch.wireRes();
-        _pmva._wdist = fabs(ch.wireDist());
-
-        float mvaout(-1.0);
-        if (tc.hasCaloCluster())
-          mvaout = _tcCaloMVA.evalMVA(_pmva._pars);
-        else
-          mvaout = _tcMVA.evalMVA(_pmva._pars);
-        if (mvaout < worstmva) {
-          worstmva = mvaout;
-          iworst = ips;
+        addMVAFeatures(tc,ch,cht,fabs(dphi));
+      }
+      scoreHits(tc);
+      for (size_t ihit=0; ihit < _mvascores.size(); ++ihit) {
+        if (_mvascores[ihit] < worstmva) {
+          worstmva = _mvascores[ihit];
+          iworst = tc._strawHitIdxs.begin() + ihit;
         }
       }
 